@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stddef.h>
+#include <atomic>
+
+//
+// XbhǉA1̃XbhŎoAeʌŒ̃bNt[ȃL[B
+// evf͔z̃ZɒuAZƂ̒ʂԍŁu݉\vuǂݍ݉\v𔻒肷B
+// ǉǂ͏݈ʒuCASŎ荇ŁAbNȂB
+// o͒ǉꂽ(݈ʒumۂ)ɍsB
+//
+
+
+template<typename T>
+class BoundedMPSCQueue
+{
+public:
+	/** capacity2̗ݏɐ؂グ */
+	explicit BoundedMPSCQueue(size_t capacity) :
+		_enqueuePos(0),
+		_dequeuePos(0)
+	{
+		size_t n = 2;
+		while (n < capacity) n <<= 1;
+		_mask = n - 1;
+		_cells = new Cell[n];
+		for (size_t i=0; i<n; ++i) _cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~BoundedMPSCQueue()
+	{
+		delete[] _cells;
+	}
+
+	size_t capacity() const { return _mask + 1; }
+
+	/** vfǉBCӂ̃XbhĂׂBt̏ꍇfalse */
+	bool tryPush(const T& value)
+	{
+		size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell& cell = _cells[pos & _mask];
+			const size_t seq = cell.sequence.load(std::memory_order_acquire);
+			const ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+			if (diff == 0) {
+				// Z󂢂Ă̂ŁA݈ʒůmۂ݂
+				if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					cell.value = value;
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				// 1O̗vf܂oĂȂ
+				return false;
+			} else {
+				pos = _enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/** 擪̗vfoBo1Xbĥ݌ĂԂƁB̏ꍇfalse */
+	bool tryPop(T* out)
+	{
+		Cell& cell = _cells[_dequeuePos & _mask];
+		const size_t seq = cell.sequence.load(std::memory_order_acquire);
+		if ((ptrdiff_t)seq - (ptrdiff_t)(_dequeuePos + 1) < 0) return false;
+
+		*out = cell.value;
+		cell.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+		++_dequeuePos;
+		return true;
+	}
+
+	/** 悻̗vfBXbhǉ̏ꍇ͐młȂ */
+	size_t sizeApprox() const
+	{
+		return _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos;
+	}
+
+private:
+	struct Cell
+	{
+		/** ʂԍBpos Ȃ珑݉\Apos+1 Ȃǂݍ݉\ */
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	Cell* _cells;
+	size_t _mask;
+
+	// ǉƎoŕʂ̃LbVCɒu
+	alignas(64) std::atomic<size_t> _enqueuePos;
+	alignas(64) size_t _dequeuePos;
+
+	BoundedMPSCQueue(const BoundedMPSCQueue&);
+	BoundedMPSCQueue& operator=(const BoundedMPSCQueue&);
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <math.h>
+
+//
+// L[u}bv̖ʁExNgEe퓊e@̑ݕϊsw[eBeB
+//
+// ʂ̕тƖʓWnGL/D3Dʂ̃L[u}bvdlɏ]B
+//   ʂ̕ : +X, -X, +Y, -Y, +Z, -Z
+//   ʓUV   : eNZz̐擪sv=0BGPUł̃L[u}bvTvOƓʂɂȂ
+// 2D̓e@lɁAeNZz̐擪sv=0ŁAv+YijƂȂ
+//
+
+
+/** e@̎ށBC#Projectionƒl킹邱 */
+enum ProjectionType
+{
+	kProjectionEquirect = 0,		//!< ~}@(ܓxox)
+	kProjectionOctahedral = 1,		//!< ʑ̃}bsO
+	kProjectionDualParaboloid = 2,	//!< oʃ}bsOB+ZAE-Z
+	kProjectionCount
+};
+
+
+struct Vec3 { float x, y, z; };
+
+static inline Vec3 makeVec3(float x, float y, float z) { Vec3 ret = {x, y, z}; return ret; }
+static inline float dot(const Vec3& a, const Vec3& b) { return a.x*b.x + a.y*b.y + a.z*b.z; }
+static inline Vec3 normalize(const Vec3& a) {
+	float l = sqrtf( dot(a, a) );
+	float il = 0 < l ? 1.0f / l : 0;
+	return makeVec3(a.x*il, a.y*il, a.z*il);
+}
+static inline float signNotZero(float a) { return a < 0 ? -1.0f : 1.0f; }
+static inline int clampInt(int a, int lo, int hi) { return a < lo ? lo : (hi < a ? hi : a); }
+static inline float clampFloat(float a, float lo, float hi) { return a < lo ? lo : (hi < a ? hi : a); }
+
+static const float kPI = 3.14159265358979f;
+
+
+/** 3x3sBsDŁAv' = M * v ƂēKp */
+struct Mat3 { float m[9]; };
+
+static inline Vec3 mul(const Mat3& a, const Vec3& v) {
+	return makeVec3(
+		a.m[0]*v.x + a.m[1]*v.y + a.m[2]*v.z,
+		a.m[3]*v.x + a.m[4]*v.y + a.m[5]*v.z,
+		a.m[6]*v.x + a.m[7]*v.y + a.m[8]*v.z
+	);
+}
+
+
+/** xNg(񐳋Kł悢)AʔԍƖʓUV(0~1)߂ */
+static inline int dirToFaceUV(const Vec3& d, float* u, float* v)
+{
+	float ax = fabsf(d.x), ay = fabsf(d.y), az = fabsf(d.z);
+	int face;
+	float sc, tc, ma;
+	if (ay <= ax && az <= ax) {
+		ma = ax;
+		if (0 <= d.x) { face = 0; sc = -d.z; tc = -d.y; }
+		else          { face = 1; sc =  d.z; tc = -d.y; }
+	} else if (az <= ay) {
+		ma = ay;
+		if (0 <= d.y) { face = 2; sc =  d.x; tc =  d.z; }
+		else          { face = 3; sc =  d.x; tc = -d.z; }
+	} else {
+		ma = az;
+		if (0 <= d.z) { face = 4; sc =  d.x; tc = -d.y; }
+		else          { face = 5; sc = -d.x; tc = -d.y; }
+	}
+	float ima = 0 < ma ? 0.5f / ma : 0;
+	*u = sc * ima + 0.5f;
+	*v = tc * ima + 0.5f;
+	return face;
+}
+
+/**
+ * ʔԍƖʓUVAxNg(񐳋K)߂B
+ * UV0~1͈̔͊Oł悭Ȁꍇ͖ʂ̊O̕Ԃ
+ */
+static inline Vec3 faceUVToDir(int face, float u, float v)
+{
+	float sc = u*2 - 1, tc = v*2 - 1;
+	switch (face) {
+	case 0:  return makeVec3(  1, -tc, -sc );
+	case 1:  return makeVec3( -1, -tc,  sc );
+	case 2:  return makeVec3( sc,   1,  tc );
+	case 3:  return makeVec3( sc,  -1, -tc );
+	case 4:  return makeVec3( sc, -tc,   1 );
+	default: return makeVec3(-sc, -tc,  -1 );
+	}
+}
+
+
+/** e@UV(0~1)AxNg(Kς)߂ */
+static inline Vec3 projectionUVToDir(int projection, float u, float v)
+{
+	switch (projection) {
+	case kProjectionOctahedral: {
+		float px = u*2 - 1, pz = v*2 - 1;
+		float y = 1 - fabsf(px) - fabsf(pz);
+		if (y < 0) {
+			float ox = px;
+			px = (1 - fabsf(pz)) * signNotZero(ox);
+			pz = (1 - fabsf(ox)) * signNotZero(pz);
+		}
+		return normalize( makeVec3(px, y, pz) );
+	}
+	case kProjectionDualParaboloid: {
+		bool isFront = u < 0.5f;
+		float px = (isFront ? u : u - 0.5f) * 4 - 1;
+		float py = v*2 - 1;
+		float r2 = px*px + py*py;
+		if (1 < r2) {
+			float ir = 1 / sqrtf(r2);
+			px *= ir; py *= ir; r2 = 1;
+		}
+		float iw = 1 / (1 + r2);
+		return isFront
+			? makeVec3(  2*px*iw, 2*py*iw,  (1 - r2)*iw )
+			: makeVec3( -2*px*iw, 2*py*iw, -(1 - r2)*iw );
+	}
+	default: {
+		float lon = (u - 0.5f) * 2 * kPI;
+		float lat = (v - 0.5f) * kPI;
+		float cl = cosf(lat);
+		return makeVec3( cl*sinf(lon), sinf(lat), cl*cosf(lon) );
+	}
+	}
+}
+
+/** xNg(Kς)Ae@UV(0~1)߂ */
+static inline void dirToProjectionUV(int projection, const Vec3& d, float* u, float* v)
+{
+	switch (projection) {
+	case kProjectionOctahedral: {
+		float il = 1 / (fabsf(d.x) + fabsf(d.y) + fabsf(d.z));
+		float px = d.x * il, pz = d.z * il;
+		if (d.y < 0) {
+			float ox = px;
+			px = (1 - fabsf(pz)) * signNotZero(ox);
+			pz = (1 - fabsf(ox)) * signNotZero(pz);
+		}
+		*u = px*0.5f + 0.5f;
+		*v = pz*0.5f + 0.5f;
+		break;
+	}
+	case kProjectionDualParaboloid: {
+		if (0 <= d.z) {
+			float iw = 1 / (1 + d.z);
+			*u = ( d.x*iw*0.5f + 0.5f) * 0.5f;
+			*v =   d.y*iw*0.5f + 0.5f;
+		} else {
+			float iw = 1 / (1 - d.z);
+			*u = (-d.x*iw*0.5f + 0.5f) * 0.5f + 0.5f;
+			*v =   d.y*iw*0.5f + 0.5f;
+		}
+		break;
+	}
+	default:
+		*u = atan2f(d.x, d.z) / (2*kPI) + 0.5f;
+		*v = asinf( clampFloat(d.y, -1, 1) ) / kPI + 0.5f;
+		break;
+	}
+}
@@ -0,0 +1,73 @@
+#include "CubemapBlur.h"
+#include "Parallel.h"
+#include "FrameArena.h"
+
+#include <math.h>
+
+
+int computeGaussianWeights(float sigma, int faceSize, float* weights)
+{
+	if (!(0 < sigma)) {
+		weights[0] = 1;
+		return 0;
+	}
+
+	int radius = (int)ceilf(sigma * 3);
+	if (kMaxBlurRadius < radius) radius = kMaxBlurRadius;
+	// aʂ̃TCY𒴂ƔΑ̖ʂ܂ŉ荞ނ̂ŁAK̑Oɖʂ̃TCY܂łɐ
+	if (faceSize < radius) radius = faceSize;
+
+	float sum = 0;
+	for (int i=0; i<=radius; ++i) {
+		weights[i] = expf( -(float)(i*i) / (2 * sigma * sigma) );
+		sum += i == 0 ? weights[i] : weights[i] * 2;
+	}
+	for (int i=0; i<=radius; ++i) weights[i] /= sum;
+	return radius;
+}
+
+/** 1̂ڂA[rowBegin, rowEnd) ͈̔͂̍s(ʁ~s̒ʂԍ)ɂčs */
+static void blurRows(
+	const CubemapImageView& src, const CubemapImageView& dst,
+	const float* weights, int radius, bool isVertical,
+	int rowBegin, int rowEnd
+) {
+	const int n = src.size;
+	for (int row=rowBegin; row<rowEnd; ++row) {
+		const int f = row / n;
+		const int y = row % n;
+		unsigned char* dstRow = dst.texel(f, 0, y);
+		for (int x=0; x<n; ++x) {
+			SimdFloat4 c = simdMul( simdLoadRGBA8( src.texel(f, x, y) ), simdSet(weights[0]) );
+			for (int k=1; k<=radius; ++k) {
+				SimdFloat4 w = simdSet(weights[k]);
+				const unsigned char* a = isVertical ? fetchCubeTexel(src, f, x, y-k) : fetchCubeTexel(src, f, x-k, y);
+				const unsigned char* b = isVertical ? fetchCubeTexel(src, f, x, y+k) : fetchCubeTexel(src, f, x+k, y);
+				c = simdMulAdd( c, simdAdd( simdLoadRGBA8(a), simdLoadRGBA8(b) ), w );
+			}
+			simdStoreRGBA8( dstRow + x*4, c );
+		}
+	}
+}
+
+bool blurCubemapCPU(const CubemapImageView& src, float sigma, const CubemapImageView& dst)
+{
+	if (!src.pixels || !dst.pixels || src.size <= 0 || src.size != dst.size) return false;
+
+	float weights[kMaxBlurRadius + 1];
+	int radius = computeGaussianWeights(sigma, src.size, weights);
+
+	// ̃pX͈ꎞobt@ցAc̃pX͂o͐֏
+	FrameArena::Scope arena( getFrameArena() );
+	CubemapImageView tmp = { arena.allocateArray<unsigned char>( src.faceBytes() * 6 ), src.size };
+	if (!tmp.pixels) return false;
+	const int rowCnt = src.size * 6;
+
+	parallelFor( rowCnt, [&](int begin, int end) {
+		blurRows(src, tmp, weights, radius, false, begin, end);
+	} );
+	parallelFor( rowCnt, [&](int begin, int end) {
+		blurRows(tmp, dst, weights, radius, true, begin, end);
+	} );
+	return true;
+}
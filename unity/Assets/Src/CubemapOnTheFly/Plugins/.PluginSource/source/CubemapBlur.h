@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CubemapImage.h"
+
+//
+// L[u}bv̕\KEVAڂCPUB
+// ʂ̉܂tFb`͗אږʂ̌ɍ킹čŝŁApڂoȂB
+// GPU͊eRenderAPI blurCubemap QƁB
+//
+
+
+/** ڂ̍ő唼a(eNZ)B𒴂sigma͔a؂l߂ */
+static const int kMaxBlurRadius = 64;
+
+/**
+ * wsigma(eNZP)̃KEVȀd݂AS珇 weights[0..radius] ɏށB
+ * a͖ʂ܂ŔΑ̖ʂ܂ŉ荞܂Ȃ悤ɁAʂ̈(faceSize)܂łɐB
+ * d݂͈̗͐̔͂v1ɂȂ悤ɐKBaԂ
+ */
+int computeGaussianWeights(float sigma, int faceSize, float* weights);
+
+/**
+ * L[u}bvɃKEVAڂBsigma̓eNZPʁB
+ * Ec2pXŏAepX͖ʂƍsPʂ̃^CɕĕɏB
+ * srcdstɓ摜w肵ꍇ͂̏ōXV
+ */
+bool blurCubemapCPU(const CubemapImageView& src, float sigma, const CubemapImageView& dst);
@@ -3,11 +3,31 @@
 
 #include "PlatformBase.h"
 #include "RenderAPI.h"
+#include "ProjectionConverter.h"
+#include "CubemapRotator.h"
+#include "SeamFixup.h"
+#include "CubemapBlur.h"
+#include "LuminanceStats.h"
+#include "KTX2.h"
+#include "FrameArena.h"
+#include "Parallel.h"
+#include "Epoch.h"
+#include "CommandQueue.h"
+#include "SharedFaceRing.h"
+#include "PixelFormat.h"
+#include "PluginStats.h"
+#include "Tracer.h"
+#include "ProfilerMarkers.h"
+#include "PluginCapture.h"
 #include "Unity/IUnityGraphics.h"
 
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 #include <vector>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 
 static void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType);
@@ -28,6 +48,7 @@ extern "C" void	UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginLoad(IUnit
 {
 	s_UnityInterfaces = unityInterfaces;
 	s_Graphics = s_UnityInterfaces->Get<IUnityGraphics>();
+	initProfilerMarkers(s_UnityInterfaces);
 	s_Graphics->RegisterDeviceEventCallback(OnGraphicsDeviceEvent);
 
 #if SUPPORT_VULKAN
@@ -46,6 +67,8 @@ extern "C" void	UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginLoad(IUnit
 extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginUnload()
 {
 	s_Graphics->UnregisterDeviceEventCallback(OnGraphicsDeviceEvent);
+	shutdownParallel();
+	shutdownProfilerMarkers();
 }
 
 // WebGLł̏ꍇUnityPluginLoadŌĂ΂Ȃ̂ŁA
@@ -71,32 +94,68 @@ extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API RegisterPlugin()
 // GraphicsDeviceEvent
 
 
-static RenderAPI* s_CurrentAPI = NULL;
+static std::atomic<RenderAPI*> s_CurrentAPI(NULL);
 static UnityGfxRenderer s_DeviceType = kUnityGfxRendererNull;
 
+/** s_CurrentAPI ̔jAXbh̎QƂI܂Œx点邽߂̃G|bN */
+static EpochDomain s_CurrentAPIEpoch;
+
+/**
+ * s_CurrentAPI QƂĂԁAfoCX̔jɂx点QƁB
+ * J֐͔Cӂ̃XbhĂ΂ꂤ̂ŁAs_CurrentAPI 𒼐ڎQƂɂʂ
+ */
+class CurrentAPIRef
+{
+public:
+	CurrentAPIRef() :
+		_guard(s_CurrentAPIEpoch),
+		_api( s_CurrentAPI.load(std::memory_order_acquire) )
+	{}
+
+	RenderAPI* get() const { return _api; }
+	RenderAPI* operator->() const { return _api; }
+	explicit operator bool() const { return _api != NULL; }
+
+private:
+	EpochDomain::Guard _guard;
+	RenderAPI* _api;
+
+	CurrentAPIRef(const CurrentAPIRef&);
+	CurrentAPIRef& operator=(const CurrentAPIRef&);
+};
+
+static void discardRenderCommands();
+static void destroyBuildFences(RenderAPI* api);
+
 
 static void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType)
 {
 	// Create graphics API implementation upon initialization
 	if (eventType == kUnityGfxDeviceEventInitialize)
 	{
-		assert(s_CurrentAPI == NULL);
+		assert(s_CurrentAPI.load() == NULL);
 		s_DeviceType = s_Graphics->GetRenderer();
-		s_CurrentAPI = CreateRenderAPI(s_DeviceType);
+		s_CurrentAPI.store( CreateRenderAPI(s_DeviceType), std::memory_order_release );
 	}
 
 	// Let the implementation process the device related events
-	if (s_CurrentAPI)
+	RenderAPI* api = s_CurrentAPI.load(std::memory_order_acquire);
+	if (api)
 	{
-		s_CurrentAPI->ProcessDeviceEvent(eventType, s_UnityInterfaces);
+		api->ProcessDeviceEvent(eventType, s_UnityInterfaces);
 	}
 
 	// Cleanup graphics API implementation upon shutdown
 	if (eventType == kUnityGfxDeviceEventShutdown)
 	{
-		delete s_CurrentAPI;
-		s_CurrentAPI = NULL;
+		// XbhQƒ̏ꍇ́A̎QƂIĂ
+		s_CurrentAPI.store(NULL, std::memory_order_release);
+		s_CurrentAPIEpoch.synchronize();
+		discardRenderCommands();
+		destroyBuildFences(api);
+		delete api;
 		s_DeviceType = kUnityGfxRendererNull;
+		getFrameArena().releaseAll();
 	}
 }
 
@@ -109,6 +168,41 @@ static void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType ev
 // vOC{
 
 
+/**
+ * L^p̃eNX`̏B傫E~bvE`́A擾łꍇ͎ۂ̃eNX`̒lgpA
+ * 擾łȂꍇ͈猩ςlgp
+ */
+static CaptureTexture captureActualTexture(RenderAPI* api, void* tex, int kind, int width, int height, int mipCount)
+{
+	int format = kPixelFormatRGBA8;
+	int actualWidth = 0, actualHeight = 0, actualMipCount = 0, actualFormat = -1;
+	if (api && tex && api->getTextureInfo(tex, kind == kCaptureTextureCube, &actualWidth, &actualHeight, &actualMipCount, &actualFormat)) {
+		width = actualWidth;
+		height = actualHeight;
+		if (0 < actualMipCount) mipCount = actualMipCount;
+		if (0 <= actualFormat) format = actualFormat;
+	}
+	return captureTexture(tex, kind, width, height, format, mipCount);
+}
+
+static CaptureTexture captureTexture2D(RenderAPI* api, void* tex, int width, int height)
+{
+	return captureActualTexture(api, tex, kCaptureTexture2D, width, height, 1);
+}
+
+static CaptureTexture captureCubemap(RenderAPI* api, void* tex, int size, int mipCount = 0)
+{
+	return captureActualTexture(api, tex, kCaptureTextureCube, size, size, mipCount);
+}
+
+/** BlitCubemap ̃Lv`̃yC[hݒ肷 */
+static void setCaptureBlitCubemap(RenderAPI* api, CaptureBlitCubemap* out, void* const* srcTexs, void* cubemapTex, int texWidth)
+{
+	for (int i=0; i<6; ++i) out->src[i] = captureTexture2D(api, srcTexs[i], texWidth, texWidth);
+	out->dst = captureCubemap(api, cubemapTex, texWidth);
+	out->size = texWidth;
+}
+
 /** 6̌eNX`AL[u}bvXV鏈 */
 extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlitCubemap(
 	void* srcTex0,
@@ -120,18 +214,1035 @@ extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlitCubemap(
 	void* cubemapTex,
 	int texWidth
 ) {
-	if (s_CurrentAPI)
-		s_CurrentAPI->blitCubemap(
-			srcTex0,
-			srcTex1,
-			srcTex2,
-			srcTex3,
-			srcTex4,
-			srcTex5,
-			cubemapTex,
-			texWidth
+	PluginCallScope call(kPluginCallBlitCubemap);
+	CurrentAPIRef api;
+	if (!api) return;
+
+	TraceScope trace("BlitCubemap", TraceArg("size", texWidth), TraceArg("src0", srcTex0), TraceArg("dst", cubemapTex));
+	PluginCaptureScope<CaptureBlitCubemap> capture(kCaptureRecordBlitCubemap);
+	if (capture.isActive()) {
+		void* const srcTexs[6] = { srcTex0, srcTex1, srcTex2, srcTex3, srcTex4, srcTex5 };
+		setCaptureBlitCubemap(api.get(), &capture.payload, srcTexs, cubemapTex, texWidth);
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpBlitCubemap, texWidth);
+	ProfilerMarkerScope marker(kProfilerMarkerBlit);
+	recordBytesMoved(cubemapFaceBytes(texWidth, 0, kPixelFormatRGBA8) * 6);
+	api->blitCubemap(
+		srcTex0,
+		srcTex1,
+		srcTex2,
+		srcTex3,
+		srcTex4,
+		srcTex5,
+		cubemapTex,
+		texWidth
+	);
+	call.result(true);
+}
+
+/** L[u}bvw̓e@2DeNX`֕ϊ(GPU)B1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertCubemapToProjection(
+	void* cubemapTex,
+	void* dstTex,
+	int dstWidth,
+	int dstHeight,
+	int projection
+) {
+	PluginCallScope call(kPluginCallConvertCubemapToProjection);
+	CurrentAPIRef api;
+	if (!api || !cubemapTex || !dstTex) return 0;
+	if (dstWidth <= 0 || dstHeight <= 0) return 0;
+	if (projection < 0 || kProjectionCount <= projection) return 0;
+
+	TraceScope trace("ConvertCubemapToProjection", TraceArg("width", dstWidth), TraceArg("height", dstHeight), TraceArg("projection", projection));
+	PluginCaptureScope<CaptureConvertCubemapToProjection> capture(kCaptureRecordConvertCubemapToProjection);
+	if (capture.isActive()) {
+		// ̃L[u}bv̑傫͈ɂȂ̂ŁA擾łȂꍇ͏o͂猩ςlL^
+		capture.payload.src = captureCubemap(api.get(), cubemapTex, dstHeight);
+		capture.payload.dst = captureTexture2D(api.get(), dstTex, dstWidth, dstHeight);
+		capture.payload.width = dstWidth;
+		capture.payload.height = dstHeight;
+		capture.payload.projection = projection;
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpConvertCubemapToProjection, dstWidth);
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	return call.result(api->convertCubemapToProjection(
+		cubemapTex, dstTex, dstWidth, dstHeight, projection
+	)) ? 1 : 0;
+}
+
+/** w̓e@2DeNX`L[u}bv֕ϊ(GPU)B1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertProjectionToCubemap(
+	void* srcTex,
+	void* cubemapTex,
+	int cubemapSize,
+	int projection
+) {
+	PluginCallScope call(kPluginCallConvertProjectionToCubemap);
+	CurrentAPIRef api;
+	if (!api || !srcTex || !cubemapTex) return 0;
+	if (cubemapSize <= 0) return 0;
+	if (projection < 0 || kProjectionCount <= projection) return 0;
+
+	TraceScope trace("ConvertProjectionToCubemap", TraceArg("size", cubemapSize), TraceArg("projection", projection), TraceArg("dst", cubemapTex));
+	PluginCaptureScope<CaptureConvertProjectionToCubemap> capture(kCaptureRecordConvertProjectionToCubemap);
+	if (capture.isActive()) {
+		// 2DeNX`̑傫͈ɂȂ̂ŁA擾łȂꍇ̓L[u}bv猩ςlL^
+		capture.payload.src = captureTexture2D(api.get(), srcTex, cubemapSize * 4, cubemapSize * 2);
+		capture.payload.dst = captureCubemap(api.get(), cubemapTex, cubemapSize);
+		capture.payload.size = cubemapSize;
+		capture.payload.projection = projection;
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpConvertProjectionToCubemap, cubemapSize);
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	return call.result(api->convertProjectionToCubemap(
+		srcTex, cubemapTex, cubemapSize, projection
+	)) ? 1 : 0;
+}
+
+/**
+ * zXgobt@̃L[u}bv(RGBA8E6ʘA)Aw̓e@2D摜֕ϊ(CPU)B
+ * 1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertCubemapToProjectionCPU(
+	void* srcFaces,
+	int srcSize,
+	void* dst,
+	int dstWidth,
+	int dstHeight,
+	int projection
+) {
+	PluginCallScope call(kPluginCallConvertCubemapToProjectionCPU);
+	TraceScope trace("ConvertCubemapToProjectionCPU", TraceArg("width", dstWidth), TraceArg("height", dstHeight), TraceArg("projection", projection));
+	PluginCaptureScope<CaptureCpuOp> capture(kCaptureRecordConvertCubemapToProjectionCPU);
+	if (capture.isActive()) {
+		capture.payload.size = srcSize;
+		capture.payload.width = dstWidth;
+		capture.payload.height = dstHeight;
+		capture.payload.projection = projection;
+	}
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	CubemapImageView src = { static_cast<unsigned char*>(srcFaces), srcSize };
+	Image2DView dstView = { static_cast<unsigned char*>(dst), dstWidth, dstHeight };
+	return call.result(convertCubemapToProjectionCPU(src, dstView, projection)) ? 1 : 0;
+}
+
+/**
+ * zXgobt@̎w蓊e@2D摜(RGBA8)AL[u}bv(6ʘA)֕ϊ(CPU)B
+ * 1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertProjectionToCubemapCPU(
+	void* src,
+	int srcWidth,
+	int srcHeight,
+	void* dstFaces,
+	int dstSize,
+	int projection
+) {
+	PluginCallScope call(kPluginCallConvertProjectionToCubemapCPU);
+	TraceScope trace("ConvertProjectionToCubemapCPU", TraceArg("size", dstSize), TraceArg("projection", projection));
+	PluginCaptureScope<CaptureCpuOp> capture(kCaptureRecordConvertProjectionToCubemapCPU);
+	if (capture.isActive()) {
+		capture.payload.size = dstSize;
+		capture.payload.width = srcWidth;
+		capture.payload.height = srcHeight;
+		capture.payload.projection = projection;
+	}
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	Image2DView srcView = { static_cast<unsigned char*>(src), srcWidth, srcHeight };
+	CubemapImageView dstView = { static_cast<unsigned char*>(dstFaces), dstSize };
+	return call.result(convertProjectionToCubemapCPU(srcView, projection, dstView)) ? 1 : 0;
+}
+
+/**
+ * L[u}bvɉ]Kpď(GPU)B1ԂB
+ * rotation͍sD3x3sŁAo͂̕dɂ͓͂ rotation * d ̐̕FB
+ * srcdstꍇ͂̏ōXV
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API RotateCubemap(
+	void* srcCubemapTex,
+	void* dstCubemapTex,
+	int size,
+	const float* rotation
+) {
+	PluginCallScope call(kPluginCallRotateCubemap);
+	CurrentAPIRef api;
+	if (!api || !srcCubemapTex || !dstCubemapTex || !rotation) return 0;
+	if (size <= 0) return 0;
+
+	TraceScope trace("RotateCubemap", TraceArg("size", size), TraceArg("src", srcCubemapTex), TraceArg("dst", dstCubemapTex));
+	PluginCaptureScope<CaptureRotateCubemap> capture(kCaptureRecordRotateCubemap);
+	if (capture.isActive()) {
+		capture.payload.src = captureCubemap(api.get(), srcCubemapTex, size);
+		capture.payload.dst = captureCubemap(api.get(), dstCubemapTex, size);
+		capture.payload.size = size;
+		memcpy(capture.payload.rotation, rotation, sizeof(capture.payload.rotation));
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpRotateCubemap, size);
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	return call.result(api->rotateCubemap(srcCubemapTex, dstCubemapTex, size, rotation)) ? 1 : 0;
+}
+
+/**
+ * zXgobt@̃L[u}bv(RGBA8E6ʘA)ɉ]Kpď(CPU)B1ԂB
+ * srcdstꍇ͂̏ōXV
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API RotateCubemapCPU(
+	void* srcFaces,
+	void* dstFaces,
+	int size,
+	const float* rotation
+) {
+	PluginCallScope call(kPluginCallRotateCubemapCPU);
+	if (!rotation) return 0;
+
+	TraceScope trace("RotateCubemapCPU", TraceArg("size", size));
+	PluginCaptureScope<CaptureCpuOp> capture(kCaptureRecordRotateCubemapCPU);
+	if (capture.isActive()) {
+		capture.payload.size = size;
+		capture.payload.isInPlace = srcFaces == dstFaces;
+		memcpy(capture.payload.rotation, rotation, sizeof(capture.payload.rotation));
+	}
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	Mat3 rot;
+	for (int i=0; i<9; ++i) rot.m[i] = rotation[i];
+	CubemapImageView src = { static_cast<unsigned char*>(srcFaces), size };
+	CubemapImageView dst = { static_cast<unsigned char*>(dstFaces), size };
+	return call.result(rotateCubemapCPU(src, rot, dst)) ? 1 : 0;
+}
+
+/**
+ * L[u}bv̊eʂ̉̃eNZאږʂƕςāApڂڗȂ(GPU)B
+ * 擪mipCountĩ~bvxɓKpB1ԂB
+ * fXNgbvOpenGL̂ݑΉŁAiOSEtvOSEAndroidEWebGLD3Dł0Ԃ̂ŁACPUłőւ邱
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API FixupCubemapSeams(
+	void* cubemapTex,
+	int size,
+	int mipCount
+) {
+	PluginCallScope call(kPluginCallFixupCubemapSeams);
+	CurrentAPIRef api;
+	if (!api || !cubemapTex) return 0;
+	if (size <= 0 || mipCount <= 0) return 0;
+
+	TraceScope trace("FixupCubemapSeams", TraceArg("size", size), TraceArg("mipCount", mipCount), TraceArg("tex", cubemapTex));
+	PluginCaptureScope<CaptureFixupCubemapSeams> capture(kCaptureRecordFixupCubemapSeams);
+	if (capture.isActive()) {
+		capture.payload.tex = captureCubemap(api.get(), cubemapTex, size, mipCount);
+		capture.payload.size = size;
+		capture.payload.mipCount = mipCount;
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpFixupCubemapSeams, size);
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	return call.result(api->fixupCubemapSeams(cubemapTex, size, mipCount)) ? 1 : 0;
+}
+
+/**
+ * zXgobt@̃L[u}bv(RGBA8E6ʘA)̌pڂC(CPU)B
+ * 1~bvx̏ōXVB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API FixupCubemapSeamsCPU(
+	void* faces,
+	int size
+) {
+	PluginCallScope call(kPluginCallFixupCubemapSeamsCPU);
+	TraceScope trace("FixupCubemapSeamsCPU", TraceArg("size", size));
+	PluginCaptureScope<CaptureCpuOp> capture(kCaptureRecordFixupCubemapSeamsCPU);
+	if (capture.isActive()) capture.payload.size = size;
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	CubemapImageView img = { static_cast<unsigned char*>(faces), size };
+	return call.result(fixupCubemapSeamsCPU(img)) ? 1 : 0;
+}
+
+/**
+ * L[u}bvɃKEVAڂ(GPU)Bsigma̓eNZPʁB
+ * srcdstɓeNX`w肵ꍇ͂̏ōXVB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlurCubemap(
+	void* srcCubemapTex,
+	void* dstCubemapTex,
+	int size,
+	float sigma
+) {
+	PluginCallScope call(kPluginCallBlurCubemap);
+	CurrentAPIRef api;
+	if (!api || !srcCubemapTex || !dstCubemapTex) return 0;
+	if (size <= 0 || !(0 <= sigma)) return 0;
+
+	TraceScope trace("BlurCubemap", TraceArg("size", size), TraceArg("src", srcCubemapTex), TraceArg("dst", dstCubemapTex));
+	PluginCaptureScope<CaptureBlurCubemap> capture(kCaptureRecordBlurCubemap);
+	if (capture.isActive()) {
+		capture.payload.src = captureCubemap(api.get(), srcCubemapTex, size);
+		capture.payload.dst = captureCubemap(api.get(), dstCubemapTex, size);
+		capture.payload.size = size;
+		capture.payload.sigma = sigma;
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpBlurCubemap, size);
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	return call.result(api->blurCubemap(srcCubemapTex, dstCubemapTex, size, sigma)) ? 1 : 0;
+}
+
+/**
+ * zXgobt@̃L[u}bv(RGBA8E6ʘA)ɃKEVAڂ(CPU)B
+ * XbhŏBsrcdstɓobt@w肵ꍇ͂̏ōXVB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlurCubemapCPU(
+	void* srcFaces,
+	void* dstFaces,
+	int size,
+	float sigma
+) {
+	PluginCallScope call(kPluginCallBlurCubemapCPU);
+	if (!(0 <= sigma)) return 0;
+
+	TraceScope trace("BlurCubemapCPU", TraceArg("size", size));
+	PluginCaptureScope<CaptureCpuOp> capture(kCaptureRecordBlurCubemapCPU);
+	if (capture.isActive()) {
+		capture.payload.size = size;
+		capture.payload.isInPlace = srcFaces == dstFaces;
+		capture.payload.sigma = sigma;
+	}
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	CubemapImageView src = { static_cast<unsigned char*>(srcFaces), size };
+	CubemapImageView dst = { static_cast<unsigned char*>(dstFaces), size };
+	return call.result(blurCubemapCPU(src, sigma, dst)) ? 1 : 0;
+}
+
+/**
+ * L[u}bv̋PxvGPUŏWvBʂ GetCubemapLuminanceStats Ŏ擾B
+ * qXgO͈̔͂log2PxŎw肷B1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ComputeCubemapLuminanceStats(
+	void* cubemapTex,
+	int size,
+	float minLog2Lum,
+	float maxLog2Lum
+) {
+	PluginCallScope call(kPluginCallComputeLuminanceStats);
+	CurrentAPIRef api;
+	if (!api || !cubemapTex) return 0;
+	if (size <= 0 || !(minLog2Lum < maxLog2Lum)) return 0;
+
+	TraceScope trace("ComputeCubemapLuminanceStats", TraceArg("size", size), TraceArg("tex", cubemapTex));
+	PluginCaptureScope<CaptureComputeLuminanceStats> capture(kCaptureRecordComputeLuminanceStats);
+	if (capture.isActive()) {
+		capture.payload.tex = captureCubemap(api.get(), cubemapTex, size);
+		capture.payload.size = size;
+		capture.payload.minLog2Lum = minLog2Lum;
+		capture.payload.maxLog2Lum = maxLog2Lum;
+	}
+	GpuTimerScope gpuTimer(api.get(), kPluginOpComputeLuminanceStats, size);
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	return call.result(api->computeLuminanceStats(cubemapTex, size, minLog2Lum, maxLog2Lum)) ? 1 : 0;
+}
+
+/** ߂ ComputeCubemapLuminanceStats ̌ʂ擾B1AGPUŏWv܂͌ʂꍇ0Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetCubemapLuminanceStats(
+	CubemapLuminanceStats* out
+) {
+	PluginCallScope call(kPluginCallGetLuminanceStats);
+	CurrentAPIRef api;
+	if (!api || !out) return 0;
+
+	PluginCaptureScope<CaptureEmpty> capture(kCaptureRecordGetLuminanceStats);
+	ProfilerMarkerScope marker(kProfilerMarkerReadback);
+	if (!api->getLuminanceStats(out)) return 0;
+	recordBytesMoved(sizeof(CubemapLuminanceStats));
+	call.result(true);
+	return 1;
+}
+
+/**
+ * zXgobt@̃L[u}bv(RGBA8E6ʘA)̋Pxv߂(CPU)B
+ * isSRGB0ȊȌꍇ́ARGBsRGBƂĐ`lɕϊĂ狁߂B
+ * XbhŏB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ComputeCubemapLuminanceStatsCPU(
+	void* faces,
+	int size,
+	int isSRGB,
+	float minLog2Lum,
+	float maxLog2Lum,
+	CubemapLuminanceStats* out
+) {
+	PluginCallScope call(kPluginCallComputeLuminanceStatsCPU);
+	TraceScope trace("ComputeCubemapLuminanceStatsCPU", TraceArg("size", size));
+	PluginCaptureScope<CaptureCpuOp> capture(kCaptureRecordComputeLuminanceStatsCPU);
+	if (capture.isActive()) {
+		capture.payload.size = size;
+		capture.payload.isSRGB = isSRGB != 0;
+		capture.payload.minLog2Lum = minLog2Lum;
+		capture.payload.maxLog2Lum = maxLog2Lum;
+	}
+	ProfilerMarkerScope marker(kProfilerMarkerFilter);
+	CubemapImageView img = { static_cast<unsigned char*>(faces), size };
+	return call.result(computeLuminanceStatsCPU(img, isSRGB != 0, minLog2Lum, maxLog2Lum, out)) ? 1 : 0;
+}
+
+/**
+ * zXgobt@̃L[u}bv(S~bvES)KTX2t@CƂďށB
+ * levelData[i] ̓~bvxi6ʕBpathUTF-8B1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WriteKTX2Cubemap(
+	const char* path,
+	int size,
+	int mipCount,
+	int format,
+	const void* const* levelData,
+	const char* key
+) {
+	PluginCallScope call(kPluginCallWriteKTX2Cubemap);
+	TraceScope trace("WriteKTX2Cubemap", TraceArg("size", size), TraceArg("mipCount", mipCount), TraceArg("format", format));
+	PluginCaptureScope<CaptureWriteKTX2Cubemap> capture(kCaptureRecordWriteKTX2Cubemap);
+	if (capture.isActive()) {
+		capture.payload.size = size;
+		capture.payload.mipCount = mipCount;
+		capture.payload.format = format;
+	}
+	return call.result(writeKTX2Cubemap(path, size, mipCount, format, levelData, key)) ? 1 : 0;
+}
+
+/**
+ * KTX2t@C̃L[u}bṽTCYE~bvE`擾B
+ * keyw肵ꍇ͊i[ĂL[ƈv邩mFB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetKTX2CubemapInfo(
+	const char* path,
+	const char* key,
+	int* size,
+	int* mipCount,
+	int* format
+) {
+	PluginCallScope call(kPluginCallGetKTX2CubemapInfo);
+	KTX2CubemapFile file;
+	if (!file.open(path)) return 0;
+	if (key && strcmp(key, file.key()) != 0) return 0;
+
+	if (size) *size = file.size();
+	if (mipCount) *mipCount = file.mipCount();
+	if (format) *format = file.format();
+	call.result(true);
+	return 1;
+}
+
+/** LoadKTX2CubemapLevels ̖{́Bapi 𒼐ڎ󂯎̂ŁA[J[XbhĂׂ */
+static bool loadKTX2CubemapLevels(
+	RenderAPI* api,
+	const char* path,
+	const char* key,
+	void* cubemapTex,
+	int firstLevel,
+	int levelCount,
+	int dstFirstLevel
+) {
+	PluginCallScope call(kPluginCallLoadKTX2CubemapLevels);
+	TraceScope trace("LoadKTX2CubemapLevels", TraceArg("firstLevel", firstLevel), TraceArg("levelCount", levelCount), TraceArg("dst", cubemapTex));
+	if (!cubemapTex) return false;
+	if (firstLevel < 0 || dstFirstLevel < 0) return false;
+
+	KTX2CubemapFile file;
+	if (!file.open(path)) return false;
+	if (key && strcmp(key, file.key()) != 0) return false;
+
+	if (levelCount < 0) levelCount = file.mipCount() - firstLevel;
+	if (levelCount <= 0 || file.mipCount() < firstLevel + levelCount) return false;
+
+	PluginCaptureScope<CaptureLoadKTX2CubemapLevels> capture(kCaptureRecordLoadKTX2CubemapLevels);
+	if (capture.isActive()) {
+		int dstSize = file.size() >> firstLevel;
+		if (dstSize < 1) dstSize = 1;
+		capture.payload.dst = captureTexture(cubemapTex, kCaptureTextureCube, dstSize, dstSize, file.format(), dstFirstLevel + levelCount);
+		capture.payload.fileSize = file.size();
+		capture.payload.fileMipCount = file.mipCount();
+		capture.payload.fileFormat = file.format();
+		capture.payload.firstLevel = firstLevel;
+		capture.payload.levelCount = levelCount;
+		capture.payload.dstFirstLevel = dstFirstLevel;
+	}
+	for (int i=firstLevel; i<firstLevel+levelCount; ++i) {
+		int levelSize = file.size() >> i;
+		if (levelSize < 1) levelSize = 1;
+		const int dstLevel = dstFirstLevel + i - firstLevel;
+		TraceScope trace("UploadCubemapLevel", TraceArg("size", levelSize), TraceArg("level", dstLevel), TraceArg("format", file.format()));
+		GpuTimerScope gpuTimer(api, kPluginOpUploadCubemapLevel, levelSize);
+		ProfilerMarkerScope marker(kProfilerMarkerUpload);
+		recordBytesMoved(cubemapFaceBytes(levelSize, 0, file.format()) * 6);
+		if (!api->uploadCubemapLevel(cubemapTex, dstLevel, levelSize, file.format(), file.levelData(i)))
+			return false;
+	}
+	return call.result(true);
+}
+
+/**
+ * KTX2t@C̎w͈͂̃~bvxAL[u}bv̎w~bvxȍ~֓]B
+ * t@CfirstLevellevelCountiA]dstFirstLevel珇ɏށBlevelCount̏ꍇ͍Ō̒i܂ŁB
+ * ʂ̃~bvȂkł̃L[u}bvցAKvȒiǂݍޏꍇɎgpB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API LoadKTX2CubemapLevels(
+	const char* path,
+	const char* key,
+	void* cubemapTex,
+	int firstLevel,
+	int levelCount,
+	int dstFirstLevel
+) {
+	CurrentAPIRef api;
+	if (!api) return 0;
+
+	return loadKTX2CubemapLevels(api.get(), path, key, cubemapTex, firstLevel, levelCount, dstFirstLevel) ? 1 : 0;
+}
+
+/**
+ * KTX2t@CɃ}bvāAL[u}bv֒ړ]B
+ * ]̓t@CƓTCYE`ŁAt@Cȏ̃~bvƁB
+ * keyw肵ꍇ͊i[ĂL[ƈv邩mFB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API LoadKTX2Cubemap(
+	const char* path,
+	const char* key,
+	void* cubemapTex
+) {
+	return LoadKTX2CubemapLevels(path, key, cubemapTex, 0, -1, 0);
+}
+
+/** CreateCubemap ɓn~bviۂ */
+static bool isValidCubemapDesc(int size, int mipCount, int format)
+{
+	if (size <= 0 || mipCount <= 0 || pixelFormatBytes(format) == 0) return false;
+	return (size >> (mipCount - 1)) != 0;
+}
+
+/**
+ * ύXsȃXg[WL[u}bv쐬Bformat PixelFormatB
+ * ߂l Cubemap.CreateExternalTexture ɓnlCeBueNX`ŁAsvɂȂ DestroyCubemap ŔjB
+ * OtBbNXAPI𒼐ڌĂԂ̂ŁA_[XbhȊOĂԏꍇ GetRenderEventAndDataFunc gƁB
+ * ΉEsNULLԂ
+ */
+extern "C" void* UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API CreateCubemap(
+	int size,
+	int mipCount,
+	int format
+) {
+	PluginCallScope call(kPluginCallCreateCubemap);
+	CurrentAPIRef api;
+	if (!api || !isValidCubemapDesc(size, mipCount, format)) return NULL;
+
+	TraceScope trace("CreateCubemap", TraceArg("size", size), TraceArg("mipCount", mipCount), TraceArg("format", format));
+	PluginCaptureScope<CaptureCreateCubemap> capture(kCaptureRecordCreateCubemap);
+	void* tex = api->createCubemap(size, mipCount, format);
+	if (capture.isActive()) {
+		capture.payload.size = size;
+		capture.payload.mipCount = mipCount;
+		capture.payload.format = format;
+		capture.payload.result = (uint64_t)(size_t)tex;
+	}
+	if (call.result(tex != NULL)) addProfilerLiveNativeTextures(1);
+	return tex;
+}
+
+/** CreateCubemap ō쐬L[u}bvjB1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API DestroyCubemap(
+	void* cubemapTex
+) {
+	PluginCallScope call(kPluginCallDestroyCubemap);
+	CurrentAPIRef api;
+	if (!api || !cubemapTex) return 0;
+
+	TraceScope trace("DestroyCubemap", TraceArg("tex", cubemapTex));
+	PluginCaptureScope<CaptureDestroyTexture> capture(kCaptureRecordDestroyCubemap);
+	if (capture.isActive()) capture.payload.handle = (uint64_t)(size_t)cubemapTex;
+	if (!call.result(api->destroyCubemap(cubemapTex))) return 0;
+	addProfilerLiveNativeTextures(-1);
+	return 1;
+}
+
+
+/**
+ * L[u}bv̊eʂ2DeNX`ƂĎQƂr[쐬B̃L[u}bv͕ύXsȃXg[WƁB
+ * outFaceTexsɂ͖ʂ̏6̃lCeBueNX`Aꂼ Texture2D.CreateExternalTexture ɓnB
+ * 1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API CreateCubemapFaceViews(
+	void* cubemapTex,
+	void** outFaceTexs
+) {
+	PluginCallScope call(kPluginCallCreateCubemapFaceViews);
+	CurrentAPIRef api;
+	if (!api || !cubemapTex || !outFaceTexs) return 0;
+
+	PluginCaptureScope<CaptureCreateCubemapFaceViews> capture(kCaptureRecordCreateCubemapFaceViews);
+	if (!call.result(api->createCubemapFaceViews(cubemapTex, outFaceTexs))) return 0;
+	if (capture.isActive()) {
+		capture.payload.cubemap = captureCubemap(api.get(), cubemapTex, 0);
+		for (int i=0; i<6; ++i) capture.payload.results[i] = (uint64_t)(size_t)outFaceTexs[i];
+	}
+	addProfilerLiveNativeTextures(6);
+	return 1;
+}
+
+/** CreateCubemapFaceViews ō쐬r[jB1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API DestroyTextureView(
+	void* viewTex
+) {
+	PluginCallScope call(kPluginCallDestroyTextureView);
+	CurrentAPIRef api;
+	if (!api || !viewTex) return 0;
+
+	PluginCaptureScope<CaptureDestroyTexture> capture(kCaptureRecordDestroyTextureView);
+	if (capture.isActive()) capture.payload.handle = (uint64_t)(size_t)viewTex;
+	if (!call.result(api->destroyTextureView(viewTex))) return 0;
+	addProfilerLiveNativeTextures(-1);
+	return 1;
+}
+
+// --------------------------------------------------------------------------
+// _[XbhōsBCommandBuffer.IssuePluginEventAndData Ă΂
+
+
+/** Cӂ̃XbhǉA_[Xbhł܂Ƃ߂ĎsR}h */
+struct RenderCommand
+{
+	int type;			//!< RenderCommandType
+	void* srcTexs[6];
+	void* cubemapTex;
+	int texWidth;
+};
+
+enum RenderCommandType
+{
+	kRenderCommandBlitCubemap,
+};
+
+/** ǉ͔Cӂ̃XbhAo̓_[Xbĥ */
+static BoundedMPSCQueue<RenderCommand> s_RenderCommands(1024);
+
+/**
+ * BlitCubemap ƓR}hƂĒǉBCӂ̃Xbh(Wũ[J[Ȃ)ĂׂB
+ * ǉR}h́A_[Xbh kRenderEventExecuteCommands ꂽƂɒǉɎsB
+ * L[t̏ꍇ0Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API EnqueueBlitCubemap(
+	void* srcTex0,
+	void* srcTex1,
+	void* srcTex2,
+	void* srcTex3,
+	void* srcTex4,
+	void* srcTex5,
+	void* cubemapTex,
+	int texWidth
+) {
+	PluginCallScope call(kPluginCallEnqueueBlitCubemap);
+	if (!srcTex0 || !srcTex1 || !srcTex2 || !srcTex3 || !srcTex4 || !srcTex5 || !cubemapTex) return 0;
+
+	RenderCommand cmd;
+	cmd.type = kRenderCommandBlitCubemap;
+	cmd.srcTexs[0] = srcTex0;
+	cmd.srcTexs[1] = srcTex1;
+	cmd.srcTexs[2] = srcTex2;
+	cmd.srcTexs[3] = srcTex3;
+	cmd.srcTexs[4] = srcTex4;
+	cmd.srcTexs[5] = srcTex5;
+	cmd.cubemapTex = cubemapTex;
+	cmd.texWidth = texWidth;
+	return call.result(s_RenderCommands.tryPush(cmd)) ? 1 : 0;
+}
+
+/** ǉς݂̃R}hɎsB_[XbhĂ */
+static void executeRenderCommands()
+{
+	CurrentAPIRef api;
+	RenderCommand cmd;
+	while (s_RenderCommands.tryPop(&cmd)) {
+		if (!api) continue;
+
+		switch (cmd.type) {
+		case kRenderCommandBlitCubemap : {
+			PluginCallScope call(kPluginCallBlitCubemap);
+			TraceScope trace("BlitCubemap", TraceArg("size", cmd.texWidth), TraceArg("src0", cmd.srcTexs[0]), TraceArg("dst", cmd.cubemapTex));
+			PluginCaptureScope<CaptureBlitCubemap> capture(kCaptureRecordBlitCubemap);
+			if (capture.isActive()) setCaptureBlitCubemap(api.get(), &capture.payload, cmd.srcTexs, cmd.cubemapTex, cmd.texWidth);
+			GpuTimerScope gpuTimer(api.get(), kPluginOpBlitCubemap, cmd.texWidth);
+			ProfilerMarkerScope marker(kProfilerMarkerBlit);
+			recordBytesMoved(cubemapFaceBytes(cmd.texWidth, 0, kPixelFormatRGBA8) * 6);
+			api->blitCubemap(
+				cmd.srcTexs[0], cmd.srcTexs[1], cmd.srcTexs[2],
+				cmd.srcTexs[3], cmd.srcTexs[4], cmd.srcTexs[5],
+				cmd.cubemapTex, cmd.texWidth
+			);
+			call.result(true);
+			} break;
+		}
+	}
+}
+
+/** ǉς݂̃R}hsɎ̂ĂBfoCX̔jɃ_[XbhĂ */
+static void discardRenderCommands()
+{
+	RenderCommand cmd;
+	while (s_RenderCommands.tryPop(&cmd)) {}
+}
+
+
+/** L[u}bv̐(rh)Ƃɑ}AGPUł̊p̃tFX */
+struct BuildFence
+{
+	void* fence;		//!< RenderAPI::insertFence ̖߂lB}OƊNULL
+	int state;			//!< 0: 1: -1:s 2:tFXΉŔłȂ
+};
+
+static std::mutex s_BuildFenceMutex;
+static std::unordered_map<unsigned, BuildFence> s_BuildFences;
+static std::vector<void*> s_RetiredBuildFences;		//!< OɉꂽtFXB_[XbhŔj
+static unsigned s_NextBuildFenceId = 1;
+
+/**
+ * rh̊pIDmۂBCӂ̃XbhĂׂB
+ * mۂID kRenderEventInsertBuildFence ̃f[^ƂēnƁA̎_܂łGPUR}ȟɃtFX}B
+ * svɂȂ ReleaseBuildFence ŉ邱
+ */
+extern "C" unsigned UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API CreateBuildFence()
+{
+	std::lock_guard<std::mutex> lock(s_BuildFenceMutex);
+	unsigned id = s_NextBuildFenceId++;
+	if (id == 0) id = s_NextBuildFenceId++;
+	BuildFence& f = s_BuildFences[id];
+	f.fence = NULL;
+	f.state = 0;
+	return id;
+}
+
+/**
+ * rhGPUł̏A҂ɕԂBCӂ̃XbhĂׂB
+ * 1: 0: -1:foCX̔jȂǂŔłȂȂA܂͕sID
+ * 2:tFXɖΉ(GLES2Ȃ)ŔłȂBĂяoŃt[Ȃǂ画f邱
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API QueryBuildComplete(unsigned id)
+{
+	std::lock_guard<std::mutex> lock(s_BuildFenceMutex);
+	auto it = s_BuildFences.find(id);
+	return it == s_BuildFences.end() ? -1 : it->second.state;
+}
+
+/** CreateBuildFence ŊmۂIDBOɉꍇAtFX̓_[XbhŔj */
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ReleaseBuildFence(unsigned id)
+{
+	std::lock_guard<std::mutex> lock(s_BuildFenceMutex);
+	auto it = s_BuildFences.find(id);
+	if (it == s_BuildFences.end()) return;
+	if (it->second.fence) s_RetiredBuildFences.push_back(it->second.fence);
+	s_BuildFences.erase(it);
+}
+
+/** id̃rh̃tFX}B_[XbhĂ */
+static void insertBuildFence(RenderAPI* api, unsigned id)
+{
+	void* fence = api ? api->insertFence() : NULL;
+
+	std::lock_guard<std::mutex> lock(s_BuildFenceMutex);
+	auto it = s_BuildFences.find(id);
+	if (it == s_BuildFences.end() || it->second.state != 0) {
+		if (fence) s_RetiredBuildFences.push_back(fence);
+		return;
+	}
+
+	// tFXɖΉ̏ꍇ́AGPŮ͔łȂ̂ŌĂяoɔC
+	if (fence) it->second.fence = fence;
+	else it->second.state = api ? 2 : -1;
+}
+
+/** }ς݂̃tFX̊mFAς݂̂̂jB_[XbhĂ */
+static void pollBuildFences(RenderAPI* api)
+{
+	std::lock_guard<std::mutex> lock(s_BuildFenceMutex);
+	for (size_t i=0; i<s_RetiredBuildFences.size(); ++i) api->destroyFence(s_RetiredBuildFences[i]);
+	s_RetiredBuildFences.clear();
+
+	for (auto it=s_BuildFences.begin(); it!=s_BuildFences.end(); ++it) {
+		BuildFence& f = it->second;
+		if (!f.fence) continue;
+
+		const int state = api->queryFence(f.fence);
+		if (state == 0) continue;
+		api->destroyFence(f.fence);
+		f.fence = NULL;
+		f.state = state;
+	}
+}
+
+/** foCX̔jɁAׂẴtFXjBĂȂrh͎sƂ */
+static void destroyBuildFences(RenderAPI* api)
+{
+	std::lock_guard<std::mutex> lock(s_BuildFenceMutex);
+	for (size_t i=0; i<s_RetiredBuildFences.size(); ++i) {
+		if (api) api->destroyFence(s_RetiredBuildFences[i]);
+	}
+	s_RetiredBuildFences.clear();
+
+	for (auto it=s_BuildFences.begin(); it!=s_BuildFences.end(); ++it) {
+		BuildFence& f = it->second;
+		if (!f.fence) continue;
+		if (api) api->destroyFence(f.fence);
+		f.fence = NULL;
+		f.state = -1;
+	}
+}
+
+
+/** _[Xbhł̃L[u}bv쐬vBC# ExternalCubemap.RequestData ƓCAEg */
+struct CubemapCreateRequest
+{
+	int size;
+	int mipCount;
+	int format;
+	int state;			//!< 0: 1: -1:sBresultłXV
+	void* result;		//!< 쐬lCeBueNX`
+};
+
+/** _[XbhłKTX2t@C̃~bv]vBC# CubemapDiskCache.LoadRequest ƓCAEg */
+struct KTX2LevelLoadRequest
+{
+	const char* path;	//!< UTF-8
+	const char* key;	//!< UTF-8BNULL̏ꍇ͏ƍȂ
+	void* cubemapTex;
+	int firstLevel;
+	int levelCount;
+	int dstFirstLevel;
+	int state;			//!< 0: 1: -1:s
+};
+
+enum RenderEventId
+{
+	kRenderEventCreateCubemap = 1,		//!< data CubemapCreateRequest*
+	kRenderEventDestroyCubemap,			//!< data͔jlCeBueNX`
+	kRenderEventDestroyTextureView,		//!< data͔jr[̃lCeBueNX`
+	kRenderEventLoadKTX2Levels,			//!< data KTX2LevelLoadRequest*
+	kRenderEventExecuteCommands,		//!< EnqueueBlitCubemap ȂǂŒǉR}hsBdata͖gp
+	kRenderEventPollAsync,				//!< obNOEhōsƃrh̃tFX̊荞ށBdata͖gp
+	kRenderEventInsertBuildFence,		//!< data CreateBuildFence ŊmۂID
+};
+
+/**
+ * KTX2t@C̃~bv]sBobNOEh̃Xbhōsꍇ͂ōsA
+ * ʂUnityQƂł悤ɂȂĂ req->state XV
+ */
+static void loadKTX2LevelsOnRenderThread(RenderAPI* api, KTX2LevelLoadRequest* req)
+{
+	auto complete = [req](bool succeeded) {
+		// CXbhstateĊ𔻒肷̂ŁA]IĂXV
+		std::atomic_thread_fence(std::memory_order_release);
+		req->state = succeeded ? 1 : -1;
+	};
+	if (!api) {
+		complete(false);
+		return;
+	}
+
+	auto job = [api, req]() {
+		return loadKTX2CubemapLevels(
+			api, req->path, req->key, req->cubemapTex,
+			req->firstLevel, req->levelCount, req->dstFirstLevel
 		);
+	};
+	if (!api->runAsync(job, complete)) complete(job());
 }
 
+static void UNITY_INTERFACE_API OnRenderEventAndData(int eventId, void* data)
+{
+	PluginCallScope call(kPluginCallRenderEvent);
+	TraceScope trace("RenderEvent", TraceArg("eventId", eventId), TraceArg("data", data));
+	CurrentAPIRef api;
+	call.result(true);
 
+	// obNOEhŊƃtFX́Aǂ̃Cxgł荞ł
+	if (api) {
+		api->pollAsync();
+		api->pollGpuTimers();
+		pollBuildFences(api.get());
+	}
 
+	switch (eventId) {
+	case kRenderEventCreateCubemap : {
+		CubemapCreateRequest* req = static_cast<CubemapCreateRequest*>(data);
+		req->result = CreateCubemap(req->size, req->mipCount, req->format);
+
+		// CXbhstateĊ𔻒肷̂ŁAresultݏIĂXV
+		std::atomic_thread_fence(std::memory_order_release);
+		req->state = req->result ? 1 : -1;
+		} break;
+
+	case kRenderEventDestroyCubemap :
+		DestroyCubemap(data);
+		break;
+
+	case kRenderEventDestroyTextureView :
+		DestroyTextureView(data);
+		break;
+
+	case kRenderEventLoadKTX2Levels :
+		loadKTX2LevelsOnRenderThread(api.get(), static_cast<KTX2LevelLoadRequest*>(data));
+		break;
+
+	case kRenderEventExecuteCommands :
+		executeRenderCommands();
+		break;
+
+	case kRenderEventPollAsync :
+		break;
+
+	case kRenderEventInsertBuildFence :
+		insertBuildFence(api.get(), (unsigned)(size_t)data);
+		break;
+	}
+}
+
+/** CommandBuffer.IssuePluginEventAndData ɓn֐Ԃ */
+extern "C" UnityRenderingEventAndData UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetRenderEventAndDataFunc()
+{
+	return OnRenderEventAndData;
+}
+
+/**
+ * t[EŌĂсACPUp̈ꎞobt@(FrameArena)߂B
+ * ̌Ăяoꍇ́ÅɊ߂
+ */
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ResetFrameArena()
+{
+	getFrameArena().reset();
+}
+
+/** CPUp̈ꎞobt@(FrameArena)̎gp󋵂擾B1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetFrameArenaStats(
+	FrameArenaStats* out
+) {
+	if (!out) return 0;
+
+	getFrameArena().getStats(out);
+	return 1;
+}
+
+/**
+ * vOC̊ěv(GPUԁEĂяo񐔁ECPUԂȂ)擾Bout->structSize ɂ͌Ăяo sizeof(PluginStats) ݒ肵ĂƁB
+ * GPUԂ͓ǂݖ߂悤ɂȂ_ŉẐŁAt[xĔfB
+ * Ăяo񐔁ECPUԂȂǂ́AXbhƂ̌vľĂяo̎_ōv́B1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetPluginStats(
+	PluginStats* out
+) {
+	return getPluginStats(out) ? 1 : 0;
+}
+
+/**
+ * vOC̏̃^CC̋L^JnBeventCapacityPerThread ̓XbhƂɋL^ł鏈ŁA0ȉ̏ꍇ͊lB
+ * ɋL^̏ꍇ0Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StartPluginTrace(
+	int eventCapacityPerThread
+) {
+	return startTrace(eventCapacityPerThread) ? 1 : 0;
+}
+
+/**
+ * ^CC̋L^~AChrome  trace_event `JSONt@C֏oB
+ * pathUTF-8ŁANULL̏ꍇ͏oɎ̂ĂB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StopPluginTrace(
+	const char* path
+) {
+	return stopTrace(path) ? 1 : 0;
+}
+
+/**
+ * vOČĂяooCĩO֋L^n߂BL^O tools/PluginReplay ōĐłB
+ * pathUTF-8BɋL^̏ꍇt@C쐬łȂꍇ0Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StartPluginCapture(
+	const char* path
+) {
+	return startPluginCapture(path, s_DeviceType) ? 1 : 0;
+}
+
+/** ĂяőL^~ăt@CB1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StopPluginCapture()
+{
+	return stopPluginCapture() ? 1 : 0;
+}
+
+/** vOC̊ěvʂׂ0ɖ߂ */
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ResetPluginStats()
+{
+	resetPluginStats();
+}
+
+/**
+ * CPUɎgp郏[J[XbhƁAe[J[_RA֌Œ肷邩ۂݒ肷B
+ * workerCount0ȉ̏ꍇ _RA - 1BCPU̎s͉ύX0ԂB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConfigureThreadPool(
+	int workerCount,
+	int pinThreads
+) {
+	return configureParallel(workerCount, pinThreads != 0) ? 1 : 0;
+}
+
+/** CPUɎsłXbh([J[ + ĂяoXbh)Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetThreadPoolThreadCount()
+{
+	return getParallelThreadCount();
+}
+
+/**
+ * L[u}bv̖ʂ𑼃vZX֌JAOtL̃O쐬B
+ * slotCount͕ێʂ̐AmaxFaceSizeformat1XbgɊi[łʂ̍ő̑傫B
+ * ߂l DestroySharedFaceRing ŔjBΉEsNULLԂ
+ */
+extern "C" void* UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API CreateSharedFaceRing(
+	const char* name,
+	int slotCount,
+	int maxFaceSize,
+	int format
+) {
+	PluginCallScope call(kPluginCallCreateSharedFaceRing);
+	SharedFaceRing* ring = new SharedFaceRing();
+	if (call.result(ring->create(name, slotCount, maxFaceSize, format))) return ring;
+
+	delete ring;
+	return NULL;
+}
+
+/** CreateSharedFaceRing ō쐬OjāAL폜B1Ԃ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API DestroySharedFaceRing(
+	void* ring
+) {
+	PluginCallScope call(kPluginCallDestroySharedFaceRing);
+	if (!ring) return 0;
+
+	delete static_cast<SharedFaceRing*>(ring);
+	call.result(true);
+	return 1;
+}
+
+/**
+ * zXgobt@̃L[u}bv(6ʘA)AʂƂɃO֏ŌJB
+ * frameId͓ǂݍݑœL[u}bv̖ʂʂ邽߂̒lB1Ԃ
+ */
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API PublishCubemapFacesToSharedRing(
+	void* ring,
+	const void* faces,
+	int size,
+	int format,
+	unsigned long long frameId
+) {
+	PluginCallScope call(kPluginCallPublishCubemapFacesToSharedRing);
+	if (!ring || !faces) return 0;
+
+	SharedFaceRing* r = static_cast<SharedFaceRing*>(ring);
+	const size_t faceBytes = cubemapFaceBytes(size, 0, format);
+	for (int i=0; i<6; ++i) {
+		const unsigned char* src = static_cast<const unsigned char*>(faces) + faceBytes * i;
+		if (!r->publish(i, size, format, frameId, src)) return 0;
+		recordBytesMoved(faceBytes);
+	}
+	call.result(true);
+	return 1;
+}
@@ -0,0 +1,69 @@
+#include "CubemapImage.h"
+
+#include <math.h>
+
+
+const unsigned char* fetchCubeTexel(const CubemapImageView& img, int faceIdx, int x, int y)
+{
+	const int n = img.size;
+	if (0 <= x && x < n && 0 <= y && y < n)
+		return img.texel(faceIdx, x, y);
+
+	// ʊÕeNŹÃeNZS̕אږʂ̃eNZ
+	float u, v;
+	Vec3 d = faceUVToDir(faceIdx, (x + 0.5f) / n, (y + 0.5f) / n);
+	int f = dirToFaceUV(d, &u, &v);
+	return img.texel(
+		f,
+		clampInt( (int)(u * n), 0, n-1 ),
+		clampInt( (int)(v * n), 0, n-1 )
+	);
+}
+
+SimdFloat4 sampleCubeBilinear(const CubemapImageView& img, const Vec3& dir)
+{
+	float u, v;
+	int face = dirToFaceUV(dir, &u, &v);
+
+	float s = u * img.size - 0.5f;
+	float t = v * img.size - 0.5f;
+	int x0 = (int)floorf(s);
+	int y0 = (int)floorf(t);
+	float fx = s - x0;
+	float fy = t - y0;
+
+	SimdFloat4 c00 = simdLoadRGBA8( fetchCubeTexel(img, face, x0,   y0  ) );
+	SimdFloat4 c10 = simdLoadRGBA8( fetchCubeTexel(img, face, x0+1, y0  ) );
+	SimdFloat4 c01 = simdLoadRGBA8( fetchCubeTexel(img, face, x0,   y0+1) );
+	SimdFloat4 c11 = simdLoadRGBA8( fetchCubeTexel(img, face, x0+1, y0+1) );
+
+	return simdLerp( simdLerp(c00, c10, fx), simdLerp(c01, c11, fx), fy );
+}
+
+SimdFloat4 sample2DBilinear(const Image2DView& img, float u, float v, bool wrapU)
+{
+	float s = u * img.width - 0.5f;
+	float t = v * img.height - 0.5f;
+	int x0 = (int)floorf(s);
+	int y0 = (int)floorf(t);
+	float fx = s - x0;
+	float fy = t - y0;
+
+	int x1 = x0 + 1;
+	if (wrapU) {
+		x0 = ((x0 % img.width) + img.width) % img.width;
+		x1 = ((x1 % img.width) + img.width) % img.width;
+	} else {
+		x0 = clampInt(x0, 0, img.width-1);
+		x1 = clampInt(x1, 0, img.width-1);
+	}
+	int y1 = clampInt(y0 + 1, 0, img.height-1);
+	y0 = clampInt(y0, 0, img.height-1);
+
+	SimdFloat4 c00 = simdLoadRGBA8( img.texel(x0, y0) );
+	SimdFloat4 c10 = simdLoadRGBA8( img.texel(x1, y0) );
+	SimdFloat4 c01 = simdLoadRGBA8( img.texel(x0, y1) );
+	SimdFloat4 c11 = simdLoadRGBA8( img.texel(x1, y1) );
+
+	return simdLerp( simdLerp(c00, c10, fx), simdLerp(c01, c11, fx), fy );
+}
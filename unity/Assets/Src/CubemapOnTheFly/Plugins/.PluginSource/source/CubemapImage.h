@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CubeMath.h"
+#include "Simd.h"
+
+#include <stddef.h>
+
+//
+// zXgobt@̉摜ւ̎QƂƁÃTvOB
+// sNZ`RGBA8(4byte/pixel)ŒŁAe`l͋ʂɈB
+//
+
+
+/** zXgobt@̃L[u}bvւ̎QƁB6ʕʂ̏ɌԂȂł̂Ƃ */
+struct CubemapImageView
+{
+	unsigned char* pixels;
+	int size;		//!< 1ʂ̈ӂ̃sNZ
+
+	size_t faceBytes() const { return (size_t)size * size * 4; }
+	unsigned char* face(int faceIdx) const { return pixels + faceBytes() * faceIdx; }
+	unsigned char* texel(int faceIdx, int x, int y) const {
+		return pixels + ( faceBytes() * faceIdx + ((size_t)y * size + x) * 4 );
+	}
+};
+
+/** zXgobt@2D摜ւ̎Q */
+struct Image2DView
+{
+	unsigned char* pixels;
+	int width;
+	int height;
+
+	unsigned char* texel(int x, int y) const {
+		return pixels + ((size_t)y * width + x) * 4;
+	}
+};
+
+
+/**
+ * L[u}bvwŃoCjATvOB
+ * ʂ̋E܂eNZ͗אږʂ琳Ŏ擾̂ŁApڂoȂ
+ */
+SimdFloat4 sampleCubeBilinear(const CubemapImageView& img, const Vec3& dir);
+
+/**
+ * L[u}bv̎wʂ̃eNZ擾B
+ * x,yʂ͈̔͊Ȍꍇ́ÃeNZS̕ɂאږʂ̃eNZԂ
+ */
+const unsigned char* fetchCubeTexel(const CubemapImageView& img, int faceIdx, int x, int y);
+
+/** 2D摜UV(0~1)ŃoCjATvOBwrapȔꍇUJԂAȊO̓Nv */
+SimdFloat4 sample2DBilinear(const Image2DView& img, float u, float v, bool wrapU);
@@ -0,0 +1,39 @@
+#include "CubemapRotator.h"
+#include "FrameArena.h"
+#include "Parallel.h"
+
+#include <string.h>
+
+
+bool rotateCubemapCPU(const CubemapImageView& src, const Mat3& rotation, const CubemapImageView& dst)
+{
+	if (!src.pixels || !dst.pixels || src.size <= 0 || src.size != dst.size) return false;
+
+	// ̏ōXVꍇ́A͑ޔĂ珈
+	FrameArena::Scope arena( getFrameArena() );
+	CubemapImageView srcView = src;
+	if (src.pixels == dst.pixels) {
+		const size_t bytes = src.faceBytes() * 6;
+		srcView.pixels = arena.allocateArray<unsigned char>(bytes);
+		if (!srcView.pixels) return false;
+		memcpy(srcView.pixels, src.pixels, bytes);
+	}
+
+	// ʓUVɑ΂ĕxNg͐`Ȃ̂ŁAsƂ̑ŋ߂
+	const float invSize = 1.0f / dst.size;
+	parallelForCubemapTiles( dst.size, 1, kParallelTileSize, [&](const CubemapTile& t) {
+		for (int y=t.y; y<t.y+t.height; ++y) {
+			float v = (y + 0.5f) * invSize;
+			Vec3 d0 = mul( rotation, faceUVToDir(t.face, 0.5f * invSize, v) );
+			Vec3 d1 = mul( rotation, faceUVToDir(t.face, 1.5f * invSize, v) );
+			Vec3 dd = makeVec3( d1.x - d0.x, d1.y - d0.y, d1.z - d0.z );
+
+			unsigned char* dstRow = dst.texel(t.face, 0, y);
+			for (int x=t.x; x<t.x+t.width; ++x) {
+				Vec3 d = makeVec3( d0.x + dd.x*x, d0.y + dd.y*x, d0.z + dd.z*x );
+				simdStoreRGBA8( dstRow + x*4, sampleCubeBilinear(srcView, d) );
+			}
+		}
+	} );
+	return true;
+}
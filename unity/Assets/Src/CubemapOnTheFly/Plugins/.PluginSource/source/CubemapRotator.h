@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CubemapImage.h"
+
+//
+// L[u}bv̉]TvOCPUB
+// GPU͊eRenderAPI rotateCubemap QƁB
+//
+
+
+/**
+ * L[u}bvɔCӂ̉]Kp̂Adst֏ށB
+ * o͂̊edɂ́A͂ rotation * d ̐̕FB
+ * srcdstɓobt@w肵ꍇ́ȀōXV
+ */
+bool rotateCubemapCPU(const CubemapImageView& src, const Mat3& rotation, const CubemapImageView& dst);
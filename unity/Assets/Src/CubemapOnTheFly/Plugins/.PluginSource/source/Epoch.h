@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+//
+// LIuWFNgQƂ鑤bNɁÃIuWFNg̔jQƒ̏̊܂Œx点dg݁B
+// QƑ̓G|bN̋Ƃ̎QƒJE^𑝌邾ŁAj͎̃G|bN֐i߂Ă
+// ÂG|bN̎QƂׂĔ܂ő҂Bj͋HɂNȂOŁAQƑׂ̕ŏɂĂB
+//
+//   QƑ : EpochDomain::Guard g(domain); RenderAPI* api = s_api.load(); ...
+//   j : RenderAPI* old = s_api.exchange(NULL); domain.synchronize(); delete old;
+//
+
+
+class EpochDomain
+{
+public:
+	EpochDomain() : _epoch(0)
+	{
+		_readerCnt[0] = 0;
+		_readerCnt[1] = 0;
+	}
+
+	/** QƂJnB߂l leave ɓn */
+	unsigned enter()
+	{
+		for (;;) {
+			const unsigned e = _epoch.load();
+			_readerCnt[e & 1].fetch_add(1);
+			// n߂OɃG|bNiłꍇ́A҂猩Ƃ̂ł蒼
+			if (_epoch.load() == e) return e;
+			_readerCnt[e & 1].fetch_sub(1);
+		}
+	}
+
+	/** QƂI */
+	void leave(unsigned e)
+	{
+		_readerCnt[e & 1].fetch_sub(1, std::memory_order_release);
+	}
+
+	/**
+	 * LIuWFNgւ̃|C^ւɌĂсAȑOɊJnQƂׂďI܂ő҂B
+	 * ߂́AւÕIuWFNgjĂ悢BQƒ̃XbhĂł͂ȂȂ
+	 */
+	void synchronize()
+	{
+		const unsigned e = _epoch.fetch_add(1);
+		while (_readerCnt[e & 1].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+	}
+
+	/** XR[v̊ԂQƂs߂̃K[h */
+	class Guard
+	{
+	public:
+		explicit Guard(EpochDomain& domain) : _domain(domain), _epoch(domain.enter()) {}
+		~Guard() { _domain.leave(_epoch); }
+
+	private:
+		EpochDomain& _domain;
+		const unsigned _epoch;
+
+		Guard(const Guard&);
+		Guard& operator=(const Guard&);
+	};
+
+private:
+	std::atomic<unsigned> _epoch;
+	std::atomic<int> _readerCnt[2];
+
+	EpochDomain(const EpochDomain&);
+	EpochDomain& operator=(const EpochDomain&);
+};
@@ -0,0 +1,209 @@
+#include "FileIO.h"
+
+#include <stdlib.h>
+#include <string>
+
+#if _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif !UNITY_WEBGL && !UNITY_METRO
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <errno.h>
+#endif
+
+
+#if _WIN32
+/** UTF-8̕Chɕϊ */
+static std::wstring toWide(const char* s)
+{
+	int len = MultiByteToWideChar(CP_UTF8, 0, s, -1, NULL, 0);
+	if (len <= 0) return std::wstring();
+	std::wstring ret(len, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, s, -1, &ret[0], len);
+	ret.resize(len - 1);
+	return ret;
+}
+
+/** ChUTF-8̕ɕϊ */
+static std::string toUtf8(const wchar_t* s)
+{
+	int len = WideCharToMultiByte(CP_UTF8, 0, s, -1, NULL, 0, NULL, NULL);
+	if (len <= 0) return std::string();
+	std::string ret(len, '\0');
+	WideCharToMultiByte(CP_UTF8, 0, s, -1, &ret[0], len, NULL, NULL);
+	ret.resize(len - 1);
+	return ret;
+}
+#endif
+
+FILE* openFileUtf8(const char* path, const char* mode)
+{
+	if (!path || !mode) return NULL;
+#if _WIN32
+	FILE* fp = NULL;
+	if (_wfopen_s(&fp, toWide(path).c_str(), toWide(mode).c_str()) != 0) return NULL;
+	return fp;
+#else
+	return fopen(path, mode);
+#endif
+}
+
+bool replaceFileUtf8(const char* srcPath, const char* dstPath)
+{
+#if _WIN32
+	return MoveFileExW(
+		toWide(srcPath).c_str(), toWide(dstPath).c_str(),
+		MOVEFILE_REPLACE_EXISTING
+	) != 0;
+#else
+	return rename(srcPath, dstPath) == 0;
+#endif
+}
+
+bool removeFileUtf8(const char* path)
+{
+#if _WIN32
+	return DeleteFileW( toWide(path).c_str() ) != 0;
+#else
+	return remove(path) == 0;
+#endif
+}
+
+bool createDirectoryUtf8(const char* path)
+{
+#if _WIN32
+	return CreateDirectoryW( toWide(path).c_str(), NULL ) != 0 || GetLastError() == ERROR_ALREADY_EXISTS;
+#elif !UNITY_WEBGL && !UNITY_METRO
+	return mkdir(path, 0755) == 0 || errno == EEXIST;
+#else
+	return false;
+#endif
+}
+
+std::string getUserCacheDirectoryUtf8()
+{
+#if _WIN32 && !UNITY_METRO
+	const wchar_t* dir = _wgetenv(L"LOCALAPPDATA");
+	return dir && *dir ? toUtf8(dir) : std::string();
+#elif UNITY_OSX
+	const char* home = getenv("HOME");
+	return home && *home ? std::string(home) + "/Library/Caches" : std::string();
+#elif UNITY_LINUX
+	const char* xdg = getenv("XDG_CACHE_HOME");
+	if (xdg && *xdg) return xdg;
+	const char* home = getenv("HOME");
+	return home && *home ? std::string(home) + "/.cache" : std::string();
+#else
+	return std::string();
+#endif
+}
+
+
+MappedFile::MappedFile()
+	: _data(NULL)
+	, _size(0)
+#if UNITY_WIN
+	, _file(INVALID_HANDLE_VALUE)
+	, _mapping(NULL)
+#endif
+{}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char* path)
+{
+	close();
+	if (!path) return false;
+
+#if UNITY_WIN
+
+	HANDLE file = CreateFileW(
+		toWide(path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL
+	);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+	void* p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!p) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	_file = file;
+	_mapping = mapping;
+	_data = static_cast<const unsigned char*>(p);
+	_size = (size_t)fileSize.QuadPart;
+	return true;
+
+#elif UNITY_WEBGL || UNITY_METRO
+
+	FILE* fp = openFileUtf8(path, "rb");
+	if (!fp) return false;
+	fseek(fp, 0, SEEK_END);
+	long len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	unsigned char* buf = len <= 0 ? NULL : static_cast<unsigned char*>( malloc((size_t)len) );
+	if (!buf || fread(buf, 1, (size_t)len, fp) != (size_t)len) {
+		free(buf);
+		fclose(fp);
+		return false;
+	}
+	fclose(fp);
+	_data = buf;
+	_size = (size_t)len;
+	return true;
+
+#else
+
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0) return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+	void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// }bv̓t@CfBXNv^͕sv
+	::close(fd);
+	if (p == MAP_FAILED) return false;
+	_data = static_cast<const unsigned char*>(p);
+	_size = (size_t)st.st_size;
+	return true;
+
+#endif
+}
+
+void MappedFile::close()
+{
+	if (!_data) return;
+
+#if UNITY_WIN
+	UnmapViewOfFile(_data);
+	CloseHandle(_mapping);
+	CloseHandle(_file);
+	_mapping = NULL;
+	_file = INVALID_HANDLE_VALUE;
+#elif UNITY_WEBGL || UNITY_METRO
+	free( const_cast<unsigned char*>(_data) );
+#else
+	munmap( const_cast<unsigned char*>(_data), _size );
+#endif
+
+	_data = NULL;
+	_size = 0;
+}
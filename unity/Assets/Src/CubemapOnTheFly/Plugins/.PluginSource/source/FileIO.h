@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PlatformBase.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string>
+
+//
+// t@Co͂̋ʏB
+// pXׂ͂UTF-8Ŏ󂯎AWindowsł̓ChɕϊĈB
+//
+
+
+/** UTF-8̃pXŃt@CJ */
+FILE* openFileUtf8(const char* path, const char* mode);
+
+/** t@CuOύXBݓr̃t@CȂ悤ɁAꎞt@C̍ւɎg */
+bool replaceFileUtf8(const char* srcPath, const char* dstPath);
+
+/** t@C폜 */
+bool removeFileUtf8(const char* path);
+
+/** fBNg쐬Bɂꍇtrue */
+bool createDirectoryUtf8(const char* path);
+
+/**
+ * [U[Ƃ̃LbVpfBNg(Windows : %LOCALAPPDATA%AmacOS : ~/Library/CachesALinux : $XDG_CACHE_HOME  ~/.cache)ԂB
+ * ɋ؂蕶͕tȂBȂ(oCEWebGLȂ)ł͋󕶎
+ */
+std::string getUserCacheDirectoryUtf8();
+
+
+/**
+ * ǂݍݐpŃɃ}bvt@CB
+ * mmapgȂ(WebGLEUWP)ł́At@CŜɓǂݍőp
+ */
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	/** t@C}bvBɊJĂꍇ͕ĂJ */
+	bool open(const char* path);
+	void close();
+
+	const unsigned char* data() const { return _data; }
+	size_t size() const { return _size; }
+
+private:
+	const unsigned char* _data;
+	size_t _size;
+
+#if UNITY_WIN
+	void* _file;
+	void* _mapping;
+#endif
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+};
@@ -0,0 +1,237 @@
+#include "FrameArena.h"
+#include "PlatformBase.h"
+
+#include <stdlib.h>
+
+#if UNITY_WIN
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif !UNITY_WEBGL && !UNITY_METRO
+#	include <sys/mman.h>
+#endif
+
+
+static size_t roundUp(size_t v, size_t align) { return (v + align - 1) / align * align; }
+
+
+// --------------------------------------------------------------------------
+// OS̃ubNmہBq[Wy[WgȂꍇ͒ʏ̃y[WŊmۂ
+
+
+/** ubNmۂBmۂTCYcapacityɁAq[Wy[WŊmۂłۂisHugePageɓ */
+static void* allocSystemBlock(size_t bytes, size_t* capacity, bool* isHugePage)
+{
+	*isHugePage = false;
+
+#if UNITY_WIN
+	// [Wy[WSeLockMemoryPrivilegeKvȂ̂ŁAsꍇ͒ʏ̃y[WŊmۂ
+	const size_t largePage = GetLargePageMinimum();
+	if (largePage != 0 && FrameArena::kHugePageBytes <= bytes) {
+		size_t size = roundUp(bytes, largePage);
+		void* p = VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (p) {
+			*capacity = size;
+			*isHugePage = true;
+			return p;
+		}
+	}
+	*capacity = roundUp(bytes, 64 << 10);
+	return VirtualAlloc(NULL, *capacity, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+#elif UNITY_WEBGL || UNITY_METRO
+	// y[WPʂ̊mۂłȂł́AACg]ɊmۂđB
+	// 擪̎OɌ̃|C^ۑĂ
+	*capacity = roundUp(bytes, FrameArena::kAlignment);
+	void* raw = malloc(*capacity + FrameArena::kAlignment + sizeof(void*));
+	if (!raw) return NULL;
+	size_t p = roundUp( (size_t)raw + sizeof(void*), FrameArena::kAlignment );
+	((void**)p)[-1] = raw;
+	return (void*)p;
+
+#else
+	if (FrameArena::kHugePageBytes <= bytes) {
+		size_t size = roundUp(bytes, FrameArena::kHugePageBytes);
+		void* p;
+#	if defined(MAP_HUGETLB)
+		// \ς݂̃q[Wy[W΂g
+		p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (p != MAP_FAILED) {
+			*capacity = size;
+			*isHugePage = true;
+			return p;
+		}
+#	endif
+		// Βʏ̃y[WŊmۂAߓIq[Wy[W̎gpv
+		p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED) return NULL;
+		*capacity = size;
+#	if defined(MADV_HUGEPAGE)
+		*isHugePage = madvise(p, size, MADV_HUGEPAGE) == 0;
+#	endif
+		return p;
+	}
+
+	*capacity = roundUp(bytes, 4096);
+	void* p = mmap(NULL, *capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return p == MAP_FAILED ? NULL : p;
+#endif
+}
+
+static void freeSystemBlock(void* p, size_t capacity)
+{
+#if UNITY_WIN
+	(void)capacity;
+	VirtualFree(p, 0, MEM_RELEASE);
+#elif UNITY_WEBGL || UNITY_METRO
+	(void)capacity;
+	free( ((void**)p)[-1] );
+#else
+	munmap(p, capacity);
+#endif
+}
+
+
+// --------------------------------------------------------------------------
+// FrameArena
+
+
+FrameArena::FrameArena() :
+	_curBlock(0),
+	_frameBytes(0),
+	_peakBytes(0),
+	_activeScopeCnt(0),
+	_isResetPending(false),
+	_systemAllocCnt(0),
+	_frameCnt(0),
+	_deferredResetCnt(0)
+{
+	_blocks.reserve(16);
+}
+
+FrameArena::~FrameArena()
+{
+	releaseBlocksLocked();
+}
+
+FrameArena::Scope::Scope(FrameArena& arena) : _arena(arena)
+{
+	std::lock_guard<std::mutex> lock(_arena._mutex);
+	++_arena._activeScopeCnt;
+}
+
+FrameArena::Scope::~Scope()
+{
+	std::lock_guard<std::mutex> lock(_arena._mutex);
+	if (--_arena._activeScopeCnt == 0 && _arena._isResetPending) _arena.resetLocked();
+}
+
+void* FrameArena::allocate(size_t bytes)
+{
+	const size_t size = roundUp(bytes == 0 ? 1 : bytes, kAlignment);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_frameBytes += size;
+
+	// ݂̃ubNȍ~œ̂TA΃ubNǉ
+	for (; _curBlock < _blocks.size(); ++_curBlock) {
+		Block& b = _blocks[_curBlock];
+		if (size <= b.capacity - b.offset) {
+			void* ret = b.ptr + b.offset;
+			b.offset += size;
+			return ret;
+		}
+	}
+	if (!addBlock(size)) return NULL;
+
+	Block& b = _blocks.back();
+	b.offset = size;
+	return b.ptr;
+}
+
+bool FrameArena::addBlock(size_t minBytes)
+{
+	Block b;
+	b.ptr = static_cast<unsigned char*>( allocSystemBlock(
+		minBytes < kMinBlockBytes ? kMinBlockBytes : minBytes,
+		&b.capacity, &b.isHugePage
+	) );
+	if (!b.ptr) return false;
+
+	b.offset = 0;
+	_blocks.push_back(b);
+	_curBlock = _blocks.size() - 1;
+	++_systemAllocCnt;
+	return true;
+}
+
+void FrameArena::reset()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (0 < _activeScopeCnt) {
+		if (!_isResetPending) ++_deferredResetCnt;
+		_isResetPending = true;
+		return;
+	}
+	resetLocked();
+}
+
+void FrameArena::resetLocked()
+{
+	_isResetPending = false;
+	++_frameCnt;
+	if (_peakBytes < _frameBytes) _peakBytes = _frameBytes;
+
+	// ubNɕꂽꍇ́Ãt[1ubNɎ܂悤ɂ܂Ƃߒ
+	if (1 < _blocks.size()) {
+		const size_t need = _frameBytes;
+		releaseBlocksLocked();
+		addBlock(need);
+	}
+
+	for (size_t i=0; i<_blocks.size(); ++i) _blocks[i].offset = 0;
+	_curBlock = 0;
+	_frameBytes = 0;
+}
+
+bool FrameArena::releaseAll()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (0 < _activeScopeCnt) return false;
+
+	releaseBlocksLocked();
+	_frameBytes = 0;
+	_isResetPending = false;
+	return true;
+}
+
+void FrameArena::releaseBlocksLocked()
+{
+	for (size_t i=0; i<_blocks.size(); ++i) freeSystemBlock(_blocks[i].ptr, _blocks[i].capacity);
+	_blocks.clear();
+	_curBlock = 0;
+}
+
+void FrameArena::getStats(FrameArenaStats* out)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	out->usedBytes = _frameBytes;
+	out->peakBytes = _peakBytes < _frameBytes ? _frameBytes : _peakBytes;
+	out->capacityBytes = 0;
+	out->hugePageBytes = 0;
+	for (size_t i=0; i<_blocks.size(); ++i) {
+		out->capacityBytes += _blocks[i].capacity;
+		if (_blocks[i].isHugePage) out->hugePageBytes += _blocks[i].capacity;
+	}
+	out->systemAllocCount = _systemAllocCnt;
+	out->frameCount = _frameCnt;
+	out->deferredResetCount = _deferredResetCnt;
+	out->blockCount = (int)_blocks.size();
+	out->activeScopeCount = _activeScopeCnt;
+}
+
+
+FrameArena& getFrameArena()
+{
+	static FrameArena s_arena;
+	return s_arena;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stddef.h>
+#include <mutex>
+#include <vector>
+
+//
+// CPȔŎgpꎞobt@ṕAt[Pʂ̃ovAP[^B
+// mۂ̓ubÑItZbgi߂邾ŁAʂ͍̉s킸Ƀt[Eł܂Ƃ߂Ċ߂B
+// 1t[ŕubNgꍇ́A߂ɂ̍vTCY1ubNւ܂Ƃߒ̂ŁA
+// ԂłOS̊mۂȂB
+// 傫ȃubN̓q[Wy[Wł̊mۂ݁AłȂꍇ͒ʏ̃y[WŊmۂB
+//
+
+
+/** FrameArena̎gp󋵁BC# FrameArenaStats ƓCAEg */
+struct FrameArenaStats
+{
+	unsigned long long usedBytes;			//!< ݂̃t[Ŋmۍς݂̃oCg(ACgɂlߕ܂)
+	unsigned long long peakBytes;			//!< 1t[ł̊mۗʂ̍ől
+	unsigned long long capacityBytes;		//!< OSmۂĂubN̍voCg
+	unsigned long long hugePageBytes;		//!< capacityByteŝAq[Wy[WŊmۂłoCg
+	unsigned long long systemAllocCount;	//!< OSubNmۂ񐔂̗݌v
+	unsigned long long frameCount;			//!< t[Eł̊߂s񐔂̗݌v
+	unsigned long long deferredResetCount;	//!< gp߂Ɋ߂x点񐔂̗݌v
+	int blockCount;							//!< ݕێĂubN
+	int activeScopeCount;					//!< ݎgp̃XR[v
+};
+
+
+class FrameArena
+{
+public:
+	/** mۂ郁̃ACg(LbVCP) */
+	static const size_t kAlignment = 64;
+	/** 1ubN̍ŏTCY */
+	static const size_t kMinBlockBytes = 1 << 20;
+	/** ȏ̃ubŃAq[Wy[Wł̊mۂ݂ */
+	static const size_t kHugePageBytes = 2 << 20;
+
+	FrameArena();
+	~FrameArena();
+
+	/**
+	 * gpł邱ƂXR[vB
+	 * XR[vŊmۂ́AXR[v𔲂܂Ńt[E̊߂ŖɂȂȂ
+	 */
+	class Scope
+	{
+	public:
+		explicit Scope(FrameArena& arena);
+		~Scope();
+
+		/** kAlignmentEɑmۂBmۂłȂꍇNULL */
+		void* allocate(size_t bytes) { return _arena.allocate(bytes); }
+
+		/** T^̔zmۂBg͏Ȃ̂ŁAT͏svȌ^Ɍ */
+		template<typename T>
+		T* allocateArray(size_t count) { return static_cast<T*>( _arena.allocate(count * sizeof(T)) ); }
+
+	private:
+		FrameArena& _arena;
+
+		Scope(const Scope&);
+		Scope& operator=(const Scope&);
+	};
+
+	/**
+	 * t[EŌĂсAmۍςׂ݂̃Ċ߂B
+	 * gp̃XR[vꍇ́AŌ̃XR[v𔲂ƂɊ߂
+	 */
+	void reset();
+
+	/** ێĂubNׂOS֕ԋpBgp̃XR[vꍇ͉falseԂ */
+	bool releaseAll();
+
+	/** gp󋵂擾 */
+	void getStats(FrameArenaStats* out);
+
+private:
+	struct Block
+	{
+		unsigned char* ptr;
+		size_t capacity;
+		size_t offset;
+		bool isHugePage;
+	};
+
+	std::mutex _mutex;
+	std::vector<Block> _blocks;
+	size_t _curBlock;			//!< ݊mۂsĂubN̔ԍ
+	size_t _frameBytes;			//!< ݂̃t[ŗvꂽvoCg(ACg)
+	size_t _peakBytes;
+	int _activeScopeCnt;
+	bool _isResetPending;
+	unsigned long long _systemAllocCnt;
+	unsigned long long _frameCnt;
+	unsigned long long _deferredResetCnt;
+
+	void* allocate(size_t bytes);
+	bool addBlock(size_t minBytes);
+	void resetLocked();
+	void releaseBlocksLocked();
+
+	FrameArena(const FrameArena&);
+	FrameArena& operator=(const FrameArena&);
+};
+
+
+/** vOCŜŋLFrameArenaԂ */
+FrameArena& getFrameArena();
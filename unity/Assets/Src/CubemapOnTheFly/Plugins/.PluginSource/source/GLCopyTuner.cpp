@@ -0,0 +1,254 @@
+#include "GLCopyTuner.h"
+
+#if SUPPORT_OPENGL_UNIFIED && SUPPORT_OPENGL_SHADER_OPS
+
+#include "FileIO.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+/** LbṼt@Č`̃o[WBv@敪ςグ */
+const int kCacheVersion = 1;
+
+/** e敪Ōv傫 */
+const int kBucketSizes[kGLCopySizeBucketCount] = { 64, 256, 1024 };
+
+/** 1̕@E傫̌v񐔁Blg */
+const int kMeasureCount = 5;
+
+const char* const kStrategyNames[kGLCopyStrategyCount] = { "blit", "copyImage", "draw" };
+
+/** vZXōēxꂽꍇɁAvȂ߂̑Ǒ */
+std::mutex s_TuningMutex;
+std::string s_LastDeviceKey;
+GLCopyTuning s_LastTuning;
+
+std::string glString(GLenum name)
+{
+	const GLubyte* s = glGetString(name);
+	return s ? std::string(reinterpret_cast<const char*>(s)) : std::string();
+}
+
+/** t@CɎgAGPUEhCõ̕nbV(FNV-1a) */
+unsigned long long hashDeviceKey(const std::string& key)
+{
+	unsigned long long h = 14695981039346656037ull;
+	for (size_t i=0; i<key.size(); ++i) {
+		h ^= (unsigned char)key[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+/** ʂۑt@C̃pXBLbVpfBNgȂł͋󕶎 */
+std::string cacheFilePath(const std::string& deviceKey)
+{
+	std::string dir = getUserCacheDirectoryUtf8();
+	if (dir.empty()) return dir;
+	dir += "/CubemapOnTheFly";
+	if (!createDirectoryUtf8(dir.c_str())) return std::string();
+
+	char name[64];
+	snprintf(name, sizeof(name), "/GLCopyTuning_%016llx.txt", hashDeviceKey(deviceKey));
+	return dir + name;
+}
+
+/** s̉s菜1sǂݍ */
+bool readLine(FILE* fp, std::string* line)
+{
+	char buf[1024];
+	if (!fgets(buf, sizeof(buf), fp)) return false;
+	size_t len = strlen(buf);
+	while (0 < len && (buf[len - 1] == '\n' || buf[len - 1] == '\r')) --len;
+	line->assign(buf, len);
+	return true;
+}
+
+int findStrategy(const char* name)
+{
+	for (int i=0; i<kGLCopyStrategyCount; ++i) {
+		if (strcmp(name, kStrategyNames[i]) == 0) return i;
+	}
+	return -1;
+}
+
+/**
+ * ۑς݂̌ʂǂݍށB
+ * t@C̓nbVȂ̂ŁAɏ GL_RENDEREREGL_VERSION vꍇ̂ݎg
+ */
+bool loadTuning(const std::string& path, const std::string& renderer, const std::string& version, GLCopyTuning* out)
+{
+	FILE* fp = openFileUtf8(path.c_str(), "rb");
+	if (!fp) return false;
+
+	std::string line;
+	bool isValid =
+		readLine(fp, &line) && line == "CubemapOnTheFly GLCopyTuning " + std::to_string(kCacheVersion) &&
+		readLine(fp, &line) && line == "renderer " + renderer &&
+		readLine(fp, &line) && line == "version " + version;
+
+	GLCopyTuning t;
+	for (int b=0; isValid && b<kGLCopySizeBucketCount; ++b) {
+		char name[32];
+		int bucket = -1;
+		float ms[kGLCopyStrategyCount];
+		isValid =
+			readLine(fp, &line) &&
+			sscanf(line.c_str(), "bucket %d %31s %f %f %f", &bucket, name, &ms[0], &ms[1], &ms[2]) == 2 + kGLCopyStrategyCount &&
+			bucket == b && 0 <= (t.strategies[b] = findStrategy(name));
+		if (isValid) std::copy(ms, ms + kGLCopyStrategyCount, t.copyMs[b]);
+	}
+	fclose(fp);
+
+	if (isValid) *out = t;
+	return isValid;
+}
+
+bool saveTuning(const std::string& path, const std::string& renderer, const std::string& version, const GLCopyTuning& t)
+{
+	// ݓr̃t@Cǂݍ܂Ȃ悤ɁAꎞt@C֏Ă獷ւ
+	const std::string tmpPath = path + ".tmp";
+	FILE* fp = openFileUtf8(tmpPath.c_str(), "wb");
+	if (!fp) return false;
+
+	fprintf(fp, "CubemapOnTheFly GLCopyTuning %d\n", kCacheVersion);
+	fprintf(fp, "renderer %s\n", renderer.c_str());
+	fprintf(fp, "version %s\n", version.c_str());
+	for (int b=0; b<kGLCopySizeBucketCount; ++b) {
+		// vl gȂ@̒lŁA6ʂ̃Rs[ɂ(ms)
+		fprintf(fp, "bucket %d %s", b, kStrategyNames[t.strategies[b]]);
+		for (int i=0; i<kGLCopyStrategyCount; ++i) fprintf(fp, " %.4f", t.copyMs[b][i]);
+		fputc('\n', fp);
+	}
+
+	bool isSucceeded = ferror(fp) == 0;
+	isSucceeded = fclose(fp) == 0 && isSucceeded;
+	if (!isSucceeded || !replaceFileUtf8(tmpPath.c_str(), path.c_str())) {
+		removeFileUtf8(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * 1̕@6ʂRs[鎞ԂvB
+ * gȂ@At[obt@sSȂǂœrŃRs[łȂꍇ͕̒lB
+ * GPŮ܂ő҂ԂȂ̂ŁAR}h̔s̃RXg܂
+ */
+float measureCopy(const GLCopyFunc& copy, int strategy, GLuint srcTex, GLuint dstTex, int size)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// ̓hCȍ(VF[_̃RpCeNX`̎̂̊m)܂ނ̂ŌvȂ
+	for (int f=0; f<6; ++f) {
+		if (!copy(strategy, srcTex, dstTex, f, size)) return -1.0f;
+	}
+	glFinish();
+
+	float samples[kMeasureCount];
+	for (int i=0; i<kMeasureCount; ++i) {
+		const Clock::time_point t0 = Clock::now();
+		bool isCopied = true;
+		for (int f=0; f<6; ++f) isCopied = copy(strategy, srcTex, dstTex, f, size) && isCopied;
+		glFinish();
+		if (!isCopied) return -1.0f;
+		samples[i] = std::chrono::duration<float, std::milli>(Clock::now() - t0).count();
+	}
+	std::sort(samples, samples + kMeasureCount);
+	return samples[kMeasureCount / 2];
+}
+
+/** e敪̑傫ŁAe@včł̂I */
+GLCopyTuning measureTuning(const GLCopyFunc& copy)
+{
+	GLCopyTuning t;
+	GLStateScope stateScope;
+
+	for (int b=0; b<kGLCopySizeBucketCount; ++b) {
+		const int size = kBucketSizes[b];
+
+		// Rs[͓eɂđς鈳k(t[obt@kȂ)悤ɁAmCYŖ߂
+		std::vector<unsigned char> pixels((size_t)size * size * 4);
+		unsigned int rnd = 0x12345678u;
+		for (size_t i=0; i<pixels.size(); ++i) {
+			rnd = rnd * 1664525u + 1013904223u;
+			pixels[i] = (unsigned char)(rnd >> 24);
+		}
+
+		GLuint srcTex = 0, dstTex = 0;
+		glGenTextures(1, &srcTex);
+		glBindTexture(GL_TEXTURE_2D, srcTex);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+		glGenTextures(1, &dstTex);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, dstTex);
+		for (int f=0; f<6; ++f) {
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + f, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
+
+		int best = -1;
+		for (int i=0; i<kGLCopyStrategyCount; ++i) {
+			t.copyMs[b][i] = measureCopy(copy, i, srcTex, dstTex, size);
+			if (0 <= t.copyMs[b][i] && (best < 0 || t.copyMs[b][i] < t.copyMs[b][best])) best = i;
+		}
+		// ǂ̕@Rs[łȂꍇ́AvOƓBlitɂĂ
+		t.strategies[b] = 0 <= best ? best : kGLCopyStrategyBlit;
+
+		glDeleteTextures(1, &srcTex);
+		glDeleteTextures(1, &dstTex);
+	}
+	return t;
+}
+
+}	// namespace
+
+
+GLCopyTuning::GLCopyTuning()
+{
+	for (int b=0; b<kGLCopySizeBucketCount; ++b) {
+		strategies[b] = kGLCopyStrategyBlit;
+		for (int i=0; i<kGLCopyStrategyCount; ++i) copyMs[b][i] = -1.0f;
+	}
+}
+
+GLCopyTuning tuneGLCopy(const GLCopyFunc& copy)
+{
+	const std::string renderer = glString(GL_RENDERER);
+	const std::string version = glString(GL_VERSION);
+	const std::string deviceKey = renderer + "\n" + version;
+
+	std::lock_guard<std::mutex> lock(s_TuningMutex);
+	if (!s_LastDeviceKey.empty() && s_LastDeviceKey == deviceKey) return s_LastTuning;
+
+	GLCopyTuning t;
+	const std::string path = cacheFilePath(deviceKey);
+	if (path.empty() || !loadTuning(path, renderer, version, &t)) {
+		t = measureTuning(copy);
+		if (!path.empty()) saveTuning(path, renderer, version, t);
+	}
+
+	s_LastDeviceKey = deviceKey;
+	s_LastTuning = t;
+	return t;
+}
+
+const char* getGLCopyStrategyName(int strategy)
+{
+	return 0 <= strategy && strategy < kGLCopyStrategyCount ? kStrategyNames[strategy] : "unknown";
+}
+
+
+#endif // #if SUPPORT_OPENGL_UNIFIED && SUPPORT_OPENGL_SHADER_OPS
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "OpenGLCommon.h"
+
+//
+// eNX`̃Rs[@(FBOBlitEglCopyImageSubDataESʕ`)̂Ał̂傫ƂɑIԁB
+// ǂꂪ̓hCoɂđ傫قȂ̂ŁAfoCX̏Ɋe@2DL[u}bv̖ʂ̃Rs[vČ߂B
+// ʂ GL_RENDEREREGL_VERSION ƂɃ[U[̃LbVpfBNg֕ۑAȍ~͌vɓǂݍށB
+// hCoXVƕ񂪕ς̂ŌvBʂjꍇ̓t@C폜΂悢B
+//
+
+#if SUPPORT_OPENGL_SHADER_OPS
+
+#include <functional>
+
+
+/** eNX`̃Rs[@ */
+enum GLCopyStrategy
+{
+	kGLCopyStrategyBlit,		//!< FBOɕt glBlitFramebuffer
+	kGLCopyStrategyCopyImage,	//!< glCopyImageSubDataB`ꍇ̂
+	kGLCopyStrategyDraw,		//!< Rs[ɑSʕ`BRs[2DeNX`̏ꍇ̂
+
+	kGLCopyStrategyCount
+};
+
+/** Rs[@Iѕ傫̋敪B1 128ȉ / 512ȉ / 傫 */
+static const int kGLCopySizeBucketCount = 3;
+
+/** 1ӂ̑傫ɑΉ敪Ԃ */
+static inline int getGLCopySizeBucket(int size) { return size <= 128 ? 0 : size <= 512 ? 1 : 2; }
+
+/** e敪őI񂾃Rs[@ƁǍvl */
+struct GLCopyTuning
+{
+	int strategies[kGLCopySizeBucketCount];							//!< GLCopyStrategy
+	float copyMs[kGLCopySizeBucketCount][kGLCopyStrategyCount];		//!< 6ʂ̃Rs[ɂԁBgȂ@͕
+
+	/** vÓAǂ̊łgBlitIł */
+	GLCopyTuning();
+
+	int select(int size) const { return strategies[getGLCopySizeBucket(size)]; }
+};
+
+/**
+ * w̕@ŁA2DeNX`L[u}bv1(~bvx0)փRs[֐B
+ * face0~5B@gȂꍇARs[ȂꍇfalseԂBfalseԂ@͑I΂Ȃ
+ */
+typedef std::function<bool(int strategy, GLuint srcTex, GLuint dstCubemapTex, int face, int size)> GLCopyFunc;
+
+/**
+ * ݂̃ReLXgɍRs[@IԁBۑς݂̌ʂ΂gAȂ copy Ŋe@vĕۑB
+ * _[XbhAfoCX̏ɌĂԁBvZXōēxꂽꍇ͑Ǒʂg
+ */
+GLCopyTuning tuneGLCopy(const GLCopyFunc& copy);
+
+/** Rs[@̖OBLbṼt@Cɏo */
+const char* getGLCopyStrategyName(int strategy);
+
+
+#endif // #if SUPPORT_OPENGL_SHADER_OPS
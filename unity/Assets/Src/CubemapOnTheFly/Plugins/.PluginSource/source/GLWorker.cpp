@@ -0,0 +1,391 @@
+#include "PlatformBase.h"
+
+#if UNITY_WIN
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#endif
+
+#include "GLWorker.h"
+#include "Tracer.h"
+#include "ProfilerMarkers.h"
+
+#if SUPPORT_OPENGL_UNIFIED && SUPPORT_OPENGL_WORKER
+
+#if UNITY_OSX
+#	include <OpenGL/OpenGL.h>
+#elif UNITY_LINUX
+#	include <EGL/egl.h>
+#	include <GL/glx.h>
+#endif
+
+#include <assert.h>
+
+
+// --------------------------------------------------------------------------
+// vbgtH[Ƃ̋LReLXg
+
+
+/**
+ * UnitỹReLXgƃIuWFNgLReLXgB
+ * create UnitỹReLXgLȃXbhŁAmakeCurrent / releaseCurrent ̓[J[XbhŌĂ
+ */
+struct GLWorker::SharedContext
+{
+	bool create();
+	bool makeCurrent();
+	void releaseCurrent();
+	void destroy();
+
+	/** UnitỹReLXgƓo[WEvt@C擾 */
+	static void getContextVersion(int* major, int* minor, int* profileMask)
+	{
+		*major = *minor = *profileMask = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, major);
+		glGetIntegerv(GL_MINOR_VERSION, minor);
+		if (3 < *major || (*major == 3 && 2 <= *minor))
+			glGetIntegerv(GL_CONTEXT_PROFILE_MASK, profileMask);
+		glGetError();	// ESł̓vt@C擾łȂ̂ŁÃG[cȂ
+	}
+
+#if UNITY_WIN
+	HDC dc;
+	HGLRC context;
+#elif UNITY_OSX
+	CGLContextObj context;
+#elif UNITY_LINUX
+	// UnityEGLō쐬ĂꍇEGLAłȂGLXō쐬
+	bool isEGL;
+	EGLDisplay eglDisplay;
+	EGLContext eglContext;
+	EGLSurface eglSurface;
+	EGLenum eglAPI;
+	Display* glxDisplay;
+	GLXContext glxContext;
+	GLXPbuffer glxPbuffer;
+#endif
+};
+
+
+#if UNITY_WIN
+
+bool GLWorker::SharedContext::create()
+{
+	typedef HGLRC (WINAPI* CreateContextAttribsFunc)(HDC dc, HGLRC shareContext, const int* attribs);
+	static const int kMajorVersion = 0x2091;		// WGL_CONTEXT_MAJOR_VERSION_ARB
+	static const int kMinorVersion = 0x2092;		// WGL_CONTEXT_MINOR_VERSION_ARB
+	static const int kProfileMask = 0x9126;			// WGL_CONTEXT_PROFILE_MASK_ARB
+
+	dc = wglGetCurrentDC();
+	HGLRC current = wglGetCurrentContext();
+	if (!dc || !current) return false;
+
+	// Corevt@CƂ̋ĹAo[WEvt@Cō쐬ReLXgłȂƎs
+	CreateContextAttribsFunc createContextAttribs =
+		(CreateContextAttribsFunc)wglGetProcAddress("wglCreateContextAttribsARB");
+	if (createContextAttribs) {
+		int major, minor, profileMask;
+		getContextVersion(&major, &minor, &profileMask);
+		const int attribs[] = {
+			kMajorVersion, major,
+			kMinorVersion, minor,
+			kProfileMask, profileMask,
+			0
+		};
+		context = createContextAttribs(dc, current, attribs);
+	} else {
+		context = wglCreateContext(dc);
+		if (context && !wglShareLists(current, context)) {
+			wglDeleteContext(context);
+			context = NULL;
+		}
+	}
+	return context != NULL;
+}
+
+bool GLWorker::SharedContext::makeCurrent() { return wglMakeCurrent(dc, context) != FALSE; }
+void GLWorker::SharedContext::releaseCurrent() { wglMakeCurrent(NULL, NULL); }
+void GLWorker::SharedContext::destroy() { wglDeleteContext(context); }
+
+#elif UNITY_OSX
+
+bool GLWorker::SharedContext::create()
+{
+	CGLContextObj current = CGLGetCurrentContext();
+	if (!current) return false;
+
+	context = NULL;
+	return CGLCreateContext(CGLGetPixelFormat(current), current, &context) == kCGLNoError;
+}
+
+bool GLWorker::SharedContext::makeCurrent() { return CGLSetCurrentContext(context) == kCGLNoError; }
+void GLWorker::SharedContext::releaseCurrent() { CGLSetCurrentContext(NULL); }
+void GLWorker::SharedContext::destroy() { CGLDestroyContext(context); }
+
+#elif UNITY_LINUX
+
+bool GLWorker::SharedContext::create()
+{
+	int major, minor, profileMask;
+	getContextVersion(&major, &minor, &profileMask);
+
+	eglDisplay = eglGetCurrentDisplay();
+	eglContext = eglGetCurrentContext();
+	isEGL = eglContext != EGL_NO_CONTEXT;
+	if (isEGL) {
+		// UnityƓRtBOEAPIʂō쐬
+		EGLint configId = 0;
+		eglQueryContext(eglDisplay, eglContext, EGL_CONFIG_ID, &configId);
+		const EGLint configAttribs[] = { EGL_CONFIG_ID, configId, EGL_NONE };
+		EGLConfig config = NULL;
+		EGLint configCnt = 0;
+		if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configCnt) || configCnt == 0) return false;
+
+		eglAPI = eglQueryAPI();
+		EGLint contextAttribs[7] = { EGL_NONE };
+		if (eglAPI == EGL_OPENGL_ES_API) {
+			contextAttribs[0] = EGL_CONTEXT_CLIENT_VERSION;
+			contextAttribs[1] = major;
+			contextAttribs[2] = EGL_NONE;
+		} else {
+			contextAttribs[0] = EGL_CONTEXT_MAJOR_VERSION;
+			contextAttribs[1] = major;
+			contextAttribs[2] = EGL_CONTEXT_MINOR_VERSION;
+			contextAttribs[3] = minor;
+			contextAttribs[4] = EGL_CONTEXT_OPENGL_PROFILE_MASK;
+			contextAttribs[5] = profileMask ? profileMask : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT;
+			contextAttribs[6] = EGL_NONE;
+		}
+		EGLContext shared = eglCreateContext(eglDisplay, config, eglContext, contextAttribs);
+		if (shared == EGL_NO_CONTEXT) return false;
+		eglContext = shared;
+
+		// `͎gpȂ̂ŁAŏPbufferƂB쐬łȂꍇ̓T[tFXȂŗLɂ
+		const EGLint surfaceAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+		eglSurface = eglCreatePbufferSurface(eglDisplay, config, surfaceAttribs);
+		return true;
+	}
+
+	// GLXBUnitỹvC[ƓDisplayʃXbhgp̂ŁAXInitThreadsς݂ł邱
+	glxDisplay = glXGetCurrentDisplay();
+	GLXContext current = glXGetCurrentContext();
+	if (!glxDisplay || !current) return false;
+
+	int fbConfigId = 0, screen = 0;
+	glXQueryContext(glxDisplay, current, GLX_FBCONFIG_ID, &fbConfigId);
+	glXQueryContext(glxDisplay, current, GLX_SCREEN, &screen);
+	const int fbConfigAttribs[] = { GLX_FBCONFIG_ID, fbConfigId, None };
+	int fbConfigCnt = 0;
+	GLXFBConfig* fbConfigs = glXChooseFBConfig(glxDisplay, screen, fbConfigAttribs, &fbConfigCnt);
+	if (!fbConfigs || fbConfigCnt == 0) return false;
+	GLXFBConfig fbConfig = fbConfigs[0];
+	XFree(fbConfigs);
+
+	typedef GLXContext (*CreateContextAttribsFunc)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
+	CreateContextAttribsFunc createContextAttribs =
+		(CreateContextAttribsFunc)glXGetProcAddressARB((const GLubyte*)"glXCreateContextAttribsARB");
+	if (createContextAttribs && profileMask) {
+		const int contextAttribs[] = {
+			0x2091, major,				// GLX_CONTEXT_MAJOR_VERSION_ARB
+			0x2092, minor,				// GLX_CONTEXT_MINOR_VERSION_ARB
+			0x9126, profileMask,		// GLX_CONTEXT_PROFILE_MASK_ARB
+			None
+		};
+		glxContext = createContextAttribs(glxDisplay, fbConfig, current, True, contextAttribs);
+	} else {
+		glxContext = glXCreateNewContext(glxDisplay, fbConfig, GLX_RGBA_TYPE, current, True);
+	}
+	if (!glxContext) return false;
+
+	// PbufferɑΉĂȂRtBOō쐬X̃G[ɂȂ̂ŁAΉĂꍇ̂ݍ쐬
+	int drawableType = 0;
+	glXGetFBConfigAttrib(glxDisplay, fbConfig, GLX_DRAWABLE_TYPE, &drawableType);
+	glxPbuffer = None;
+	if (drawableType & GLX_PBUFFER_BIT) {
+		const int pbufferAttribs[] = { GLX_PBUFFER_WIDTH, 1, GLX_PBUFFER_HEIGHT, 1, None };
+		glxPbuffer = glXCreatePbuffer(glxDisplay, fbConfig, pbufferAttribs);
+	}
+	return true;
+}
+
+bool GLWorker::SharedContext::makeCurrent()
+{
+	if (isEGL) {
+		eglBindAPI(eglAPI);
+		return eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext) == EGL_TRUE;
+	}
+	return glXMakeContextCurrent(glxDisplay, glxPbuffer, glxPbuffer, glxContext) == True;
+}
+
+void GLWorker::SharedContext::releaseCurrent()
+{
+	if (isEGL) eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	else glXMakeContextCurrent(glxDisplay, None, None, NULL);
+}
+
+void GLWorker::SharedContext::destroy()
+{
+	if (isEGL) {
+		if (eglSurface != EGL_NO_SURFACE) eglDestroySurface(eglDisplay, eglSurface);
+		eglDestroyContext(eglDisplay, eglContext);
+	} else {
+		if (glxPbuffer != None) glXDestroyPbuffer(glxDisplay, glxPbuffer);
+		glXDestroyContext(glxDisplay, glxContext);
+	}
+}
+
+#endif
+
+
+// --------------------------------------------------------------------------
+// GLWorker
+
+
+GLWorker::GLWorker() :
+	_context(NULL),
+	_startState(0),
+	_isStopping(false)
+{}
+
+GLWorker::~GLWorker()
+{
+	// ReLXg̔jɂGĽĂяoKvȂ̂ŁAstop ̓_[Xbhōς܂Ă
+	assert(_context == NULL);
+}
+
+bool GLWorker::start()
+{
+	if (_context) return true;
+
+	SharedContext* context = new SharedContext();
+	if (!context->create()) {
+		delete context;
+		return false;
+	}
+
+	// XbhŃReLXgLɂł܂ő҂
+	_startState = 0;
+	_isStopping = false;
+	_context = context;
+	_thread = std::thread(&GLWorker::threadMain, this);
+	int startState;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cond.wait(lock, [this]() { return _startState != 0; });
+		startState = _startState;
+	}
+	if (startState < 0) {
+		_thread.join();
+		_context->destroy();
+		delete _context;
+		_context = NULL;
+		return false;
+	}
+	return true;
+}
+
+void GLWorker::stop()
+{
+	if (!_context) return;
+
+	// s͍̏Ō܂ōsAȊO͎sɎ̂Ă
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isStopping = true;
+	}
+	_cond.notify_all();
+	_thread.join();
+
+	pollCompletions();
+	for (size_t i=0; i<_jobs.size(); ++i) {
+		glDeleteSync(_jobs[i].acquireFence);
+		if (_jobs[i].completion) _jobs[i].completion(false);
+	}
+	_jobs.clear();
+
+	_context->destroy();
+	delete _context;
+	_context = NULL;
+}
+
+bool GLWorker::submit(const std::function<bool()>& job, const std::function<void(bool succeeded)>& completion)
+{
+	if (!_context || !job) return false;
+
+	// [J[Unity̒O܂ł̃R}h̊҂Ă悤ɁAtFX}GPU֑oĂ
+	Job j;
+	j.fn = job;
+	j.completion = completion;
+	j.acquireFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	j.releaseFence = NULL;
+	j.succeeded = false;
+	if (!j.acquireFence) return false;
+	glFlush();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_jobs.push_back(j);
+	}
+	_cond.notify_all();
+	return true;
+}
+
+void GLWorker::pollCompletions()
+{
+	std::vector<Job> completed;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_completed.empty()) return;
+		completed.swap(_completed);
+	}
+
+	// [J[̏̊AUnitỹR}hXg[ő҂BCPU͂ő҂Ȃ
+	for (size_t i=0; i<completed.size(); ++i) {
+		Job& j = completed[i];
+		glWaitSync(j.releaseFence, 0, GL_TIMEOUT_IGNORED);
+		glDeleteSync(j.releaseFence);
+		if (j.completion) j.completion(j.succeeded);
+	}
+}
+
+void GLWorker::threadMain()
+{
+	setTraceThreadName("CubemapBuilderPlugin GLWorker");
+	ProfilerThreadScope profilerThread("GLWorker");
+	const bool isCurrent = _context->makeCurrent();
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_startState = isCurrent ? 1 : -1;
+	}
+	_cond.notify_all();
+	if (!isCurrent) return;
+
+	for (;;) {
+		Job j;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cond.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+			if (_isStopping) break;
+			j = _jobs.front();
+			_jobs.pop_front();
+		}
+
+		glWaitSync(j.acquireFence, 0, GL_TIMEOUT_IGNORED);
+		glDeleteSync(j.acquireFence);
+		{
+			TraceScope trace("GLWorkerJob");
+			j.succeeded = j.fn();
+		}
+
+		// tFXÃReLXg҂Ă悤GPU֑oĂ
+		j.releaseFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_completed.push_back(j);
+	}
+
+	_context->releaseCurrent();
+}
+
+
+#endif // #if SUPPORT_OPENGL_UNIFIED && SUPPORT_OPENGL_WORKER
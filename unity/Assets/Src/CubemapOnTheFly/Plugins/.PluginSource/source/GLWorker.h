@@ -0,0 +1,84 @@
+#pragma once
+
+#include "OpenGLCommon.h"
+
+//
+// UnitỹReLXgƃIuWFNgLGLReLXg[J[XbhB
+// eNX`ւ̓]ȂǁA_[Xbh~߂Ă܂obNOEhōsB
+//
+// ̑O̓tFXœBǉUnitỹReLXg֑}tFX[J[ő҂Ă珈A
+// Ƀ[J[ő}tFXA̎荞ݎUnitỹR}hXg[ő҂(glWaitSync)B
+// ǂGPUł̑҂킹Ȃ̂ŁAǂ̃Xbh glFinish ȂǂŎ~߂ȂB
+//
+// t[obt@VAOȂǂ̃ReiIuWFNg̓ReLXgԂŋLȂ̂ŁA
+// ̓eNX`Eobt@݂̂̂ɌB
+//
+
+#if SUPPORT_OPENGL_WORKER
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class GLWorker
+{
+public:
+	GLWorker();
+	~GLWorker();
+
+	/**
+	 * ݂̃Xbh̃ReLXgƋLReLXg쐬āA[J[XbhJnB
+	 * Unitỹ_[XbhĂԁBLReLXg쐬łȂꍇfalse
+	 */
+	bool start();
+
+	/** s̏sƂĊĂAXbhƃReLXgjB_[XbhĂ */
+	void stop();
+
+	bool isRunning() const { return _context != NULL; }
+
+	/** ݂̃Xbh[J[Xbhۂ */
+	bool isWorkerThread() const { return std::this_thread::get_id() == _thread.get_id(); }
+
+	/**
+	 * ǉB_[XbhĂԁB
+	 * job͂܂łUnityŔsGPUR}ȟɁA[J[XbhŎsB
+	 * job̌ʂUnityQƂł悤ɂȂƁApollCompletions ̒ completion Ă΂
+	 */
+	bool submit(const std::function<bool()>& job, const std::function<void(bool succeeded)>& completion);
+
+	/** ̌ʂUnitỹReLXgQƂł悤ɂāAcompletion ĂԁB_[XbhĂ */
+	void pollCompletions();
+
+private:
+	struct SharedContext;
+
+	struct Job
+	{
+		std::function<bool()> fn;
+		std::function<void(bool)> completion;
+		GLsync acquireFence;		//!< Unityő}ȂOɑ҂tFX
+		GLsync releaseFence;		//!< [J[ő}ÅtFX
+		bool succeeded;
+	};
+
+	SharedContext* _context;
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _cond;
+	std::deque<Job> _jobs;			//!< s̏
+	std::vector<Job> _completed;	//!< sς݂ŁAcompletion ĂłȂ
+	int _startState;				//!< 0:Jn 1:Jnς -1:ReLXgLɂłȂ
+	bool _isStopping;
+
+	void threadMain();
+
+	GLWorker(const GLWorker&);
+	GLWorker& operator=(const GLWorker&);
+};
+
+#endif // #if SUPPORT_OPENGL_WORKER
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "PluginStats.h"
+
+#include <stddef.h>
+
+//
+// GPUԂv^C}[NGAǂݖ߂悤ɂȂ܂ŕێĂŒ蒷̃L[B
+// NG̔sƌʂ̎擾̓OtBbNXAPIƂɈقȂ̂ŁAe RenderAPI ̎NǦ^w肵ĎgB
+// ʂ̓t[܂œǂݖ߂悤ɂȂ̂珇Ɏ荞ނ̂ŁA_[Xbh҂ȂB
+// ǂݖ߂ǂɖtɂȂꍇ́Ȁ̌v߂ recordDroppedGpuTimer ŋL^B
+//
+
+
+template<typename Query, int N = 32>
+class GpuTimerQueue
+{
+public:
+	struct Entry
+	{
+		Query query;
+		int op;			//!< PluginOp
+		int size;		//!< eNX`̈
+	};
+
+	GpuTimerQueue() : _head(0), _count(0), _active(NULL) {}
+
+	/** NG̍쐬EjpɁASGgԂ */
+	Entry* entries() { return _entries; }
+	static int capacity() { return N; }
+
+	/** vJnGgmۂBtEv̏ꍇNULL */
+	Entry* begin(int op, int size)
+	{
+		if (_active) return NULL;
+		if (_count == N) {
+			recordDroppedGpuTimer();
+			return NULL;
+		}
+		Entry* e = &_entries[(_head + _count) % N];
+		++_count;
+		e->op = op;
+		e->size = size;
+		_active = e;
+		return e;
+	}
+
+	/** ṽGgIBvłȂꍇNULL */
+	Entry* end()
+	{
+		Entry* e = _active;
+		_active = NULL;
+		return e;
+	}
+
+	/** ʂ҂ĂłÂGgBv̂̂͊܂܂Ȃ */
+	Entry* front()
+	{
+		if (_count == 0) return NULL;
+		Entry* e = &_entries[_head];
+		return e == _active ? NULL : e;
+	}
+
+	/** front ̃GǧʂL^Ď菜BisValidfalsȅꍇ͋L^Ȃ */
+	void pop(unsigned long long ns, bool isValid)
+	{
+		if (isValid) recordGpuTime(_entries[_head].op, _entries[_head].size, ns);
+		_head = (_head + 1) % N;
+		--_count;
+	}
+
+	/** ʂ҂Ăׂ̂Ď̂ĂBfoCX̔jȂǂɎg */
+	void clear()
+	{
+		_head = 0;
+		_count = 0;
+		_active = NULL;
+	}
+
+private:
+	Entry _entries[N];
+	int _head;
+	int _count;
+	Entry* _active;
+
+	GpuTimerQueue(const GpuTimerQueue&);
+	GpuTimerQueue& operator=(const GpuTimerQueue&);
+};
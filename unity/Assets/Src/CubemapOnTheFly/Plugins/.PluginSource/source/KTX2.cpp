@@ -0,0 +1,255 @@
+#include "KTX2.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+// QlFhttps://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+
+static const unsigned char kKTX2Identifier[12] = {
+	0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+
+static const char* const kKeyName = "CubemapOnTheFly.key";
+
+// wb_ẽItZbg
+static const size_t kHeaderBytes = 12 + 9*4;
+static const size_t kIndexBytes = 4*4 + 8*2;
+static const size_t kLevelIndexEntryBytes = 8*3;
+
+/** PixelFormat ɑΉ VkFormat */
+static unsigned int toVkFormat(int format)
+{
+	switch (format) {
+	case kPixelFormatRGBA8 : return 37;			// VK_FORMAT_R8G8B8A8_UNORM
+	case kPixelFormatRGBA8_SRGB : return 43;	// VK_FORMAT_R8G8B8A8_SRGB
+	case kPixelFormatRGBAHalf : return 97;		// VK_FORMAT_R16G16B16A16_SFLOAT
+	default : return 0;
+	}
+}
+
+static int fromVkFormat(unsigned int vkFormat)
+{
+	switch (vkFormat) {
+	case 37 : return kPixelFormatRGBA8;
+	case 43 : return kPixelFormatRGBA8_SRGB;
+	case 97 : return kPixelFormatRGBAHalf;
+	default : return -1;
+	}
+}
+
+static size_t alignUp(size_t a, size_t align) { return (a + align - 1) / align * align; }
+
+static void putU32(std::vector<unsigned char>& buf, unsigned int v) {
+	for (int i=0; i<4; ++i) buf.push_back( (unsigned char)(v >> (i*8)) );
+}
+static void putU64(std::vector<unsigned char>& buf, unsigned long long v) {
+	for (int i=0; i<8; ++i) buf.push_back( (unsigned char)(v >> (i*8)) );
+}
+static unsigned int getU32(const unsigned char* p) {
+	return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+static unsigned long long getU64(const unsigned char* p) {
+	return (unsigned long long)getU32(p) | ((unsigned long long)getU32(p + 4) << 32);
+}
+
+/** {f[^`Lqq(DFD)ށBRGBA4Tv\ */
+static void putDFD(std::vector<unsigned char>& buf, int format)
+{
+	const bool isHalf = format == kPixelFormatRGBAHalf;
+	const bool isSRGB = format == kPixelFormatRGBA8_SRGB;
+	const unsigned int bits = isHalf ? 16 : 8;
+	const unsigned int blockBytes = 24 + 16*4;
+
+	putU32(buf, 4 + blockBytes);		// dfdTotalSize
+	putU32(buf, 0);						// vendorId = KHR, descriptorType = basic
+	putU32(buf, 2 | (blockBytes << 16));	// versionNumber = 2
+	putU32(buf, 1 | (1 << 8) | ((isSRGB ? 2u : 1u) << 16));	// RGBSDA, BT709, sRGB/linear
+	putU32(buf, 0);						// texelBlockDimension = 1x1x1x1
+	putU32(buf, pixelFormatBytes(format));	// bytesPlane0
+	putU32(buf, 0);
+
+	static const unsigned int kChannelIds[4] = { 0, 1, 2, 15 };		// R, G, B, A
+	for (int i=0; i<4; ++i) {
+		unsigned int channelType = kChannelIds[i];
+		if (isHalf) channelType |= 0x80 | 0x40;		// float, signed
+		if (isSRGB && i == 3) channelType |= 0x10;	// At@͐`
+		putU32(buf, (bits * i) | ((bits - 1) << 16) | (channelType << 24));
+		putU32(buf, 0);								// samplePosition
+		putU32(buf, isHalf ? 0xBF800000u : 0);		// sampleLower (-1.0f / 0)
+		putU32(buf, isHalf ? 0x3F800000u : 255);	// sampleUpper (1.0f / 255)
+	}
+}
+
+/** Key/Valuef[^1Gg */
+static void putKeyValue(std::vector<unsigned char>& buf, const char* key, const char* value)
+{
+	size_t keyLen = strlen(key) + 1, valueLen = strlen(value) + 1;
+	putU32(buf, (unsigned int)(keyLen + valueLen));
+	buf.insert(buf.end(), key, key + keyLen);
+	buf.insert(buf.end(), value, value + valueLen);
+	while (buf.size() % 4 != 0) buf.push_back(0);
+}
+
+
+bool writeKTX2Cubemap(
+	const char* path,
+	int size, int mipCount, int format,
+	const void* const* levelData,
+	const char* key
+) {
+	if (!path || !levelData || size <= 0 || mipCount <= 0) return false;
+	if (toVkFormat(format) == 0) return false;
+	if (!key) key = "";
+	for (int i=0; i<mipCount; ++i) if (!levelData[i]) return false;
+
+	// f[^ȊO̕ɑgݗĂ
+	std::vector<unsigned char> dfd, kvd;
+	putDFD(dfd, format);
+	putKeyValue(kvd, kKeyName, key);	// L[̓oCgɃ\[gĂKv
+	putKeyValue(kvd, "KTXwriter", "CubemapOnTheFly");
+
+	const size_t dfdOffset = kHeaderBytes + kIndexBytes + kLevelIndexEntryBytes * mipCount;
+	const size_t kvdOffset = dfdOffset + dfd.size();
+	const size_t levelAlign = format == kPixelFormatRGBAHalf ? 8 : 4;
+
+	// ~bvx̃f[^͏̂珇ɕׂ
+	std::vector<size_t> levelOffsets(mipCount), levelBytes(mipCount);
+	size_t offset = kvdOffset + kvd.size();
+	for (int i=mipCount-1; 0<=i; --i) {
+		offset = alignUp(offset, levelAlign);
+		levelOffsets[i] = offset;
+		levelBytes[i] = cubemapFaceBytes(size, i, format) * 6;
+		offset += levelBytes[i];
+	}
+
+	std::vector<unsigned char> head(kKTX2Identifier, kKTX2Identifier + 12);
+	putU32(head, toVkFormat(format));
+	putU32(head, format == kPixelFormatRGBAHalf ? 2 : 1);	// typeSize
+	putU32(head, size);		// pixelWidth
+	putU32(head, size);		// pixelHeight
+	putU32(head, 0);		// pixelDepth
+	putU32(head, 0);		// layerCount
+	putU32(head, 6);		// faceCount
+	putU32(head, mipCount);	// levelCount
+	putU32(head, 0);		// supercompressionScheme
+	putU32(head, (unsigned int)dfdOffset);
+	putU32(head, (unsigned int)dfd.size());
+	putU32(head, (unsigned int)kvdOffset);
+	putU32(head, (unsigned int)kvd.size());
+	putU64(head, 0);		// sgdByteOffset
+	putU64(head, 0);		// sgdByteLength
+	for (int i=0; i<mipCount; ++i) {
+		putU64(head, levelOffsets[i]);
+		putU64(head, levelBytes[i]);
+		putU64(head, levelBytes[i]);
+	}
+	head.insert(head.end(), dfd.begin(), dfd.end());
+	head.insert(head.end(), kvd.begin(), kvd.end());
+
+	std::string tmpPath = std::string(path) + ".tmp";
+	FILE* fp = openFileUtf8(tmpPath.c_str(), "wb");
+	if (!fp) return false;
+
+	bool isSucceeded = fwrite(head.data(), 1, head.size(), fp) == head.size();
+	size_t written = head.size();
+	static const unsigned char kPadding[8] = {};
+	for (int i=mipCount-1; 0<=i && isSucceeded; --i) {
+		size_t pad = levelOffsets[i] - written;
+		isSucceeded = fwrite(kPadding, 1, pad, fp) == pad;
+		isSucceeded = isSucceeded && fwrite(levelData[i], 1, levelBytes[i], fp) == levelBytes[i];
+		written = levelOffsets[i] + levelBytes[i];
+	}
+	isSucceeded = fclose(fp) == 0 && isSucceeded;
+
+	if (!isSucceeded || !replaceFileUtf8(tmpPath.c_str(), path)) {
+		removeFileUtf8(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+
+KTX2CubemapFile::KTX2CubemapFile()
+	: _size(0)
+	, _mipCount(0)
+	, _format(-1)
+	, _key("")
+{}
+
+bool KTX2CubemapFile::open(const char* path)
+{
+	close();
+	if (!_file.open(path)) return false;
+
+	const unsigned char* p = _file.data();
+	const size_t fileSize = _file.size();
+	if (fileSize < kHeaderBytes + kIndexBytes || memcmp(p, kKTX2Identifier, 12) != 0) {
+		close();
+		return false;
+	}
+
+	const unsigned int width = getU32(p + 20), height = getU32(p + 24);
+	const unsigned int depth = getU32(p + 28), layerCount = getU32(p + 32);
+	const unsigned int faceCount = getU32(p + 36), levelCount = getU32(p + 40);
+	const unsigned int supercompression = getU32(p + 44);
+	const int format = fromVkFormat( getU32(p + 12) );
+	if (
+		format < 0 || width == 0 || width != height || depth != 0 || layerCount != 0 ||
+		faceCount != 6 || levelCount == 0 || kMaxMipCount < (int)levelCount ||
+		supercompression != 0 ||
+		fileSize < kHeaderBytes + kIndexBytes + kLevelIndexEntryBytes * levelCount
+	) {
+		close();
+		return false;
+	}
+
+	// e~bvx̃f[^t@CɎ܂Ă邱ƂmF
+	for (unsigned int i=0; i<levelCount; ++i) {
+		const unsigned char* entry = p + kHeaderBytes + kIndexBytes + kLevelIndexEntryBytes * i;
+		unsigned long long offset = getU64(entry), length = getU64(entry + 8);
+		if (length != cubemapFaceBytes(width, i, format) * 6 || fileSize < offset || fileSize - offset < length) {
+			close();
+			return false;
+		}
+		_levelOffsets[i] = (size_t)offset;
+	}
+
+	// Key/Valuef[^L[T
+	const unsigned int kvdOffset = getU32(p + 56), kvdLength = getU32(p + 60);
+	if (fileSize < kvdOffset || fileSize - kvdOffset < kvdLength) {
+		close();
+		return false;
+	}
+	for (unsigned int i=0; i+4<=kvdLength; ) {
+		const unsigned int len = getU32(p + kvdOffset + i);
+		if (kvdLength - i - 4 < len) break;
+		const char* kv = reinterpret_cast<const char*>(p + kvdOffset + i + 4);
+		const size_t keyLen = strlen(kKeyName) + 1;
+		if (keyLen < len && memcmp(kv, kKeyName, keyLen) == 0 && kv[len - 1] == '\0') {
+			_key = kv + keyLen;
+			break;
+		}
+		i += 4 + (unsigned int)alignUp(len, 4);
+	}
+
+	_size = (int)width;
+	_mipCount = (int)levelCount;
+	_format = format;
+	return true;
+}
+
+void KTX2CubemapFile::close()
+{
+	_file.close();
+	_size = _mipCount = 0;
+	_format = -1;
+	_key = "";
+}
+
+const void* KTX2CubemapFile::levelData(int level) const
+{
+	if (level < 0 || _mipCount <= level) return NULL;
+	return _file.data() + _levelOffsets[level];
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "FileIO.h"
+#include "PixelFormat.h"
+
+#include <stddef.h>
+
+//
+// L[u}bvKTX2t@C̓ǂݏB
+// 񈳏k(supercompressionȂ) PixelFormat ̌`݈̂B
+// LbV̎Ⴆh߁AL[Key/Valuef[^ "CubemapOnTheFly.key" Ɋi[B
+//
+
+
+/**
+ * L[u}bvKTX2t@CƂďށB
+ * levelData[i] ̓~bvxi6ʕʂ̏ɌԂȂ񂾂́B
+ * ꎞt@Cɏł獷ւ̂ŁAݓr̃t@Cǂ܂邱Ƃ͂Ȃ
+ */
+bool writeKTX2Cubemap(
+	const char* path,
+	int size, int mipCount, int format,
+	const void* const* levelData,
+	const char* key
+);
+
+
+/** Ƀ}bvKTX2̃L[u}bvt@C */
+class KTX2CubemapFile
+{
+public:
+	KTX2CubemapFile();
+
+	/** t@CJăwb_؂BΉĂȂ`̏ꍇfalseԂ */
+	bool open(const char* path);
+	void close();
+
+	int size() const { return _size; }
+	int mipCount() const { return _mipCount; }
+	int format() const { return _format; }
+
+	/** i[ĂL[Bꍇ͋󕶎 */
+	const char* key() const { return _key; }
+
+	/** w~bvx6ʕ̃f[^(ʂ̏ɌԂȂ񂾂) */
+	const void* levelData(int level) const;
+
+private:
+	static const int kMaxMipCount = 16;
+
+	MappedFile _file;
+	int _size, _mipCount, _format;
+	const char* _key;
+	size_t _levelOffsets[kMaxMipCount];
+};
@@ -0,0 +1,134 @@
+#include "LuminanceStats.h"
+#include "Parallel.h"
+#include "FrameArena.h"
+
+#include <math.h>
+#include <float.h>
+
+
+float texelSolidAngle(int size, int x, int y)
+{
+	// ʏ̓_(s, t)(-1~1)̗̊p ds*dt / (1 + s^2 + t^2)^(3/2)
+	float s = (x + 0.5f) * 2 / size - 1;
+	float t = (y + 0.5f) * 2 / size - 1;
+	float r2 = 1 + s*s + t*t;
+	float texelArea = 4.0f / ((float)size * size);
+	return texelArea / (r2 * sqrtf(r2));
+}
+
+int log2LuminanceToBin(float log2Lum, float minLog2Lum, float maxLog2Lum)
+{
+	float t = (log2Lum - minLog2Lum) / (maxLog2Lum - minLog2Lum);
+	return clampInt( (int)(t * kLuminanceHistogramBinCount), 0, kLuminanceHistogramBinCount-1 );
+}
+
+/** 8bitsRGBlA`l(0~1)ւ̕ϊe[u */
+static const float* getSRGBToLinearTable()
+{
+	static const struct Table {
+		float values[256];
+		Table() {
+			for (int i=0; i<256; ++i) {
+				float c = i / 255.0f;
+				values[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+			}
+		}
+	} s_table;
+	return s_table.values;
+}
+
+/** 1Xbh̏Wv */
+struct LuminancePartial
+{
+	double sumWeight, sumLum, sumLog2Lum;
+	float minLum, maxLum;
+	double bins[kLuminanceHistogramBinCount];
+};
+
+bool computeLuminanceStatsCPU(
+	const CubemapImageView& img,
+	bool isSRGB,
+	float minLog2Lum, float maxLog2Lum,
+	CubemapLuminanceStats* out
+) {
+	if (!img.pixels || img.size <= 0 || !out) return false;
+	if (!(minLog2Lum < maxLog2Lum)) return false;
+
+	const int n = img.size;
+	const float lumCoefs[4] = { 0.2126f/255, 0.7152f/255, 0.0722f/255, 0 };
+	const SimdFloat4 lumCoef = simdLoad(lumCoefs);
+	const float* srgbToLinear = isSRGB ? getSRGBToLinearTable() : NULL;
+
+	// ̊p̏d݂͊eʂŋʂȂ̂ŁA1ʕOvZĂ
+	FrameArena::Scope arena( getFrameArena() );
+	float* weights = arena.allocateArray<float>( (size_t)n * n );
+	if (!weights) return false;
+	for (int y=0; y<n; ++y) for (int x=0; x<n; ++x) weights[y*n + x] = texelSolidAngle(n, x, y);
+
+	// sPʂŕďWvAŌɂ܂Ƃ߂
+	const int rowCnt = n * 6;
+	const int partialCnt = getParallelThreadCount();
+	LuminancePartial* partials = arena.allocateArray<LuminancePartial>(partialCnt);
+	if (!partials) return false;
+	for (int i=0; i<partialCnt; ++i) {
+		LuminancePartial& p = partials[i];
+		p.sumWeight = p.sumLum = p.sumLog2Lum = 0;
+		p.minLum = FLT_MAX;
+		p.maxLum = 0;
+		for (int b=0; b<kLuminanceHistogramBinCount; ++b) p.bins[b] = 0;
+	}
+
+	parallelFor( partialCnt, [&](int begin, int end) {
+		for (int pi=begin; pi<end; ++pi) {
+			LuminancePartial& p = partials[pi];
+			const int rowBegin = (int)( (long long)rowCnt * pi / partialCnt );
+			const int rowEnd = (int)( (long long)rowCnt * (pi+1) / partialCnt );
+			for (int row=rowBegin; row<rowEnd; ++row) {
+				const int f = row / n;
+				const int y = row % n;
+				const unsigned char* src = img.texel(f, 0, y);
+				const float* w = &weights[y*n];
+				for (int x=0; x<n; ++x) {
+					float lum;
+					if (srgbToLinear) {
+						const unsigned char* t = src + x*4;
+						lum = 0.2126f * srgbToLinear[t[0]] + 0.7152f * srgbToLinear[t[1]] + 0.0722f * srgbToLinear[t[2]];
+					} else {
+						float c[4];
+						simdStore( c, simdMul( simdLoadRGBA8(src + x*4), lumCoef ) );
+						lum = c[0] + c[1] + c[2];
+					}
+					float log2Lum = log2f( lum < kMinLuminance ? kMinLuminance : lum );
+
+					if (lum < p.minLum) p.minLum = lum;
+					if (p.maxLum < lum) p.maxLum = lum;
+					p.sumWeight += w[x];
+					p.sumLum += w[x] * lum;
+					p.sumLog2Lum += w[x] * log2Lum;
+					p.bins[ log2LuminanceToBin(log2Lum, minLog2Lum, maxLog2Lum) ] += w[x];
+				}
+			}
+		}
+	} );
+
+	double sumWeight = 0, sumLum = 0, sumLog2Lum = 0;
+	double bins[kLuminanceHistogramBinCount] = {};
+	out->minLuminance = FLT_MAX;
+	out->maxLuminance = 0;
+	for (int i=0; i<partialCnt; ++i) {
+		const LuminancePartial& p = partials[i];
+		sumWeight += p.sumWeight;
+		sumLum += p.sumLum;
+		sumLog2Lum += p.sumLog2Lum;
+		for (int b=0; b<kLuminanceHistogramBinCount; ++b) bins[b] += p.bins[b];
+		if (p.minLum < out->minLuminance) out->minLuminance = p.minLum;
+		if (out->maxLuminance < p.maxLum) out->maxLuminance = p.maxLum;
+	}
+
+	out->averageLuminance = (float)(sumLum / sumWeight);
+	out->logAverageLuminance = exp2f( (float)(sumLog2Lum / sumWeight) );
+	out->minLog2Luminance = minLog2Lum;
+	out->maxLog2Luminance = maxLog2Lum;
+	for (int b=0; b<kLuminanceHistogramBinCount; ++b) out->histogram[b] = (float)(bins[b] / sumWeight);
+	return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CubemapImage.h"
+
+//
+// L[u}bv̋Pxv(Iop)B
+// ̊pŏdݕtΐPx̃qXgOƁAŏEőEϋPx߂B
+// GPU͊eRenderAPI computeLuminanceStats QƁB
+//
+
+
+/** qXgÕr */
+static const int kLuminanceHistogramBinCount = 64;
+
+/**
+ * Pxv̌ʁBC#̍\̂ƓCAEgB
+ * PxRGB0~1Ƃ`l Rec.709 ̌Wŋ߂
+ */
+struct CubemapLuminanceStats
+{
+	float minLuminance;			//!< ŏPx
+	float maxLuminance;			//!< őPx
+	float averageLuminance;		//!< ̊pŏdݕtϋPx
+	float logAverageLuminance;	//!< ̊pŏdݕtΐϋPx(exp2(log2Px))
+	float minLog2Luminance;		//!< qXgO͈̔͂̉(log2Px)
+	float maxLog2Luminance;		//!< qXgO͈̔͂̏(log2Px)
+
+	/**
+	 * log2Px [minLog2Luminance, maxLog2Luminance] œeŕÅp̊B
+	 * ͈͊ŐPx͗[̃rɓBv1
+	 */
+	float histogram[kLuminanceHistogramBinCount];
+};
+
+
+/** ΐς͈͂̉ɎgpAPx̉l */
+static const float kMinLuminance = 1.0f / 65536;
+
+/** ʂ̃TCYsizêƂ́AeNZ(x, y)̗̊pɔႷd݂ԂBSʂł̍v4 */
+float texelSolidAngle(int size, int x, int y);
+
+/** log2PxAw͈͂̃qXgÕrԍɕϊ */
+int log2LuminanceToBin(float log2Lum, float minLog2Lum, float maxLog2Lum);
+
+/**
+ * L[u}bv(1~bv)̋Pxv߂B
+ * isSRGB̏ꍇRGBsRGBƂ݂ȂAe[uŐ`lɕϊĂPx߂B
+ * ʂƍsPʂ̃^Cɕĕɏ
+ */
+bool computeLuminanceStatsCPU(
+	const CubemapImageView& img,
+	bool isSRGB,
+	float minLog2Lum, float maxLog2Lum,
+	CubemapLuminanceStats* out
+);
@@ -0,0 +1,272 @@
+#include "OpenGLCommon.h"
+
+#if SUPPORT_OPENGL_UNIFIED && SUPPORT_OPENGL_SHADER_OPS
+
+#include <assert.h>
+
+
+const char* getGLSLHeader(UnityGfxRenderer apiType)
+{
+	if (apiType == kUnityGfxRendererOpenGLCore)
+		return "#version 150\n";
+	return
+		"#version 300 es\n"
+		"precision highp float;\n"
+		"precision highp int;\n";
+}
+
+
+/** wʂ̃VF[_RpCBs0Ԃ */
+static GLuint compileGLShader(GLenum type, const char* const* srcs, int srcCnt)
+{
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, srcCnt, srcs, NULL);
+	glCompileShader(shader);
+
+	GLint status = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status == GL_FALSE) {
+		assert(false);
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+GLuint createGLProgram(
+	const char* const* vsSrcs, int vsSrcCnt,
+	const char* const* fsSrcs, int fsSrcCnt
+) {
+	GLuint vs = compileGLShader(GL_VERTEX_SHADER, vsSrcs, vsSrcCnt);
+	GLuint fs = compileGLShader(GL_FRAGMENT_SHADER, fsSrcs, fsSrcCnt);
+	if (vs == 0 || fs == 0) {
+		if (vs) glDeleteShader(vs);
+		if (fs) glDeleteShader(fs);
+		return 0;
+	}
+
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vs);
+	glAttachShader(program, fs);
+	glLinkProgram(program);
+	glDeleteShader(vs);
+	glDeleteShader(fs);
+
+	GLint status = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status == GL_FALSE) {
+		assert(false);
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+
+#if SUPPORT_OPENGL_COMPUTE
+
+bool isGLComputeSupported(UnityGfxRenderer apiType)
+{
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if (apiType == kUnityGfxRendererOpenGLCore)
+		return 4 < major || (major == 4 && 3 <= minor);
+	return 3 < major || (major == 3 && 1 <= minor);
+}
+
+const char* getGLSLComputeHeader(UnityGfxRenderer apiType)
+{
+	if (apiType == kUnityGfxRendererOpenGLCore)
+		return "#version 430\n";
+	return
+		"#version 310 es\n"
+		"precision highp float;\n"
+		"precision highp int;\n";
+}
+
+GLuint createGLComputeProgram(const char* const* srcs, int srcCnt)
+{
+	GLuint cs = compileGLShader(GL_COMPUTE_SHADER, srcs, srcCnt);
+	if (cs == 0) return 0;
+
+	GLuint program = glCreateProgram();
+	glAttachShader(program, cs);
+	glLinkProgram(program);
+	glDeleteShader(cs);
+
+	GLint status = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status == GL_FALSE) {
+		assert(false);
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+#endif // #if SUPPORT_OPENGL_COMPUTE
+
+#if SUPPORT_OPENGL_TEXTURE_STORAGE
+
+bool isGLTextureStorageSupported(UnityGfxRenderer apiType)
+{
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if (apiType == kUnityGfxRendererOpenGLCore)
+		return 4 < major || (major == 4 && 2 <= minor);
+	return 3 <= major;
+}
+
+#if SUPPORT_OPENGL_TEXTURE_VIEW
+bool isGLTextureViewSupported(UnityGfxRenderer apiType)
+{
+	if (apiType != kUnityGfxRendererOpenGLCore) return false;
+
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	return 4 < major || (major == 4 && 3 <= minor);
+}
+#endif
+
+#endif // #if SUPPORT_OPENGL_TEXTURE_STORAGE
+
+#if SUPPORT_OPENGL_COPY_IMAGE
+bool isGLCopyImageSupported(UnityGfxRenderer apiType)
+{
+	if (apiType != kUnityGfxRendererOpenGLCore) return false;
+
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	return 4 < major || (major == 4 && 3 <= minor);
+}
+#endif
+
+#if SUPPORT_OPENGL_TIMER_QUERY
+bool isGLTimerQuerySupported(UnityGfxRenderer apiType)
+{
+	if (apiType != kUnityGfxRendererOpenGLCore) return false;
+
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	return 3 < major || (major == 3 && 3 <= minor);
+}
+#endif
+
+
+const char* const kGLSLFullscreenVS =
+	"out vec2 vUV;\n"
+	"void main() {\n"
+	"	vec2 p = vec2( float((gl_VertexID << 1) & 2), float(gl_VertexID & 2) );\n"
+	"	vUV = p;\n"
+	"	gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);\n"
+	"}\n";
+
+const char* const kGLSLCubeMath =
+	"const float PI = 3.14159265358979;\n"
+	"float signNotZero(float a) { return a < 0.0 ? -1.0 : 1.0; }\n"
+	"vec3 faceUVToDir(int face, vec2 uv) {\n"
+	"	vec2 st = uv * 2.0 - 1.0;\n"
+	"	if (face == 0) return vec3( 1.0, -st.y, -st.x);\n"
+	"	if (face == 1) return vec3(-1.0, -st.y,  st.x);\n"
+	"	if (face == 2) return vec3( st.x,  1.0,  st.y);\n"
+	"	if (face == 3) return vec3( st.x, -1.0, -st.y);\n"
+	"	if (face == 4) return vec3( st.x, -st.y,  1.0);\n"
+	"	return vec3(-st.x, -st.y, -1.0);\n"
+	"}\n"
+	"vec3 projectionUVToDir(int projection, vec2 uv) {\n"
+	"	if (projection == 1) {\n"
+	"		vec2 p = uv * 2.0 - 1.0;\n"
+	"		float y = 1.0 - abs(p.x) - abs(p.y);\n"
+	"		if (y < 0.0) p = (1.0 - abs(p.yx)) * vec2(signNotZero(p.x), signNotZero(p.y));\n"
+	"		return normalize(vec3(p.x, y, p.y));\n"
+	"	}\n"
+	"	if (projection == 2) {\n"
+	"		bool isFront = uv.x < 0.5;\n"
+	"		vec2 p = vec2((isFront ? uv.x : uv.x - 0.5) * 4.0 - 1.0, uv.y * 2.0 - 1.0);\n"
+	"		float r2 = dot(p, p);\n"
+	"		if (1.0 < r2) { p *= inversesqrt(r2); r2 = 1.0; }\n"
+	"		vec3 d = vec3(2.0 * p, 1.0 - r2) / (1.0 + r2);\n"
+	"		return isFront ? d : vec3(-d.x, d.y, -d.z);\n"
+	"	}\n"
+	"	float lon = (uv.x - 0.5) * 2.0 * PI;\n"
+	"	float lat = (uv.y - 0.5) * PI;\n"
+	"	return vec3(cos(lat) * sin(lon), sin(lat), cos(lat) * cos(lon));\n"
+	"}\n"
+	"vec2 dirToProjectionUV(int projection, vec3 d) {\n"
+	"	if (projection == 1) {\n"
+	"		vec2 p = d.xz / (abs(d.x) + abs(d.y) + abs(d.z));\n"
+	"		if (d.y < 0.0) p = (1.0 - abs(p.yx)) * vec2(signNotZero(p.x), signNotZero(p.y));\n"
+	"		return p * 0.5 + 0.5;\n"
+	"	}\n"
+	"	if (projection == 2) {\n"
+	"		if (0.0 <= d.z) return vec2((d.x / (1.0 + d.z) * 0.5 + 0.5) * 0.5, d.y / (1.0 + d.z) * 0.5 + 0.5);\n"
+	"		return vec2((-d.x / (1.0 - d.z) * 0.5 + 0.5) * 0.5 + 0.5, d.y / (1.0 - d.z) * 0.5 + 0.5);\n"
+	"	}\n"
+	"	return vec2(atan(d.x, d.z) / (2.0 * PI) + 0.5, asin(clamp(d.y, -1.0, 1.0)) / PI + 0.5);\n"
+	"}\n";
+
+
+GLStateScope::GLStateScope(UnityGfxRenderer apiType)
+	: _isCore(apiType == kUnityGfxRendererOpenGLCore)
+	, _seamlessCubemap(GL_FALSE)
+{
+	glGetIntegerv(GL_VIEWPORT, _viewport);
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &_drawFBO);
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &_readFBO);
+	glGetIntegerv(GL_CURRENT_PROGRAM, &_program);
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &_vao);
+	glGetIntegerv(GL_ACTIVE_TEXTURE, &_activeTex);
+	glActiveTexture(GL_TEXTURE0);
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &_tex2D);
+	glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &_texCube);
+	glGetIntegerv(GL_SAMPLER_BINDING, &_sampler);
+	_depthTest = glIsEnabled(GL_DEPTH_TEST);
+	_blend = glIsEnabled(GL_BLEND);
+	_cullFace = glIsEnabled(GL_CULL_FACE);
+	_scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+	_stencilTest = glIsEnabled(GL_STENCIL_TEST);
+	glGetBooleanv(GL_COLOR_WRITEMASK, _colorMask);
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_STENCIL_TEST);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+	if (_isCore) {
+		_seamlessCubemap = glIsEnabled(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+		glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+	}
+}
+
+GLStateScope::~GLStateScope()
+{
+	#define RESTORE_CAP(cap, flag) if (flag) glEnable(cap); else glDisable(cap)
+	RESTORE_CAP(GL_DEPTH_TEST, _depthTest);
+	RESTORE_CAP(GL_BLEND, _blend);
+	RESTORE_CAP(GL_CULL_FACE, _cullFace);
+	RESTORE_CAP(GL_SCISSOR_TEST, _scissorTest);
+	RESTORE_CAP(GL_STENCIL_TEST, _stencilTest);
+	if (_isCore) { RESTORE_CAP(GL_TEXTURE_CUBE_MAP_SEAMLESS, _seamlessCubemap); }
+	#undef RESTORE_CAP
+	glColorMask(_colorMask[0], _colorMask[1], _colorMask[2], _colorMask[3]);
+
+	glBindSampler(0, _sampler);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, _texCube);
+	glBindTexture(GL_TEXTURE_2D, _tex2D);
+	glActiveTexture(_activeTex);
+	glBindVertexArray(_vao);
+	glUseProgram(_program);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, _readFBO);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _drawFBO);
+	glViewport(_viewport[0], _viewport[1], _viewport[2], _viewport[3]);
+}
+
+
+#endif // #if SUPPORT_OPENGL_UNIFIED && SUPPORT_OPENGL_SHADER_OPS
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "PlatformBase.h"
+#include "Unity/IUnityGraphics.h"
+
+//
+// OpenGL Core/ES p̋ʃwb_B
+// vbgtH[ƂGLwb_̓ǂݍ݂ƁAVF[_gp鏈̋ʕ܂Ƃ߂Ă
+//
+
+#if SUPPORT_OPENGL_UNIFIED
+
+
+#if UNITY_IOS || UNITY_TVOS
+#	include <OpenGLES/ES2/gl.h>
+#elif UNITY_ANDROID || UNITY_WEBGL
+#	include <GLES2/gl2.h>
+#elif UNITY_OSX
+#	include <OpenGL/gl3.h>
+#elif UNITY_WIN
+// On Windows, use gl3w to initialize and load OpenGL Core functions. In principle any other
+// library (like GLEW, GLFW etc.) can be used; here we use gl3w since it's simple and
+// straightforward.
+#	include "gl3w/gl3w.h"
+#elif UNITY_LINUX
+#	define GL_GLEXT_PROTOTYPES
+#	include <GL/gl.h>
+#else
+#	error Unknown platform
+#endif
+
+// ES2.0̃wb_ł́AVF[_gp鏈(TvIuWFNgVAOKv)͖ΉƂ
+#if UNITY_IOS || UNITY_TVOS || UNITY_ANDROID || UNITY_WEBGL
+#	define SUPPORT_OPENGL_SHADER_OPS 0
+#else
+#	define SUPPORT_OPENGL_SHADER_OPS 1
+#endif
+
+// Rs[gVF[_gp鏈́Awb_ɒ`ꍇ̂ݑΉƂ(macOSGL4.1͔Ή)B
+// sɂ isGLComputeSupported ŃReLXg̃o[WmF邱
+#if SUPPORT_OPENGL_SHADER_OPS && defined(GL_COMPUTE_SHADER)
+#	define SUPPORT_OPENGL_COMPUTE 1
+#else
+#	define SUPPORT_OPENGL_COMPUTE 0
+#endif
+
+// ύXsȃeNX`Xg[W(glTexStorage2D)lɁAwb_ɒ`ꍇ̂ݑΉƂB
+// sɂ isGLTextureStorageSupported ŃReLXg̃o[WmF邱
+#if SUPPORT_OPENGL_SHADER_OPS && defined(GL_TEXTURE_IMMUTABLE_FORMAT)
+#	define SUPPORT_OPENGL_TEXTURE_STORAGE 1
+#else
+#	define SUPPORT_OPENGL_TEXTURE_STORAGE 0
+#endif
+
+// eNX`r[(glTextureView)lBsɂ isGLTextureViewSupported ŊmF邱
+#if SUPPORT_OPENGL_TEXTURE_STORAGE && defined(GL_TEXTURE_VIEW_MIN_LAYER)
+#	define SUPPORT_OPENGL_TEXTURE_VIEW 1
+#else
+#	define SUPPORT_OPENGL_TEXTURE_VIEW 0
+#endif
+
+// eNX`Ԃ̒ڃRs[(glCopyImageSubData)lBsɂ isGLCopyImageSupported ŊmF邱
+#if SUPPORT_OPENGL_SHADER_OPS && defined(GL_VERSION_4_3)
+#	define SUPPORT_OPENGL_COPY_IMAGE 1
+#else
+#	define SUPPORT_OPENGL_COPY_IMAGE 0
+#endif
+
+// ^CX^ṽNG(glQueryCounter)́Awb_ɒ`ꍇ̂ݑΉƂB
+// sɂ isGLTimerQuerySupported ŊmF邱
+#if SUPPORT_OPENGL_SHADER_OPS && defined(GL_TIMESTAMP)
+#	define SUPPORT_OPENGL_TIMER_QUERY 1
+#else
+#	define SUPPORT_OPENGL_TIMER_QUERY 0
+#endif
+
+// LReLXg[J[Xbh(GLWorker)́AtFX(glFenceSync)wb_ɂA
+// LReLXg̍쐬@ĂvbgtH[(WGLECGLEEGL/GLX)̂ݑΉƂ
+#if SUPPORT_OPENGL_SHADER_OPS && defined(GL_SYNC_GPU_COMMANDS_COMPLETE) && (UNITY_WIN || UNITY_OSX || UNITY_LINUX)
+#	define SUPPORT_OPENGL_WORKER 1
+#else
+#	define SUPPORT_OPENGL_WORKER 0
+#endif
+
+
+/** UnitynꂽlCeBueNX`|C^AGL̃eNX`ɕϊ */
+static inline GLuint toGLTex(void* nativeTex) { return (GLuint)(size_t)nativeTex; }
+
+
+#if SUPPORT_OPENGL_SHADER_OPS
+
+/** ݂APIʂɍ킹GLSL̃o[W錾Ԃ */
+const char* getGLSLHeader(UnityGfxRenderer apiType);
+
+/**
+ * _EtOgVF[_̃\[XvO쐬B
+ * \[X͂ꂼꕡ̕ÂƂĈBs0Ԃ
+ */
+GLuint createGLProgram(
+	const char* const* vsSrcs, int vsSrcCnt,
+	const char* const* fsSrcs, int fsSrcCnt
+);
+
+#if SUPPORT_OPENGL_COMPUTE
+
+/** ݂̃ReLXgŃRs[gVF[_gp\(GL4.3ȏ / ES3.1ȏ)Ԃ */
+bool isGLComputeSupported(UnityGfxRenderer apiType);
+
+/** ݂APIʂɍ킹ARs[gVF[_pGLSL̃o[W錾Ԃ */
+const char* getGLSLComputeHeader(UnityGfxRenderer apiType);
+
+/** Rs[gVF[_̃\[XvO쐬Bs0Ԃ */
+GLuint createGLComputeProgram(const char* const* srcs, int srcCnt);
+
+#endif // #if SUPPORT_OPENGL_COMPUTE
+
+#if SUPPORT_OPENGL_TEXTURE_STORAGE
+
+/** ݂̃ReLXg glTexStorage2D gp\(GL4.2ȏ / ES3.0ȏ)Ԃ */
+bool isGLTextureStorageSupported(UnityGfxRenderer apiType);
+
+#if SUPPORT_OPENGL_TEXTURE_VIEW
+/** ݂̃ReLXg glTextureView gp\(GL4.3ȏBES͊g̊֐قȂ̂ŔΉ)Ԃ */
+bool isGLTextureViewSupported(UnityGfxRenderer apiType);
+#endif
+
+#endif // #if SUPPORT_OPENGL_TEXTURE_STORAGE
+
+#if SUPPORT_OPENGL_COPY_IMAGE
+/** ݂̃ReLXg glCopyImageSubData gp\(GL4.3ȏBES͊g̊֐قȂ̂ŔΉ)Ԃ */
+bool isGLCopyImageSupported(UnityGfxRenderer apiType);
+#endif
+
+#if SUPPORT_OPENGL_TIMER_QUERY
+/** ݂̃ReLXgŃ^CX^ṽNGgp\(GL3.3ȏBES͊g̊֐قȂ̂ŔΉ)Ԃ */
+bool isGLTimerQuerySupported(UnityGfxRenderer apiType);
+#endif
+
+/** gl_VertexIDSʎOp`o͂钸_VF[_Bo͂vUV(0~1) */
+extern const char* const kGLSLFullscreenVS;
+
+/** xNgƖʁEe@̕ϊsGLSL֐QBCubeMath.hƓ` */
+extern const char* const kGLSLCubeMath;
+
+
+/**
+ * VF[_ɂ`揈̑OGL̃Xe[gۑEA邽߂̃XR[vB
+ * UnitỹXe[g󂳂Ȃ悤ɁAvOCŕύXׂ̂đޔĂB
+ * Corȅꍇ́Aʂ܂oCjA𐳂s߂ɃXR[v̂݃V[XȃL[u}bvTvOLɂ
+ * (ES3.0ȍ~͏ɗL)
+ */
+class GLStateScope
+{
+public:
+	explicit GLStateScope(UnityGfxRenderer apiType = kUnityGfxRendererNull);
+	~GLStateScope();
+
+private:
+	GLint _viewport[4];
+	GLint _drawFBO, _readFBO;
+	GLint _program;
+	GLint _vao;
+	GLint _activeTex;
+	GLint _tex2D, _texCube;
+	GLint _sampler;
+	GLboolean _depthTest, _blend, _cullFace, _scissorTest, _stencilTest;
+	GLboolean _colorMask[4];
+	bool _isCore;
+	GLboolean _seamlessCubemap;
+};
+
+#endif // #if SUPPORT_OPENGL_SHADER_OPS
+
+
+#endif // #if SUPPORT_OPENGL_UNIFIED
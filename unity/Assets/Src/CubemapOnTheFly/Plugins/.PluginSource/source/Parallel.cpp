@@ -0,0 +1,469 @@
+#include "Parallel.h"
+#include "PlatformBase.h"
+#include "Tracer.h"
+
+#if !UNITY_WEBGL
+#	define PARALLEL_HAS_THREADS 1
+#	include <thread>
+#	include <mutex>
+#	include <condition_variable>
+#	include <deque>
+#	include <memory>
+#endif
+
+#if UNITY_WIN
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif UNITY_LINUX || UNITY_ANDROID
+#	include <sched.h>
+#endif
+
+
+// --------------------------------------------------------------------------
+// [NXeB[ÕXbhv[
+
+#if PARALLEL_HAS_THREADS
+namespace {
+
+/** v[Ŏs1̏ */
+struct Task
+{
+	std::function<void()> fn;
+	std::atomic<int>* pendingCnt;	//!< 1炷JE^
+};
+
+/** [J[Ƃ̏L[B͖Ã[J[͐擪o */
+struct WorkerQueue
+{
+	std::mutex mutex;
+	std::deque<Task> tasks;
+};
+
+class ThreadPool
+{
+public:
+	ThreadPool(int workerCount, bool pinThreads);
+	~ThreadPool();
+
+	int workerCount() const { return (int)_threads.size(); }
+
+	/** ǉB[J[̏ꍇ͎̃L[ցAȊO͏Ɋe[J[̃L[֐U蕪 */
+	void submit(const Task& task);
+
+	/** pendingCnt0ɂȂ܂ŁȀ`Ȃ҂ */
+	void wait(std::atomic<int>& pendingCnt);
+
+private:
+	std::vector<WorkerQueue*> _queues;
+	std::vector<std::thread> _threads;
+	std::mutex _sleepMutex;
+	std::condition_variable _wakeCv;
+	std::atomic<int> _queuedCnt;		//!< L[ɓĂāA܂oĂȂ̐
+	std::atomic<unsigned> _nextQueue;
+	bool _isStopping;
+	const bool _pinThreads;
+
+	int selfIndex() const;
+	bool tryRunOne(int self);
+	void workerMain(int idx);
+
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+};
+
+thread_local ThreadPool* t_pool = NULL;		//!< ݂̃Xbh[J[Ƃđv[
+thread_local int t_workerIdx = -1;
+thread_local unsigned t_random = 0;
+
+/** ݂ɍs[J[IԂ߂̊Ȉ՗ */
+unsigned nextRandom()
+{
+	if (t_random == 0) t_random = (unsigned)(size_t)&t_random | 1;
+	t_random ^= t_random << 13;
+	t_random ^= t_random >> 17;
+	t_random ^= t_random << 5;
+	return t_random;
+}
+
+/** ݂̃Xbh_RA֌Œ肷BΉ̊ł͉Ȃ */
+void pinCurrentThread(int cpu)
+{
+#if UNITY_WIN
+	// 64𒴂_RA̓vZbTO[vɕĂ̂ŁAʂԍO[vƃO[v̔ԍ߂
+	const WORD groupCnt = GetActiveProcessorGroupCount();
+	int total = 0;
+	for (WORD g=0; g<groupCnt; ++g) total += (int)GetActiveProcessorCount(g);
+	if (total <= 0) return;
+
+	int idx = cpu % total;
+	for (WORD g=0; g<groupCnt; ++g) {
+		const int n = (int)GetActiveProcessorCount(g);
+		if (n <= idx) { idx -= n; continue; }
+		GROUP_AFFINITY affinity = {};
+		affinity.Group = g;
+		affinity.Mask = (KAFFINITY)1 << idx;
+		SetThreadGroupAffinity(GetCurrentThread(), &affinity, NULL);
+		return;
+	}
+#elif UNITY_LINUX || UNITY_ANDROID
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu % CPU_SETSIZE, &set);
+	sched_setaffinity(0, sizeof(set), &set);
+#else
+	(void)cpu;
+#endif
+}
+
+
+ThreadPool::ThreadPool(int workerCount, bool pinThreads) :
+	_queuedCnt(0),
+	_nextQueue(0),
+	_isStopping(false),
+	_pinThreads(pinThreads)
+{
+	_queues.resize(workerCount);
+	for (int i=0; i<workerCount; ++i) _queues[i] = new WorkerQueue();
+
+	_threads.reserve(workerCount);
+	for (int i=0; i<workerCount; ++i) _threads.emplace_back( [this, i]() { workerMain(i); } );
+}
+
+ThreadPool::~ThreadPool()
+{
+	// [J[̓L[ɎcĂ鏈ׂĎsĂI
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_isStopping = true;
+	}
+	_wakeCv.notify_all();
+	for (size_t i=0; i<_threads.size(); ++i) _threads[i].join();
+	for (size_t i=0; i<_queues.size(); ++i) delete _queues[i];
+}
+
+int ThreadPool::selfIndex() const
+{
+	return t_pool == this ? t_workerIdx : -1;
+}
+
+void ThreadPool::submit(const Task& task)
+{
+	const int self = selfIndex();
+	const int q = 0 <= self ? self : (int)( _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size() );
+	{
+		std::lock_guard<std::mutex> lock(_queues[q]->mutex);
+		_queues[q]->tasks.push_back(task);
+	}
+	_queuedCnt.fetch_add(1, std::memory_order_release);
+
+	// 낤ƂĂ郏[J[N˂Ȃ悤ɁAҋ@p̃bNoRĒʒm
+	{ std::lock_guard<std::mutex> lock(_sleepMutex); }
+	_wakeCv.notify_one();
+}
+
+void ThreadPool::wait(std::atomic<int>& pendingCnt)
+{
+	const int self = selfIndex();
+	while (0 < pendingCnt.load(std::memory_order_acquire)) {
+		if (!tryRunOne(self)) std::this_thread::yield();
+	}
+}
+
+bool ThreadPool::tryRunOne(int self)
+{
+	Task task;
+	bool isFound = false;
+	bool isOwnTask = false;
+
+	// ̃L[́AOɒǉ̂珈
+	if (0 <= self) {
+		WorkerQueue& q = *_queues[self];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (!q.tasks.empty()) {
+			task = q.tasks.back();
+			q.tasks.pop_back();
+			isFound = true;
+			isOwnTask = true;
+		}
+	}
+
+	// Α̃[J[̃L[̐擪瓐ށBRAœL[ɏWȂ悤ɊJnʒu΂炷
+	if (!isFound && 0 < _queuedCnt.load(std::memory_order_acquire)) {
+		const int n = (int)_queues.size();
+		const int start = (int)(nextRandom() % n);
+		for (int i=0; i<n && !isFound; ++i) {
+			const int qi = (start + i) % n;
+			if (qi == self) continue;
+			WorkerQueue& q = *_queues[qi];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (!q.tasks.empty()) {
+				task = q.tasks.front();
+				q.tasks.pop_front();
+				isFound = true;
+			}
+		}
+	}
+	if (!isFound) return false;
+
+	_queuedCnt.fetch_sub(1, std::memory_order_relaxed);
+	{
+		TraceScope trace("ParallelTask", TraceArg("worker", self), TraceArg("isStolen", isOwnTask ? 0 : 1));
+		task.fn();
+	}
+	task.pendingCnt->fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+void ThreadPool::workerMain(int idx)
+{
+	t_pool = this;
+	t_workerIdx = idx;
+	setTraceThreadName("CubemapBuilderPlugin Worker");
+	if (_pinThreads) pinCurrentThread(idx);
+
+	for (;;) {
+		// AĒǉꍇɔāAOɏ҂
+		bool isRan = false;
+		for (int spin=0; spin<64 && !isRan; ++spin) {
+			isRan = tryRunOne(idx);
+			if (!isRan) std::this_thread::yield();
+		}
+		if (isRan) continue;
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_wakeCv.wait( lock, [this]() {
+			return _isStopping || 0 < _queuedCnt.load(std::memory_order_acquire);
+		} );
+		if (_isStopping && _queuedCnt.load(std::memory_order_acquire) == 0) return;
+	}
+}
+
+
+/**
+ * ݂̃v[Bgp鑤 getPool ŎQƂ𓾂āAI܂ŕێB
+ * ݒ̕ύXIłOĂAŌ̎QƂO܂ł͔jȂ
+ */
+std::mutex s_poolMutex;
+std::shared_ptr<ThreadPool> s_pool;
+int s_workerCount = 0;		//!< 0ȉ̏ꍇ _RA - 1
+bool s_pinThreads = false;
+
+/** v[ԂB[J[1Ȃݒ̏ꍇNULL */
+std::shared_ptr<ThreadPool> getPool()
+{
+	std::lock_guard<std::mutex> lock(s_poolMutex);
+	if (s_pool) return s_pool;
+
+	int n = s_workerCount;
+	if (n <= 0) n = (int)std::thread::hardware_concurrency() - 1;
+	if (n <= 0) return std::shared_ptr<ThreadPool>();
+
+	s_pool = std::make_shared<ThreadPool>(n, s_pinThreads);
+	return s_pool;
+}
+
+}	// namespace
+#endif
+
+
+int getParallelThreadCount()
+{
+#if PARALLEL_HAS_THREADS
+	std::shared_ptr<ThreadPool> pool = getPool();
+	return pool ? pool->workerCount() + 1 : 1;
+#else
+	return 1;
+#endif
+}
+
+bool configureParallel(int workerCount, bool pinThreads)
+{
+#if PARALLEL_HAS_THREADS
+	std::shared_ptr<ThreadPool> oldPool;
+	{
+		// ȊO̎QƂ́As̕񏈗ێĂ
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		if (s_pool && 1 < s_pool.use_count()) return false;
+		s_workerCount = workerCount;
+		s_pinThreads = pinThreads;
+		oldPool.swap(s_pool);
+	}
+	// [J[̏I̓bN̊Oő҂
+	oldPool.reset();
+	return true;
+#else
+	(void)workerCount;
+	(void)pinThreads;
+	return true;
+#endif
+}
+
+void shutdownParallel()
+{
+#if PARALLEL_HAS_THREADS
+	std::shared_ptr<ThreadPool> oldPool;
+	{
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		oldPool.swap(s_pool);
+	}
+	// s̕񏈗΁A̍Ō̎QƂOꂽ_Ŕj
+	oldPool.reset();
+#endif
+}
+
+
+// --------------------------------------------------------------------------
+// 񃋁[v
+
+
+void parallelFor(int count, const std::function<void(int begin, int end)>& body)
+{
+	if (count <= 0) return;
+
+#if PARALLEL_HAS_THREADS
+	std::shared_ptr<ThreadPool> pool;
+	if (2 <= count) pool = getPool();
+	if (pool) {
+		// ԂƂׂ̕ɕ΂肪Ă󂢂Xbh߂悤ɁAXbhׂ
+		int chunkCnt = (pool->workerCount() + 1) * 4;
+		if (count < chunkCnt) chunkCnt = count;
+
+		// 擪̋Ԃ͌ĂяoXbhŏ
+		std::atomic<int> pendingCnt(chunkCnt - 1);
+		for (int i=1; i<chunkCnt; ++i) {
+			const int begin = (int)( (long long)count * i / chunkCnt );
+			const int end = (int)( (long long)count * (i+1) / chunkCnt );
+			Task task = { [&body, begin, end]() { body(begin, end); }, &pendingCnt };
+			pool->submit(task);
+		}
+		body( 0, (int)( (long long)count / chunkCnt ) );
+		pool->wait(pendingCnt);
+		return;
+	}
+#endif
+
+	body(0, count);
+}
+
+void parallelForCubemapTiles(int size, int mipCount, int tileSize, const std::function<void(const CubemapTile&)>& body)
+{
+	if (size <= 0 || mipCount <= 0 || tileSize <= 0) return;
+
+	std::vector<CubemapTile> tiles;
+	for (int level=0; level<mipCount; ++level) {
+		int levelSize = size >> level;
+		if (levelSize < 1) levelSize = 1;
+		for (int face=0; face<6; ++face)
+		for (int y=0; y<levelSize; y+=tileSize)
+		for (int x=0; x<levelSize; x+=tileSize) {
+			CubemapTile t;
+			t.level = level;
+			t.face = face;
+			t.x = x;
+			t.y = y;
+			t.width = levelSize - x < tileSize ? levelSize - x : tileSize;
+			t.height = levelSize - y < tileSize ? levelSize - y : tileSize;
+			tiles.push_back(t);
+		}
+	}
+
+	parallelFor( (int)tiles.size(), [&](int begin, int end) {
+		for (int i=begin; i<end; ++i) body(tiles[i]);
+	} );
+}
+
+
+// --------------------------------------------------------------------------
+// TaskGraph
+
+
+TaskGraph::TaskGraph() {}
+
+TaskGraph::~TaskGraph()
+{
+	clear();
+}
+
+int TaskGraph::add(const std::function<void()>& fn)
+{
+	Node* node = new Node();
+	node->fn = fn;
+	node->dependencyCount = 0;
+	node->remaining = 0;
+	_nodes.push_back(node);
+	return (int)_nodes.size() - 1;
+}
+
+void TaskGraph::addDependency(int task, int prerequisite)
+{
+	const int n = (int)_nodes.size();
+	if (task < 0 || n <= task || prerequisite < 0 || n <= prerequisite) return;
+
+	_nodes[prerequisite]->successors.push_back(task);
+	++_nodes[task]->dependencyCount;
+}
+
+void TaskGraph::clear()
+{
+	for (size_t i=0; i<_nodes.size(); ++i) delete _nodes[i];
+	_nodes.clear();
+}
+
+bool TaskGraph::run()
+{
+	// ˑ̖̂珇ɂǂāAzmFB̏̓XbhgȂꍇ̎sɂȂ
+	const int n = (int)_nodes.size();
+	std::vector<int> order;
+	std::vector<int> remaining(n);
+	order.reserve(n);
+	for (int i=0; i<n; ++i) {
+		remaining[i] = _nodes[i]->dependencyCount;
+		if (remaining[i] == 0) order.push_back(i);
+	}
+	for (size_t i=0; i<order.size(); ++i) {
+		const std::vector<int>& succ = _nodes[ order[i] ]->successors;
+		for (size_t j=0; j<succ.size(); ++j) if (--remaining[ succ[j] ] == 0) order.push_back(succ[j]);
+	}
+	if ((int)order.size() != n) return false;
+
+#if PARALLEL_HAS_THREADS
+	std::shared_ptr<ThreadPool> pool;
+	if (2 <= n) pool = getPool();
+	if (pool) {
+		std::atomic<int> pendingCnt(n);
+		ThreadPool* p = pool.get();
+		for (int i=0; i<n; ++i) _nodes[i]->remaining.store(_nodes[i]->dependencyCount, std::memory_order_relaxed);
+		for (int i=0; i<n; ++i) {
+			if (_nodes[i]->dependencyCount != 0) continue;
+			Task task = { [this, i, &pendingCnt, p]() { runNode(i, &pendingCnt, p); }, &pendingCnt };
+			pool->submit(task);
+		}
+		pool->wait(pendingCnt);
+		return true;
+	}
+#endif
+
+	for (int i=0; i<n; ++i) if (_nodes[ order[i] ]->fn) _nodes[ order[i] ]->fn();
+	return true;
+}
+
+void TaskGraph::runNode(int idx, std::atomic<int>* pendingCnt, void* poolPtr)
+{
+#if PARALLEL_HAS_THREADS
+	Node& node = *_nodes[idx];
+	if (node.fn) node.fn();
+
+	// Ō̈ˑƂĊ̂A㑱̏ run Ɠv[֒ǉ
+	ThreadPool* pool = static_cast<ThreadPool*>(poolPtr);
+	for (size_t i=0; i<node.successors.size(); ++i) {
+		const int s = node.successors[i];
+		if (_nodes[s]->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+		Task task = { [this, s, pendingCnt, pool]() { runNode(s, pendingCnt, pool); }, pendingCnt };
+		pool->submit(task);
+	}
+#else
+	(void)idx;
+	(void)pendingCnt;
+	(void)poolPtr;
+#endif
+}
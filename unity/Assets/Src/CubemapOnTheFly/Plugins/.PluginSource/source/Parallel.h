@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+//
+// CPŨsNZ𕡐XbhɕĎs邽߂̃[eBeBB
+// vOCێ郏[J[Xbh̃v[ŎsB
+// e[J[͎̃L[珈oAɂȂ瑼̃[J[̃L[瓐Ŏs([NXeB[O)B
+// ҂Xbh҂ĂԂ͏`̂ŁA񏈗̒Xɕ񏈗Ăł悢B
+// XbhĂȂ(WebGL)ł͌ĂяoXbhŏɎsB
+//
+
+
+/** ɎsłXbh([J[ + ĂяoXbh)ԂBXbhΉ̊ł1 */
+int getParallelThreadCount();
+
+/**
+ * [J[XbhƁAe[J[_RA֌Œ肷邩ۂݒ肷B
+ * workerCount0ȉ̏ꍇ _RA - 1BɃv[ꍇ́AL[ɎcĂ鏈sĂ蒼B
+ * 񏈗̎s͉ύXfalseԂ
+ */
+bool configureParallel(int workerCount, bool pinThreads);
+
+/**
+ * [J[XbhIB̕񏈗ŁAŌɐݒ肵eō蒼B
+ * 񏈗̎s̏ꍇ́ÅɏI
+ */
+void shutdownParallel();
+
+/**
+ * [0, count) ͈̔͂𕪊Ae [begin, end) ɑ΂ body ɌĂяoB
+ * ׂĂ̋Ԃ̏I܂Ŗ߂Ȃ
+ */
+void parallelFor(int count, const std::function<void(int begin, int end)>& body);
+
+
+/** parallelForCubemapTiles ŃL[u}bv𕪊ۂ̕W̃^C̑傫 */
+static const int kParallelTileSize = 64;
+
+/** parallelForCubemapTiles ŏAL[u}bv1~bvE1ʓ̋` */
+struct CubemapTile
+{
+	int level;
+	int face;
+	int x, y;
+	int width, height;
+};
+
+/**
+ * L[u}bv̑S~bvESʂtileSizel̃^CɕAe^Cɑ΂ body ɌĂяoB
+ * ʒPʂŏꍇtileSizesizeȏAŏʂ̃~bv̂ݏꍇmipCount1ƂB
+ * ׂẴ^C̏I܂Ŗ߂Ȃ
+ */
+void parallelForCubemapTiles(int size, int mipCount, int tileSize, const std::function<void(const CubemapTile&)>& body);
+
+
+/**
+ * ˑ֌Ŵ鏈̏W܂Bˑ悪ׂĊ珇ɁAv[ŕɎsB
+ *
+ *   TaskGraph g;
+ *   int a = g.add(...);
+ *   int b = g.add(...);
+ *   g.addDependency(b, a);		// båɎs
+ *   g.run();
+ */
+class TaskGraph
+{
+public:
+	TaskGraph();
+	~TaskGraph();
+
+	/** ǉA̔ԍԂ */
+	int add(const std::function<void()>& fn);
+
+	/** taskprerequisite̊Ɏs悤ɐݒ肷 */
+	void addDependency(int task, int prerequisite);
+
+	/** ׂĂ̏sA܂ő҂Bˑ֌WzĂꍇ͉sfalseԂ */
+	bool run();
+
+	/** ǉׂč폜 */
+	void clear();
+
+private:
+	struct Node
+	{
+		std::function<void()> fn;
+		std::vector<int> successors;
+		int dependencyCount;
+		std::atomic<int> remaining;		//!< śÄˑ̐
+	};
+	std::vector<Node*> _nodes;
+
+	/** poolPtr run ŎgpĂv[(XbhΉ̊ł͎gpȂ) */
+	void runNode(int idx, std::atomic<int>* pendingCnt, void* poolPtr);
+
+	TaskGraph(const TaskGraph&);
+	TaskGraph& operator=(const TaskGraph&);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>
+
+//
+// lCeBuňeNX`̃sNZ`B
+// C# CubemapOnTheFly.Plugin.PixelFormat Ɠlł邱ƁB
+//
+
+
+enum PixelFormat
+{
+	kPixelFormatRGBA8 = 0,		//!< RGBA e8bit UNORM
+	kPixelFormatRGBA8_SRGB,		//!< RGBA e8bit UNORMARGBsRGB
+	kPixelFormatRGBAHalf,		//!< RGBA e16bit float
+
+	kPixelFormatCount,
+};
+
+/** 1sNZ̃oCgԂBsȌ`̏ꍇ0 */
+static inline int pixelFormatBytes(int format) {
+	switch (format) {
+	case kPixelFormatRGBA8 :
+	case kPixelFormatRGBA8_SRGB : return 4;
+	case kPixelFormatRGBAHalf : return 8;
+	default : return 0;
+	}
+}
+
+/** L[u}bv1ʁE1~bvx̃oCgԂ */
+static inline size_t cubemapFaceBytes(int size, int level, int format) {
+	size_t levelSize = (size_t)( (size >> level) < 1 ? 1 : (size >> level) );
+	return levelSize * levelSize * pixelFormatBytes(format);
+}
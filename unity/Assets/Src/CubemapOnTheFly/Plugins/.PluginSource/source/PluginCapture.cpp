@@ -0,0 +1,120 @@
+#include "PluginCapture.h"
+#include "FileIO.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+
+std::atomic<bool> g_IsCapturing(false);
+
+
+namespace {
+
+/** ݂̃obt@̑傫BR[h͐\`S\oCgȂ̂ŁǍĂяoƂɏo */
+const size_t kWriteBufferBytes = 256 * 1024;
+
+/** ݂͌ĂяôтɍŝŁAt@Cւ̃ANZX͂̃bNŒ񉻂 */
+std::mutex s_CaptureMutex;
+FILE* s_CaptureFile = NULL;
+std::string s_CapturePath;
+uint64_t s_CaptureStartNs = 0;
+bool s_IsCaptureFailed = false;
+
+}	// namespace
+
+
+uint64_t pluginCaptureNowNs()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+CaptureTexture captureTexture(const void* handle, int kind, int width, int height, int format, int mipCount)
+{
+	CaptureTexture t;
+	memset(&t, 0, sizeof(t));
+	if (!handle) return t;
+
+	t.handle = (uint64_t)(size_t)handle;
+	t.width = (uint16_t)(width < 0 ? 0 : 0xFFFF < width ? 0xFFFF : width);
+	t.height = (uint16_t)(height < 0 ? 0 : 0xFFFF < height ? 0xFFFF : height);
+	t.kind = (uint8_t)kind;
+	t.format = (uint8_t)format;
+	t.mipCount = (uint8_t)(mipCount < 0 ? 0 : 0xFF < mipCount ? 0xFF : mipCount);
+	return t;
+}
+
+void writePluginCaptureRecord(int type, const void* payload, size_t payloadBytes, uint64_t beginNs, uint64_t endNs)
+{
+	std::lock_guard<std::mutex> lock(s_CaptureMutex);
+	// ~ɔĂXR[v͎̂̕Ă
+	if (!s_CaptureFile) return;
+
+	const uint64_t durationNs = beginNs < endNs ? endNs - beginNs : 0;
+	PluginCaptureRecordHeader h;
+	h.type = (uint16_t)type;
+	h.payloadBytes = (uint16_t)payloadBytes;
+	h.durationNs = (uint32_t)(0xFFFFFFFFull < durationNs ? 0xFFFFFFFFull : durationNs);
+	// JnOɌĂ΂ꂽXR[v́ALv`̊JnɎn܂̂Ƃ݂Ȃ
+	h.beginNs = s_CaptureStartNs < beginNs ? beginNs - s_CaptureStartNs : 0;
+
+	if (fwrite(&h, sizeof(h), 1, s_CaptureFile) != 1 ||
+		(0 < payloadBytes && fwrite(payload, payloadBytes, 1, s_CaptureFile) != 1))
+	{
+		s_IsCaptureFailed = true;
+	}
+}
+
+bool startPluginCapture(const char* path, int renderer)
+{
+	if (!path) return false;
+
+	std::lock_guard<std::mutex> lock(s_CaptureMutex);
+	if (s_CaptureFile) return false;
+
+	// ݓr̃t@CȂ悤ɁAꎞt@C֏Ē~ɍւ
+	s_CapturePath = path;
+	const std::string tmpPath = s_CapturePath + ".tmp";
+	FILE* fp = openFileUtf8(tmpPath.c_str(), "wb");
+	if (!fp) return false;
+	setvbuf(fp, NULL, _IOFBF, kWriteBufferBytes);
+
+	PluginCaptureFileHeader h;
+	h.magic = kPluginCaptureMagic;
+	h.version = kPluginCaptureVersion;
+	h.renderer = (uint32_t)renderer;
+	h.reserved = 0;
+	if (fwrite(&h, sizeof(h), 1, fp) != 1) {
+		fclose(fp);
+		removeFileUtf8(tmpPath.c_str());
+		return false;
+	}
+
+	s_CaptureFile = fp;
+	s_CaptureStartNs = pluginCaptureNowNs();
+	s_IsCaptureFailed = false;
+	g_IsCapturing.store(true, std::memory_order_release);
+	return true;
+}
+
+bool stopPluginCapture()
+{
+	std::lock_guard<std::mutex> lock(s_CaptureMutex);
+	if (!s_CaptureFile) return false;
+
+	g_IsCapturing.store(false, std::memory_order_release);
+	bool isSucceeded = !s_IsCaptureFailed && ferror(s_CaptureFile) == 0;
+	isSucceeded = fclose(s_CaptureFile) == 0 && isSucceeded;
+	s_CaptureFile = NULL;
+
+	const std::string tmpPath = s_CapturePath + ".tmp";
+	if (!isSucceeded || !replaceFileUtf8(tmpPath.c_str(), s_CapturePath.c_str())) {
+		removeFileUtf8(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
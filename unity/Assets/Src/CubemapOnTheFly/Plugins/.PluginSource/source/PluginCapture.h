@@ -0,0 +1,288 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+//
+// vOČĂяoAEeNX`̏EƂƂɃoCĩO֋L^ACӂŗLɂLv`B
+// L^O tools/PluginReplay œǂݍ݁ÃeNX`蒼GPŮłĐłB
+// eĂяo PluginCaptureScope ň͂ނƁAI1R[ht@C֒ǋLBLłȂԂׂ͕̕1̂݁B
+// eNX`̓eAzXgobt@̓e͋L^Ȃ(Đ͓傫̃_~[g)B
+// L̃Oւ̌Jƃrh̃tFX́AvZXEĂяoƂ݂̓̂Ȃ̂ŋL^ȂB
+//
+// t@C̍\(gGfBA)
+//   PluginCaptureFileHeader
+//   { PluginCaptureRecordHeader, yC[h(payloadBytes) } ̌JԂBR[h͌ĂяȍI
+//
+//   PluginCaptureScope<CaptureBlurCubemap> capture(kCaptureRecordBlurCubemap);
+//   if (capture.isActive()) { capture.payload.size = size; ... }
+//
+
+
+/** t@C擪̎ʎq "CPCP" */
+static const uint32_t kPluginCaptureMagic = 0x50435043;
+/** `̃o[WBR[h̃CAEgςグ */
+static const uint32_t kPluginCaptureVersion = 2;
+
+
+/** R[h̎ */
+enum PluginCaptureRecordType
+{
+	kCaptureRecordBlitCubemap = 1,				//!< CaptureBlitCubemapBEnqueueBlitCubemap ŒǉĎsꂽ̂܂
+	kCaptureRecordConvertCubemapToProjection,	//!< CaptureConvertCubemapToProjection
+	kCaptureRecordConvertProjectionToCubemap,	//!< CaptureConvertProjectionToCubemap
+	kCaptureRecordConvertCubemapToProjectionCPU,//!< CaptureCpuOp (size, width, height, projection)
+	kCaptureRecordConvertProjectionToCubemapCPU,//!< CaptureCpuOp (size, width, height, projection)
+	kCaptureRecordRotateCubemap,				//!< CaptureRotateCubemap
+	kCaptureRecordRotateCubemapCPU,				//!< CaptureCpuOp (size, isInPlace, rotation)
+	kCaptureRecordFixupCubemapSeams,			//!< CaptureFixupCubemapSeams
+	kCaptureRecordFixupCubemapSeamsCPU,			//!< CaptureCpuOp (size)
+	kCaptureRecordBlurCubemap,					//!< CaptureBlurCubemap
+	kCaptureRecordBlurCubemapCPU,				//!< CaptureCpuOp (size, isInPlace, sigma)
+	kCaptureRecordComputeLuminanceStats,		//!< CaptureComputeLuminanceStats
+	kCaptureRecordGetLuminanceStats,			//!< yC[hȂ
+	kCaptureRecordComputeLuminanceStatsCPU,		//!< CaptureCpuOp (size, isSRGB, minLog2Lum, maxLog2Lum)
+	kCaptureRecordWriteKTX2Cubemap,				//!< CaptureWriteKTX2Cubemap
+	kCaptureRecordLoadKTX2CubemapLevels,		//!< CaptureLoadKTX2CubemapLevels
+	kCaptureRecordCreateCubemap,				//!< CaptureCreateCubemap
+	kCaptureRecordDestroyCubemap,				//!< CaptureDestroyTexture
+	kCaptureRecordCreateCubemapFaceViews,		//!< CaptureCreateCubemapFaceViews
+	kCaptureRecordDestroyTextureView,			//!< CaptureDestroyTexture
+
+	kCaptureRecordTypeCount
+};
+
+/** L^eNX`̎ */
+enum CaptureTextureKind
+{
+	kCaptureTextureNone,
+	kCaptureTexture2D,
+	kCaptureTextureCube,
+};
+
+
+#pragma pack(push, 1)
+
+struct PluginCaptureFileHeader
+{
+	uint32_t magic;				//!< kPluginCaptureMagic
+	uint32_t version;			//!< kPluginCaptureVersion
+	uint32_t renderer;			//!< L^ UnityGfxRenderer
+	uint32_t reserved;
+};
+
+struct PluginCaptureRecordHeader
+{
+	uint16_t type;				//!< PluginCaptureRecordType
+	uint16_t payloadBytes;
+	uint32_t durationNs;		//!< Ăяȍv(CPU)B4.29bœł
+	uint64_t beginNs;			//!< Lv`JňĂяo̊Jn
+};
+
+/**
+ * ĂяoɓnꂽeNX`Bhandle͋L^̃lCeBueNX`ŁAĐɓnh𓯂eNX`֑ΉtB
+ * 傫E~bvE`́A擾łꍇ͎ۂ̃eNX`̒lŁA擾łȂꍇ͌Ăяö猩ς́B
+ * mipCount0̏ꍇ͕s
+ */
+struct CaptureTexture
+{
+	uint64_t handle;
+	uint16_t width;
+	uint16_t height;
+	uint8_t kind;				//!< CaptureTextureKind
+	uint8_t format;				//!< PixelFormatBUnity쐬eNX` kPixelFormatRGBA8 Ƃ݂Ȃ
+	uint8_t mipCount;
+	uint8_t reserved;
+};
+
+struct CaptureBlitCubemap
+{
+	CaptureTexture src[6];
+	CaptureTexture dst;
+	int32_t size;
+	int32_t reserved;
+};
+
+struct CaptureConvertCubemapToProjection
+{
+	CaptureTexture src;
+	CaptureTexture dst;
+	int32_t width;
+	int32_t height;
+	int32_t projection;
+	int32_t reserved;
+};
+
+struct CaptureConvertProjectionToCubemap
+{
+	CaptureTexture src;
+	CaptureTexture dst;
+	int32_t size;
+	int32_t projection;
+};
+
+struct CaptureRotateCubemap
+{
+	CaptureTexture src;
+	CaptureTexture dst;
+	int32_t size;
+	float rotation[9];
+};
+
+struct CaptureFixupCubemapSeams
+{
+	CaptureTexture tex;
+	int32_t size;
+	int32_t mipCount;
+};
+
+struct CaptureBlurCubemap
+{
+	CaptureTexture src;
+	CaptureTexture dst;
+	int32_t size;
+	float sigma;
+};
+
+struct CaptureComputeLuminanceStats
+{
+	CaptureTexture tex;
+	int32_t size;
+	float minLog2Lum;
+	float maxLog2Lum;
+	int32_t reserved;
+};
+
+/** zXgobt@ɑ΂CPUBgp郁o̓R[h̎ނƂɈقȂAgp̂̂0 */
+struct CaptureCpuOp
+{
+	int32_t size;				//!< L[u}bv1
+	int32_t width;				//!< e@2D摜̕
+	int32_t height;				//!< e@2D摜̍
+	int32_t projection;
+	int32_t isInPlace;			//!< srcdstobt@ۂ
+	int32_t isSRGB;				//!< RGBsRGBƂĈۂ
+	float sigma;
+	float minLog2Lum;
+	float maxLog2Lum;
+	float rotation[9];
+};
+
+struct CaptureWriteKTX2Cubemap
+{
+	int32_t size;
+	int32_t mipCount;
+	int32_t format;
+	int32_t reserved;
+};
+
+/** levelCount͉ς݂̒iBt@C̑傫E~bvE`͍Đɓ`̃t@C邽߂̂ */
+struct CaptureLoadKTX2CubemapLevels
+{
+	CaptureTexture dst;
+	int32_t fileSize;
+	int32_t fileMipCount;
+	int32_t fileFormat;
+	int32_t firstLevel;
+	int32_t levelCount;
+	int32_t dstFirstLevel;
+};
+
+struct CaptureCreateCubemap
+{
+	int32_t size;
+	int32_t mipCount;
+	int32_t format;
+	int32_t reserved;
+	uint64_t result;			//!< 쐬lCeBueNX`Bs0
+};
+
+struct CaptureDestroyTexture
+{
+	uint64_t handle;
+};
+
+struct CaptureCreateCubemapFaceViews
+{
+	CaptureTexture cubemap;
+	uint64_t results[6];		//!< 쐬r[Bs0
+};
+
+#pragma pack(pop)
+
+
+/** Lv`̋L^ۂBPluginCaptureScope QƂ̂ŁACCŔł悤ɌJĂ */
+extern std::atomic<bool> g_IsCapturing;
+
+static inline bool isCapturing() { return g_IsCapturing.load(std::memory_order_relaxed); }
+
+
+/**
+ * Lv`JnAt@Cւ݂̏n߂BpathUTF-8Brenderer͋L^ UnityGfxRendererB
+ * ɋL^̏ꍇt@C쐬łȂꍇfalse
+ */
+bool startPluginCapture(const char* path, int renderer);
+
+/** Lv`~ăt@CBL^łȂꍇ⏑݂ɎsĂꍇfalse */
+bool stopPluginCapture();
+
+/** 1R[ht@C֒ǋLBPluginCaptureScope ĂԁBCӂ̃XbhĂׂ */
+void writePluginCaptureRecord(int type, const void* payload, size_t payloadBytes, uint64_t beginNs, uint64_t endNs);
+
+/** L^p̃eNX`̏ */
+CaptureTexture captureTexture(const void* handle, int kind, int width, int height, int format, int mipCount);
+
+static inline CaptureTexture captureTexture2D(const void* handle, int width, int height)
+{
+	return captureTexture(handle, kCaptureTexture2D, width, height, 0, 1);
+}
+
+static inline CaptureTexture captureCubemap(const void* handle, int size, int mipCount = 0)
+{
+	return captureTexture(handle, kCaptureTextureCube, size, size, 0, mipCount);
+}
+
+/** Lv`p̌ݎ */
+uint64_t pluginCaptureNowNs();
+
+
+/**
+ * XR[v̊Ԃ̌Ăяo1R[hƂċL^BL^łȂꍇ͉ȂB
+ * yC[h isActive() ̏ꍇ̂ݐݒ肷΂悢
+ */
+template<typename Payload>
+class PluginCaptureScope
+{
+public:
+	explicit PluginCaptureScope(int type) : payload(), _type(type), _isActive(isCapturing()), _beginNs(0)
+	{
+		if (_isActive) _beginNs = pluginCaptureNowNs();
+	}
+
+	~PluginCaptureScope()
+	{
+		if (_isActive) writePluginCaptureRecord(_type, &payload, sizeof(Payload), _beginNs, pluginCaptureNowNs());
+	}
+
+	bool isActive() const { return _isActive; }
+
+	Payload payload;
+
+private:
+	int _type;
+	bool _isActive;
+	uint64_t _beginNs;
+
+	PluginCaptureScope(const PluginCaptureScope&);
+	PluginCaptureScope& operator=(const PluginCaptureScope&);
+};
+
+/** yC[hȂR[hp */
+struct CaptureEmpty {};
+
+template<>
+inline PluginCaptureScope<CaptureEmpty>::~PluginCaptureScope()
+{
+	if (_isActive) writePluginCaptureRecord(_type, NULL, 0, _beginNs, pluginCaptureNowNs());
+}
@@ -0,0 +1,325 @@
+#include "PluginStats.h"
+#include "ProfilerMarkers.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+static std::mutex s_StatsMutex;
+static PluginStats s_Stats;
+static bool s_IsGpuTimerSupported = false;
+
+
+// --------------------------------------------------------------------------
+// XbhƂ̏펞vl
+
+
+namespace {
+
+/**
+ * CPUԂ̃qXgŐ敪BnsPʂŁA641ns݁Aȍ~2̙pƂ͈̔͂32B
+ * ǂ̋敪[1/32ȉȂ̂ŁA敪̏[lƂꍇ̌덷͖3%Ɏ܂B68bȏ͍Ō̋敪ɓ
+ */
+const int kLatencySubBucketBits = 5;
+const int kLatencySubBucketHalf = 1 << kLatencySubBucketBits;
+const int kLatencyMaxBits = 36;
+const int kLatencyBucketCount = kLatencySubBucketHalf * 2 + (kLatencyMaxBits - kLatencySubBucketBits - 1) * kLatencySubBucketHalf;
+
+int latencyBucket(unsigned long long ns)
+{
+	if (ns < (unsigned long long)kLatencySubBucketHalf * 2) return (int)ns;
+
+	int msb = 0;
+	for (unsigned long long v=ns; 1<v; v>>=1) ++msb;
+	const int shift = msb - kLatencySubBucketBits;
+	const int idx = kLatencySubBucketHalf * 2 + (shift - 1) * kLatencySubBucketHalf + (int)(ns >> shift) - kLatencySubBucketHalf;
+	return idx < kLatencyBucketCount ? idx : kLatencyBucketCount - 1;
+}
+
+/** 敪ɓl̏[ */
+unsigned long long latencyBucketUpper(int idx)
+{
+	if (idx < kLatencySubBucketHalf * 2) return (unsigned long long)idx;
+
+	const int shift = (idx - kLatencySubBucketHalf * 2) / kLatencySubBucketHalf + 1;
+	const unsigned long long sub = (unsigned long long)((idx - kLatencySubBucketHalf * 2) % kLatencySubBucketHalf + kLatencySubBucketHalf);
+	return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * ނ͎̂̃Xbĥ݂Ȃ̂ŁAǂݏođl߂΂悢B
+ * Wv͓ɓǂނ̂ŁAlatomicŎ
+ */
+template<typename T>
+inline void addOwned(std::atomic<T>& a, T v) { a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed); }
+
+/** XbhƂ1̊֐̌vl */
+struct ThreadCallStats
+{
+	std::atomic<unsigned long long> count;
+	std::atomic<unsigned long long> failureCount;
+	std::atomic<unsigned long long> totalNs;
+	std::atomic<unsigned long long> maxNs;
+	std::atomic<unsigned> latency[kLatencyBucketCount];
+};
+
+/** XbhƂ̌vlBŏɌvƂɍ쐬āAXbh̏I s_RetiredStats ֍ZĔj */
+struct ThreadStats
+{
+	/**
+	 * ̗̈̒lǂ̃Zbgȍ~̂̂Bs_ResetGeneration ƈقȂꍇ́A
+	 * 傪ɏޑO0֖߂̂ŁAWv͓ǂݔ΂
+	 */
+	std::atomic<unsigned> generation;
+	std::atomic<unsigned long long> bytesMoved;
+	std::atomic<unsigned long long> fboValidationCount;
+	std::atomic<unsigned long long> fboValidationFailureCount;
+	ThreadCallStats calls[kPluginCallCount];
+
+	explicit ThreadStats(unsigned gen) { clear(gen); }
+
+	void clear(unsigned gen)
+	{
+		bytesMoved.store(0, std::memory_order_relaxed);
+		fboValidationCount.store(0, std::memory_order_relaxed);
+		fboValidationFailureCount.store(0, std::memory_order_relaxed);
+		for (int i=0; i<kPluginCallCount; ++i) {
+			ThreadCallStats& c = calls[i];
+			c.count.store(0, std::memory_order_relaxed);
+			c.failureCount.store(0, std::memory_order_relaxed);
+			c.totalNs.store(0, std::memory_order_relaxed);
+			c.maxNs.store(0, std::memory_order_relaxed);
+			for (int j=0; j<kLatencyBucketCount; ++j) c.latency[j].store(0, std::memory_order_relaxed);
+		}
+		generation.store(gen, std::memory_order_release);
+	}
+};
+
+/** SXbhvvl */
+struct AggregatedCallStats
+{
+	unsigned long long count;
+	unsigned long long failureCount;
+	unsigned long long totalNs;
+	unsigned long long maxNs;
+	unsigned long long latency[kLatencyBucketCount];
+};
+
+struct AggregatedStats
+{
+	unsigned long long bytesMoved;
+	unsigned long long fboValidationCount;
+	unsigned long long fboValidationFailureCount;
+	AggregatedCallStats calls[kPluginCallCount];
+
+	/** XbȟvlBオÂ̂0Ƃ݂Ȃ */
+	void add(const ThreadStats& t, unsigned gen)
+	{
+		if (t.generation.load(std::memory_order_acquire) != gen) return;
+
+		bytesMoved += t.bytesMoved.load(std::memory_order_relaxed);
+		fboValidationCount += t.fboValidationCount.load(std::memory_order_relaxed);
+		fboValidationFailureCount += t.fboValidationFailureCount.load(std::memory_order_relaxed);
+		for (int i=0; i<kPluginCallCount; ++i) {
+			const ThreadCallStats& src = t.calls[i];
+			AggregatedCallStats& dst = calls[i];
+			dst.count += src.count.load(std::memory_order_relaxed);
+			dst.failureCount += src.failureCount.load(std::memory_order_relaxed);
+			dst.totalNs += src.totalNs.load(std::memory_order_relaxed);
+			const unsigned long long maxNs = src.maxNs.load(std::memory_order_relaxed);
+			if (dst.maxNs < maxNs) dst.maxNs = maxNs;
+			if (src.count.load(std::memory_order_relaxed) == 0) continue;
+			for (int j=0; j<kLatencyBucketCount; ++j) dst.latency[j] += src.latency[j].load(std::memory_order_relaxed);
+		}
+	}
+};
+
+/** vqXgOAw芄̈ʒu̒l߂ */
+unsigned long long latencyPercentile(const AggregatedCallStats& c, double ratio)
+{
+	if (c.count == 0) return 0;
+
+	unsigned long long rank = (unsigned long long)(c.count * ratio);
+	if (rank < 1) rank = 1;
+	unsigned long long cumulative = 0;
+	for (int i=0; i<kLatencyBucketCount; ++i) {
+		cumulative += c.latency[i];
+		if (rank <= cumulative) {
+			const unsigned long long v = latencyBucketUpper(i);
+			return v < c.maxNs ? v : c.maxNs;
+		}
+	}
+	return c.maxNs;
+}
+
+/** s_ThreadStatsMutex ́AXbh̓o^EIƏWvɂ̂ݎBvl݂̏̓bNȂ */
+std::mutex s_ThreadStatsMutex;
+std::vector<ThreadStats*> s_ThreadStats;
+AggregatedStats s_RetiredStats;		//!< IXbȟvl̍v
+std::atomic<unsigned> s_ResetGeneration(1);
+
+/** Xbh̏IɁÃXbȟvl s_RetiredStats ֈڂ */
+struct ThreadStatsOwner
+{
+	ThreadStats* stats;
+
+	ThreadStatsOwner() : stats(NULL) {}
+	~ThreadStatsOwner()
+	{
+		if (!stats) return;
+
+		std::lock_guard<std::mutex> lock(s_ThreadStatsMutex);
+		s_RetiredStats.add(*stats, s_ResetGeneration.load(std::memory_order_relaxed));
+		for (size_t i=0; i<s_ThreadStats.size(); ++i) {
+			if (s_ThreadStats[i] != stats) continue;
+			s_ThreadStats[i] = s_ThreadStats.back();
+			s_ThreadStats.pop_back();
+			break;
+		}
+		delete stats;
+		stats = NULL;
+	}
+};
+thread_local ThreadStatsOwner t_statsOwner;
+
+/** ݂̃Xbh́AŐV̐̌vl̗̈Ԃ */
+ThreadStats* getThreadStats()
+{
+	const unsigned gen = s_ResetGeneration.load(std::memory_order_acquire);
+	ThreadStats* t = t_statsOwner.stats;
+	if (t) {
+		if (t->generation.load(std::memory_order_relaxed) != gen) t->clear(gen);
+		return t;
+	}
+
+	t = new ThreadStats(gen);
+	std::lock_guard<std::mutex> lock(s_ThreadStatsMutex);
+	s_ThreadStats.push_back(t);
+	t_statsOwner.stats = t;
+	return t;
+}
+
+}	// namespace
+
+
+void recordPluginCall(int call, unsigned long long ns, bool isSucceeded)
+{
+	if (call < 0 || kPluginCallCount <= call) return;
+
+	ThreadCallStats& c = getThreadStats()->calls[call];
+	addOwned(c.count, 1ull);
+	if (!isSucceeded) addOwned(c.failureCount, 1ull);
+	addOwned(c.totalNs, ns);
+	if (c.maxNs.load(std::memory_order_relaxed) < ns) c.maxNs.store(ns, std::memory_order_relaxed);
+	addOwned(c.latency[latencyBucket(ns)], 1u);
+}
+
+void recordBytesMoved(unsigned long long bytes)
+{
+	addOwned(getThreadStats()->bytesMoved, bytes);
+	addProfilerBytesCopied(bytes);
+}
+
+void recordFboValidation(bool isComplete)
+{
+	ThreadStats* t = getThreadStats();
+	addOwned(t->fboValidationCount, 1ull);
+	if (!isComplete) addOwned(t->fboValidationFailureCount, 1ull);
+}
+
+/** SXbȟvlvāAout ̒ǉ֏ */
+static void aggregateThreadStats(PluginStats* out)
+{
+	// vp̗̈͑傫̂ŁAX^bNɒuȂ
+	static AggregatedStats s_sum;
+
+	std::lock_guard<std::mutex> lock(s_ThreadStatsMutex);
+	const unsigned gen = s_ResetGeneration.load(std::memory_order_acquire);
+	s_sum = s_RetiredStats;
+	for (size_t i=0; i<s_ThreadStats.size(); ++i) s_sum.add(*s_ThreadStats[i], gen);
+
+	out->callCount = kPluginCallCount;
+	out->threadCount = (int)s_ThreadStats.size();
+	out->bytesMoved = s_sum.bytesMoved;
+	out->fboValidationCount = s_sum.fboValidationCount;
+	out->fboValidationFailureCount = s_sum.fboValidationFailureCount;
+	for (int i=0; i<kPluginCallCount; ++i) {
+		const AggregatedCallStats& src = s_sum.calls[i];
+		PluginCallStats& dst = out->calls[i];
+		dst.count = src.count;
+		dst.failureCount = src.failureCount;
+		dst.totalNs = src.totalNs;
+		dst.maxNs = src.maxNs;
+		dst.p50Ns = latencyPercentile(src, 0.5);
+		dst.p99Ns = latencyPercentile(src, 0.99);
+		dst.p999Ns = latencyPercentile(src, 0.999);
+	}
+}
+
+
+// --------------------------------------------------------------------------
+// Wvl̎擾
+
+
+int pluginStatsSizeBucket(int size)
+{
+	int bucket = 0;
+	for (int s=32; s<size && bucket<kPluginStatsSizeBucketCount-1; s<<=1) ++bucket;
+	return bucket;
+}
+
+void recordGpuTime(int op, int size, unsigned long long ns)
+{
+	if (op < 0 || kPluginOpCount <= op) return;
+
+	std::lock_guard<std::mutex> lock(s_StatsMutex);
+	PluginGpuTimeStats& t = s_Stats.gpuTime[op * kPluginStatsSizeBucketCount + pluginStatsSizeBucket(size)];
+	++t.count;
+	t.totalNs += ns;
+	if (t.maxNs < ns) t.maxNs = ns;
+	t.lastNs = ns;
+}
+
+void recordDroppedGpuTimer()
+{
+	std::lock_guard<std::mutex> lock(s_StatsMutex);
+	++s_Stats.gpuTimerDroppedCount;
+}
+
+void setGpuTimerSupported(bool isSupported)
+{
+	std::lock_guard<std::mutex> lock(s_StatsMutex);
+	s_IsGpuTimerSupported = isSupported;
+}
+
+bool getPluginStats(PluginStats* out)
+{
+	// 擪̃wb_疳̂́ACAEgȂ̂Ŏ󂯕tȂ
+	if (!out || out->structSize < (int)offsetof(PluginStats, gpuTimerDroppedCount)) return false;
+	const size_t size = (size_t)out->structSize < sizeof(PluginStats) ? (size_t)out->structSize : sizeof(PluginStats);
+
+	std::lock_guard<std::mutex> lock(s_StatsMutex);
+	s_Stats.structSize = (int)size;
+	s_Stats.opCount = kPluginOpCount;
+	s_Stats.sizeBucketCount = kPluginStatsSizeBucketCount;
+	s_Stats.isGpuTimerSupported = s_IsGpuTimerSupported ? 1 : 0;
+	if (offsetof(PluginStats, callCount) < size) aggregateThreadStats(&s_Stats);
+	memcpy(out, &s_Stats, size);
+	return true;
+}
+
+void resetPluginStats()
+{
+	{
+		std::lock_guard<std::mutex> lock(s_StatsMutex);
+		memset(&s_Stats, 0, sizeof(s_Stats));
+	}
+
+	// eXbḧ̗͎債߂Ȃ̂ŁAi߂ČÂlǂݔ΂悤ɂ
+	std::lock_guard<std::mutex> lock(s_ThreadStatsMutex);
+	memset(&s_RetiredStats, 0, sizeof(s_RetiredStats));
+	s_ResetGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Tracer.h"
+
+//
+// vOC̊ěvʂ̏WvB
+// GPUԂ̓obNGh̃^C}[NǦʂAǂݖ߂悤ɂȂ_ŏETCYƂɉZB
+// Wv͔Cӂ̃Xbhǂ߂悤ɁAbNčsB
+//
+// Ăяo񐔁ECPUԁE]ʂȂǂ̏펞vĺAĂяoXbhƂ̗̈փbN炸ɉZA
+// getPluginStats őSXbhvBCPUԂHDRqXgO(ΐ敪`ɍו)ŎA
+// 擾Ƀp[Z^C߂
+//
+//   PluginCallScope call(kPluginCallRotateCubemap);
+//   ...
+//   return call.result(api->rotateCubemap(...)) ? 1 : 0;
+//
+
+
+/** vΏۂ̃vOC̏BC# PluginStats.Op Ɠ */
+enum PluginOp
+{
+	kPluginOpBlitCubemap,
+	kPluginOpConvertCubemapToProjection,
+	kPluginOpConvertProjectionToCubemap,
+	kPluginOpRotateCubemap,
+	kPluginOpFixupCubemapSeams,
+	kPluginOpBlurCubemap,
+	kPluginOpComputeLuminanceStats,
+	kPluginOpUploadCubemapLevel,
+
+	kPluginOpCount
+};
+
+/** Ăяo񐔁ECPUԂvvOC̊֐BC# PluginStats.Call Ɠ */
+enum PluginCall
+{
+	kPluginCallBlitCubemap,					//!< EnqueueBlitCubemap ŒǉR}h̎s܂
+	kPluginCallEnqueueBlitCubemap,
+	kPluginCallConvertCubemapToProjection,
+	kPluginCallConvertProjectionToCubemap,
+	kPluginCallConvertCubemapToProjectionCPU,
+	kPluginCallConvertProjectionToCubemapCPU,
+	kPluginCallRotateCubemap,
+	kPluginCallRotateCubemapCPU,
+	kPluginCallFixupCubemapSeams,
+	kPluginCallFixupCubemapSeamsCPU,
+	kPluginCallBlurCubemap,
+	kPluginCallBlurCubemapCPU,
+	kPluginCallComputeLuminanceStats,
+	kPluginCallGetLuminanceStats,
+	kPluginCallComputeLuminanceStatsCPU,
+	kPluginCallWriteKTX2Cubemap,
+	kPluginCallLoadKTX2CubemapLevels,		//!< _[XbhE[J[Xbhł̓ǂݍ݂܂
+	kPluginCallCreateCubemap,
+	kPluginCallDestroyCubemap,
+	kPluginCallCreateCubemapFaceViews,
+	kPluginCallDestroyTextureView,
+	kPluginCallRenderEvent,
+	kPluginCallPublishCubemapFacesToSharedRing,
+	kPluginCallGetKTX2CubemapInfo,
+	kPluginCallCreateSharedFaceRing,
+	kPluginCallDestroySharedFaceRing,
+
+	kPluginCallCount
+};
+static_assert(kPluginCallCount == 26, "update PluginStats.CallCount on the C# side as well");
+
+/** eNX`̈ӂƂ̋敪B32ȉ, 64, 128, ... , 4096ȏ */
+static const int kPluginStatsSizeBucketCount = 8;
+
+/** 1̏ETCY敪GPU */
+struct PluginGpuTimeStats
+{
+	unsigned long long count;		//!< vł
+	unsigned long long totalNs;		//!< v
+	unsigned long long maxNs;		//!< ő厞
+	unsigned long long lastNs;		//!< ߂̎
+};
+
+/** 1̊֐̌ĂяȍWv */
+struct PluginCallStats
+{
+	unsigned long long count;			//!< Ăяo
+	unsigned long long failureCount;	//!< sԂ
+	unsigned long long totalNs;			//!< CPUԂ̍v
+	unsigned long long maxNs;			//!< CPUԂ̍ő
+	unsigned long long p50Ns;			//!< CPUԂ̃p[Z^CBqXgŐ敪̏[Ȃ̂ŁA3%傫߂ɂȂ
+	unsigned long long p99Ns;
+	unsigned long long p999Ns;
+};
+
+/** vOČvʁBC# PluginStats ƓCAEg */
+struct PluginStats
+{
+	int structSize;						//!< Ăяo sizeof(PluginStats) ݒ肷Bނ̂͂̑傫܂
+	int opCount;						//!< kPluginOpCount
+	int sizeBucketCount;				//!< kPluginStatsSizeBucketCount
+	int isGpuTimerSupported;			//!< ݂̃OtBbNXAPIGPUԂvł邩ۂ
+	unsigned long long gpuTimerDroppedCount;	//!< v҂̃NGāAvłȂ
+	PluginGpuTimeStats gpuTime[kPluginOpCount * kPluginStatsSizeBucketCount];	//!< [op * sizeBucketCount + sizeBucket]
+
+	// ȍ~͌ォǉ́BstructSize ܂œ͂ȂĂяoɂ͏܂Ȃ
+	int callCount;								//!< kPluginCallCount
+	int threadCount;							//!< vlĂ鐶̃Xbh
+	unsigned long long bytesMoved;				//!< GPUւ̓]EGPŨRs[Eǂݖ߂ELւ݂̏̃oCg
+	unsigned long long fboValidationCount;		//!< t[obt@̊SmF
+	unsigned long long fboValidationFailureCount;	//!< t[obt@sSŁARs[sȂ
+	PluginCallStats calls[kPluginCallCount];
+};
+
+
+/** eNX`̈ӂATCY敪Ԃ */
+int pluginStatsSizeBucket(int size);
+
+/** ǂݖ߂GPUԂZ */
+void recordGpuTime(int op, int size, unsigned long long ns);
+
+/** v҂̃NGāAvłȂƂL^ */
+void recordDroppedGpuTimer();
+
+/** ݂̃OtBbNXAPIGPUԂvł邩ۂݒ肷 */
+void setGpuTimerSupported(bool isSupported);
+
+/** vʂ擾Bout->structSize ꍇ́Ȃ傫܂łށBsȏꍇfalse */
+bool getPluginStats(PluginStats* out);
+
+/** vʂׂ0ɖ߂ */
+void resetPluginStats();
+
+/** ֐̌Ăяo1񕪂Ã݂Xbḧ̗։ZBPluginCallScope Ă */
+void recordPluginCall(int call, unsigned long long ns, bool isSucceeded);
+
+/** ]ERs[oCgZBUnitỹvt@C̃JE^ւZ */
+void recordBytesMoved(unsigned long long bytes);
+
+/** t[obt@̊S̊mFʂZ */
+void recordFboValidation(bool isComplete);
+
+
+/** XR[v̊ԂCPUԂA֐̌Ăяo1񕪂ƂČvBresult Őݒ肵Ȃꍇ͎sƂĐ */
+class PluginCallScope
+{
+public:
+	explicit PluginCallScope(int call) : _call(call), _isSucceeded(false), _beginNs(traceNowNs()) {}
+	~PluginCallScope() { recordPluginCall(_call, traceNowNs() - _beginNs, _isSucceeded); }
+
+	/** Ăяo̐ۂݒ肵āÂ܂ܕԂ */
+	bool result(bool isSucceeded)
+	{
+		_isSucceeded = isSucceeded;
+		return isSucceeded;
+	}
+
+private:
+	int _call;
+	bool _isSucceeded;
+	unsigned long long _beginNs;
+
+	PluginCallScope(const PluginCallScope&);
+	PluginCallScope& operator=(const PluginCallScope&);
+};
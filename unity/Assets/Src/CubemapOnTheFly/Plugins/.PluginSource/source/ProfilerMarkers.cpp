@@ -0,0 +1,127 @@
+#include "ProfilerMarkers.h"
+#include "Unity/IUnityProfiler.h"
+
+#include <stddef.h>
+#include <atomic>
+
+
+namespace {
+
+/** }[J[BProfilerMarker ̏ */
+const char* const kMarkerNames[kProfilerMarkerCount] = {
+	"CubemapBuilderPlugin.Blit",
+	"CubemapBuilderPlugin.Upload",
+	"CubemapBuilderPlugin.Readback",
+	"CubemapBuilderPlugin.Filter",
+};
+
+/**
+ * vt@CpłȂꍇNULLB
+ * [h͕ύXȂAA[hɑXbh̏o͂ƋȂ悤atomicŎ
+ */
+std::atomic<IUnityProfiler*> s_Profiler(NULL);
+const UnityProfilerMarkerDesc* s_Markers[kProfilerMarkerCount] = {};
+
+/**
+ * JE^̒l̊i[BIUnityProfilerV2 ȂꍇNULLB
+ * kUnityProfilerCounterFlagAtomic w肵č쐬Ă̂ŁAUnity̓ǂݎE0ւ̏߂Ƃatomicɋ
+ */
+std::atomic<long long>* s_BytesCopiedCounter = NULL;
+std::atomic<long long>* s_LiveNativeTexturesCounter = NULL;
+
+/** ĂlCeBueNX`BJE^̍쐬OɍꂽĂ */
+std::atomic<long long> s_LiveNativeTextures(0);
+
+thread_local UnityProfilerThreadId t_profilerThreadId = 0;
+thread_local bool t_isProfilerThreadRegistered = false;
+
+std::atomic<long long>* createCounter(IUnityProfilerV2* profiler, const char* name, UnityProfilerMarkerDataUnit unit, UnityProfilerCounterFlags flags)
+{
+	static_assert(sizeof(std::atomic<long long>) == sizeof(long long), "counter storage must be a plain int64");
+	void* p = profiler->CreateCounterValue(
+		kUnityProfilerCategoryRender, name, kUnityProfilerMarkerFlagDefault,
+		kUnityProfilerMarkerDataTypeInt64, unit, sizeof(long long),
+		flags | kUnityProfilerCounterFlagAtomic, NULL, NULL, NULL
+	);
+	return static_cast<std::atomic<long long>*>(p);
+}
+
+}	// namespace
+
+
+void initProfilerMarkers(IUnityInterfaces* unityInterfaces)
+{
+	IUnityProfiler* profiler = unityInterfaces->Get<IUnityProfiler>();
+	if (!profiler || !profiler->IsAvailable()) return;
+
+	for (int i=0; i<kProfilerMarkerCount; ++i) {
+		if (profiler->CreateMarker(&s_Markers[i], kMarkerNames[i], kUnityProfilerCategoryRender, kUnityProfilerMarkerFlagDefault, 0) != 0)
+			return;
+	}
+
+	// JE^ IUnityProfilerV2 ̂݁BȂꍇ̓}[J[o͂
+	IUnityProfilerV2* profilerV2 = unityInterfaces->Get<IUnityProfilerV2>();
+	if (profilerV2) {
+		s_BytesCopiedCounter = createCounter(
+			profilerV2, "CubemapBuilderPlugin Bytes Copied", kUnityProfilerMarkerDataUnitBytes,
+			kUnityProfilerCounterFlushOnEndOfFrame | kUnityProfilerCounterFlagResetToZeroOnFlush
+		);
+		s_LiveNativeTexturesCounter = createCounter(
+			profilerV2, "CubemapBuilderPlugin Live Native Textures", kUnityProfilerMarkerDataUnitCount,
+			kUnityProfilerCounterFlushOnEndOfFrame
+		);
+		if (s_LiveNativeTexturesCounter)
+			s_LiveNativeTexturesCounter->store(s_LiveNativeTextures.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	s_Profiler.store(profiler, std::memory_order_release);
+}
+
+void shutdownProfilerMarkers()
+{
+	s_Profiler.store(NULL, std::memory_order_release);
+	s_BytesCopiedCounter = NULL;
+	s_LiveNativeTexturesCounter = NULL;
+}
+
+void beginProfilerMarker(int marker)
+{
+	IUnityProfiler* profiler = s_Profiler.load(std::memory_order_acquire);
+	if (profiler) profiler->BeginSample(s_Markers[marker]);
+}
+
+void endProfilerMarker(int marker)
+{
+	IUnityProfiler* profiler = s_Profiler.load(std::memory_order_acquire);
+	if (profiler) profiler->EndSample(s_Markers[marker]);
+}
+
+void addProfilerBytesCopied(unsigned long long bytes)
+{
+	if (!s_Profiler.load(std::memory_order_acquire) || !s_BytesCopiedCounter) return;
+	s_BytesCopiedCounter->fetch_add((long long)bytes, std::memory_order_relaxed);
+}
+
+void addProfilerLiveNativeTextures(int delta)
+{
+	const long long n = s_LiveNativeTextures.fetch_add(delta, std::memory_order_relaxed) + delta;
+	if (!s_Profiler.load(std::memory_order_acquire) || !s_LiveNativeTexturesCounter) return;
+	s_LiveNativeTexturesCounter->store(n, std::memory_order_relaxed);
+}
+
+void registerProfilerThread(const char* name)
+{
+	IUnityProfiler* profiler = s_Profiler.load(std::memory_order_acquire);
+	if (!profiler || t_isProfilerThreadRegistered) return;
+	t_isProfilerThreadRegistered = profiler->RegisterThread(&t_profilerThreadId, "CubemapBuilderPlugin", name) == 0;
+}
+
+void unregisterProfilerThread()
+{
+	if (!t_isProfilerThreadRegistered) return;
+	t_isProfilerThreadRegistered = false;
+
+	// A[h̓vt@ĈȂ̂ŁAȂ
+	IUnityProfiler* profiler = s_Profiler.load(std::memory_order_acquire);
+	if (profiler) profiler->UnregisterThread(t_profilerThreadId);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Unity/IUnityInterface.h"
+
+//
+// Unity ̃vt@C(IUnityProfiler)ցAvOC̏̃}[J[ƃJE^o͂B
+// UnityPluginLoad  initProfilerMarkers ĂԂƁAȍ~ Profiler EBhE Render JeSɕ\B
+// vt@CpłȂ([Xrh̃vC[Ȃ)ł͉ȂB
+// }[J[UnityǗXbhAregisterProfilerThread œo^Xbĥݏo͂邱ƁB
+//
+//   ProfilerMarkerScope marker(kProfilerMarkerBlit);
+//
+
+
+/** vt@Cɏo͂}[J[ */
+enum ProfilerMarker
+{
+	kProfilerMarkerBlit,		//!< L[u}bvւ̓]
+	kProfilerMarkerUpload,		//!< t@C̃~bv]
+	kProfilerMarkerReadback,	//!< GPǓʂ̓ǂݖ߂
+	kProfilerMarkerFilter,		//!< ϊE]Epڕ␳EڂEPxv
+
+	kProfilerMarkerCount
+};
+
+
+/** vt@C擾ă}[J[ƃJE^o^BUnityPluginLoad Ă */
+void initProfilerMarkers(IUnityInterfaces* unityInterfaces);
+
+/** vt@Cւ̏o͂߂BUnityPluginUnload Ă */
+void shutdownProfilerMarkers();
+
+/** }[J[̊JnEIo͂BProfilerMarkerScope Ă */
+void beginProfilerMarker(int marker);
+void endProfilerMarker(int marker);
+
+/** ݂̃t[ŃRs[E]oCg̃JE^։Z */
+void addProfilerBytesCopied(unsigned long long bytes);
+
+/** vOC쐬ĐĂlCeBueNX`̃JE^։Z */
+void addProfilerLiveNativeTextures(int delta);
+
+/** vOC쐬XbhA}[J[o͂ł悤Ƀvt@C֓o^Bname͐ÓIȕ̂ */
+void registerProfilerThread(const char* name);
+
+/** registerProfilerThread œo^Xbh̓o^BXbh̏IOɌĂ */
+void unregisterProfilerThread();
+
+
+/** XR[v̊Ԃ̏vt@C̃}[J[Ƃďo͂ */
+class ProfilerMarkerScope
+{
+public:
+	explicit ProfilerMarkerScope(int marker) : _marker(marker) { beginProfilerMarker(_marker); }
+	~ProfilerMarkerScope() { endProfilerMarker(_marker); }
+
+private:
+	int _marker;
+
+	ProfilerMarkerScope(const ProfilerMarkerScope&);
+	ProfilerMarkerScope& operator=(const ProfilerMarkerScope&);
+};
+
+/** XR[v̊ԁÃ݂Xbhvt@C֓o^Ă */
+class ProfilerThreadScope
+{
+public:
+	explicit ProfilerThreadScope(const char* name) { registerProfilerThread(name); }
+	~ProfilerThreadScope() { unregisterProfilerThread(); }
+
+private:
+	ProfilerThreadScope(const ProfilerThreadScope&);
+	ProfilerThreadScope& operator=(const ProfilerThreadScope&);
+};
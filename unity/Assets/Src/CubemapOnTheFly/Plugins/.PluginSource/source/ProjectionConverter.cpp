@@ -0,0 +1,73 @@
+#include "ProjectionConverter.h"
+#include "FrameArena.h"
+#include "Parallel.h"
+
+#include <math.h>
+
+
+bool convertCubemapToProjectionCPU(const CubemapImageView& src, const Image2DView& dst, int projection)
+{
+	if (!src.pixels || !dst.pixels || src.size <= 0 || dst.width <= 0 || dst.height <= 0) return false;
+	if (projection < 0 || kProjectionCount <= projection) return false;
+
+	if (projection == kProjectionEquirect) {
+		// ~̏ꍇ͗񂲂Ƃ̎Op֐OvZĂ
+		FrameArena::Scope arena( getFrameArena() );
+		float* sinLon = arena.allocateArray<float>(dst.width);
+		float* cosLon = arena.allocateArray<float>(dst.width);
+		if (!sinLon || !cosLon) return false;
+		for (int x=0; x<dst.width; ++x) {
+			float lon = ((x + 0.5f) / dst.width - 0.5f) * 2 * kPI;
+			sinLon[x] = sinf(lon);
+			cosLon[x] = cosf(lon);
+		}
+
+		parallelFor( dst.height, [&](int begin, int end) {
+			for (int y=begin; y<end; ++y) {
+				float lat = ((y + 0.5f) / dst.height - 0.5f) * kPI;
+				float sl = sinf(lat), cl = cosf(lat);
+				unsigned char* dstRow = dst.texel(0, y);
+				for (int x=0; x<dst.width; ++x) {
+					Vec3 d = makeVec3( cl*sinLon[x], sl, cl*cosLon[x] );
+					simdStoreRGBA8( dstRow + x*4, sampleCubeBilinear(src, d) );
+				}
+			}
+		} );
+		return true;
+	}
+
+	parallelFor( dst.height, [&](int begin, int end) {
+		for (int y=begin; y<end; ++y) {
+			float v = (y + 0.5f) / dst.height;
+			unsigned char* dstRow = dst.texel(0, y);
+			for (int x=0; x<dst.width; ++x) {
+				Vec3 d = projectionUVToDir( projection, (x + 0.5f) / dst.width, v );
+				simdStoreRGBA8( dstRow + x*4, sampleCubeBilinear(src, d) );
+			}
+		}
+	} );
+	return true;
+}
+
+bool convertProjectionToCubemapCPU(const Image2DView& src, int projection, const CubemapImageView& dst)
+{
+	if (!src.pixels || !dst.pixels || dst.size <= 0 || src.width <= 0 || src.height <= 0) return false;
+	if (projection < 0 || kProjectionCount <= projection) return false;
+
+	// ~̏ꍇ̂݁Aox͌JԂŃTvO
+	const bool wrapU = projection == kProjectionEquirect;
+
+	const float invSize = 1.0f / dst.size;
+	parallelForCubemapTiles( dst.size, 1, kParallelTileSize, [&](const CubemapTile& t) {
+		for (int y=t.y; y<t.y+t.height; ++y) {
+			unsigned char* dstRow = dst.texel(t.face, 0, y);
+			for (int x=t.x; x<t.x+t.width; ++x) {
+				Vec3 d = normalize( faceUVToDir(t.face, (x + 0.5f) * invSize, (y + 0.5f) * invSize) );
+				float u, v;
+				dirToProjectionUV(projection, d, &u, &v);
+				simdStoreRGBA8( dstRow + x*4, sample2DBilinear(src, u, v, wrapU) );
+			}
+		}
+	} );
+	return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CubemapImage.h"
+
+//
+// L[u}bvƊe퓊e@(~Eʑ́Eo)̑ݕϊCPUB
+// GPU͊eRenderAPI convertCubemapToProjection / convertProjectionToCubemap QƁB
+//
+
+
+/** L[u}bvw̓e@2D摜֕ϊBo̓TCY͔C */
+bool convertCubemapToProjectionCPU(const CubemapImageView& src, const Image2DView& dst, int projection);
+
+/** w̓e@2D摜L[u}bv֕ϊBo̓TCY͔C */
+bool convertProjectionToCubemapCPU(const Image2DView& src, int projection, const CubemapImageView& dst);
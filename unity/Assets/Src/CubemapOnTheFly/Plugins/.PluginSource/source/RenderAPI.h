@@ -3,8 +3,10 @@
 #include "Unity/IUnityGraphics.h"
 
 #include <stddef.h>
+#include <functional>
 
 struct IUnityInterfaces;
+struct CubemapLuminanceStats;
 
 
 class RenderAPI
@@ -27,6 +29,175 @@ public:
 		void* cubemapTex,
 		int texWidth
 	) = 0;
+
+	/**
+	 * L[u}bvw̓e@2DeNX`1pXŕϊB
+	 * o͔͐CӃTCYRGBA82DeNX`BΉ̏ꍇfalseԂ
+	 */
+	virtual bool convertCubemapToProjection(
+		void* cubemapTex,
+		void* dstTex,
+		int dstWidth,
+		int dstHeight,
+		int projection
+	) { return false; }
+
+	/**
+	 * w̓e@2DeNX`L[u}bv֕ϊB
+	 * o͔͐CӃTCỸL[u}bvBΉ̏ꍇfalseԂ
+	 */
+	virtual bool convertProjectionToCubemap(
+		void* srcTex,
+		void* cubemapTex,
+		int cubemapSize,
+		int projection
+	) { return false; }
+
+	/**
+	 * L[u}bvɔCӂ̉]Kp̂Aʂ̃L[u}bv֏ށB
+	 * o͂̊edɂ́A͂ rotation * d ̐̕FBrotation͍sD3x3sB
+	 * srcdstɓeNX`w肵ꍇ́ȀōXVBΉ̏ꍇfalseԂ
+	 */
+	virtual bool rotateCubemap(
+		void* srcCubemapTex,
+		void* dstCubemapTex,
+		int size,
+		const float* rotation
+	) { return false; }
+
+	/**
+	 * L[u}bv̊eʂ̉̃eNZAאږʂ̑ΉeNZƕςČpڂڗȂB
+	 * 擪mipCountĩ~bvxꂼɓKpBΉ̏ꍇfalseԂB
+	 * ̓VF[_gpOpenGL(SUPPORT_OPENGL_SHADER_OPS)̂ݑΉŁAiOSEtvOSEAndroidEWebGLD3Dł
+	 * falseɂȂB̏ꍇ͓ǂݖ߂ fixupCubemapSeamsCPU ŏC邱
+	 */
+	virtual bool fixupCubemapSeams(
+		void* cubemapTex,
+		int size,
+		int mipCount
+	) { return false; }
+
+	/**
+	 * L[u}bvɕ\ȃKEVAڂAdstCubemapTexɏށB
+	 * sigma̓eNZPʁBʂ̉܂tFb`͗אږʂ̌ɍ킹čsB
+	 * srcdstɓeNX`w肵ꍇ͂̏ōXVBΉ̏ꍇfalseԂ
+	 */
+	virtual bool blurCubemap(
+		void* srcCubemapTex,
+		void* dstCubemapTex,
+		int size,
+		float sigma
+	) { return false; }
+
+	/**
+	 * L[u}bv̋Pxv(̊pŏdݕtΐPxqXgOƍŏEőE)
+	 * GPUŏWvBʂ getLuminanceStats Ŏ擾BΉ̏ꍇfalseԂ
+	 */
+	virtual bool computeLuminanceStats(
+		void* cubemapTex,
+		int size,
+		float minLog2Lum,
+		float maxLog2Lum
+	) { return false; }
+
+	/**
+	 * ߂ computeLuminanceStats ̌ʂ擾Bvp̏ȃobt@݂̂ǂݖ߂B
+	 * GPUł̏Wv̊͑҂Ȃ̂ŁAWv̏ꍇfalseԂBWvʂꍇ▢Ή̏ꍇfalse
+	 */
+	virtual bool getLuminanceStats(CubemapLuminanceStats* out) { return false; }
+
+	/**
+	 * zXg̃f[^AL[u}bv̎w~bvx֒ړ]B
+	 * faces6ʕʂ̏ɌԂȂ񂾂́Bformat PixelFormatBΉ̏ꍇfalseԂ
+	 */
+	virtual bool uploadCubemapLevel(
+		void* cubemapTex,
+		int level,
+		int levelSize,
+		int format,
+		const void* faces
+	) { return false; }
+
+	/**
+	 * ύXsȃXg[WL[u}bv쐬Bformat PixelFormatB
+	 * ߂l Cubemap.CreateExternalTexture ɂ̂܂ܓnlCeBueNX`ŁA
+	 * svɂȂ destroyCubemap Ŕj邱ƁBΉEsNULLԂ
+	 */
+	virtual void* createCubemap(int size, int mipCount, int format) { return NULL; }
+
+	/** createCubemap ō쐬L[u}bvjBΉ̏ꍇfalseԂ */
+	virtual bool destroyCubemap(void* cubemapTex) { return false; }
+
+	/**
+	 * eNX`̎ۂ̑傫E~bvE`擾BLv`̋L^pB
+	 * mipCount͕Ȃꍇ0Aformat PixelFormat ŕ\Ȃꍇ-1BΉ̏ꍇfalseԂ
+	 */
+	virtual bool getTextureInfo(void* tex, bool isCubemap, int* width, int* height, int* mipCount, int* format) { return false; }
+
+	/**
+	 * L[u}bv̊eʂAXg[WL2DeNX`ƂĎQƂr[쐬B
+	 * ̃L[u}bv͕ύXsȃXg[WƁB쐬r[͖ʂ̏outFaceTexs֓A
+	 * ꂼ Texture2D.CreateExternalTexture ɓnBΉEsfalseԂ
+	 */
+	virtual bool createCubemapFaceViews(void* cubemapTex, void** outFaceTexs) { return false; }
+
+	/** createCubemapFaceViews ō쐬r[jB̃L[u}bvɂ͉eȂ */
+	virtual bool destroyTextureView(void* viewTex) { return false; }
+
+	/**
+	 * eNX`ւ̓]ȂǁA_[Xbh~߂Ă܂obNOEh̃XbhōsB
+	 * job̓OtBbNXAPĨReLXgL郏[J[XbhŁA܂łɔsGPUR}ȟɎsB
+	 * jobŌĂׂ̂ uploadCubemapLevel ̂悤ɁAeNX`݂̂ɌB
+	 * job̌ʂUnityQƂł悤ɂȂƁApollAsync ̒Ń_[Xbh completion Ă΂B
+	 * _[XbhĂԂƁBΉ̏ꍇfalseԂ̂ŁAĂяoœIɏ邱
+	 */
+	virtual bool runAsync(
+		const std::function<bool()>& job,
+		const std::function<void(bool succeeded)>& completion
+	) { return false; }
+
+	/**  runAsync ̏ completion ĂԁB_[XbhĂ */
+	virtual void pollAsync() {}
+
+	/**
+	 * ܂łɔsGPUR}h̊𔻒肷邽߂̃tFX}B_[XbhĂԁB
+	 * ߂l queryFence / destroyFence ɓnBΉ̏ꍇNULLԂ
+	 */
+	virtual void* insertFence() { return NULL; }
+
+	/** insertFence ő}tFX܂łGPUR}hA҂ɕԂB1: 0: -1:s */
+	virtual int queryFence(void* fence) { return -1; }
+
+	/** insertFence ő}tFXj */
+	virtual void destroyFence(void* fence) {}
+
+	/**
+	 * ȍ~ɔsGPUR}hGPUԂ̌vJnBop PluginOpAsize͏eNX`̈ӁB
+	 * v͓qɂłȂBʂ͓ǂݖ߂悤ɂȂ_ PluginStats ։ZB
+	 * _[XbhȊOĂ΂ꂽꍇAΉ̏ꍇ͉Ȃ
+	 */
+	virtual void beginGpuTimer(int op, int size) {}
+
+	/** beginGpuTimer ŊJnvI */
+	virtual void endGpuTimer() {}
+
+	/** ǂݖ߂悤ɂȂGPUԂ̌vʂ荞ށB҂ɕԂB_[XbhĂ */
+	virtual void pollGpuTimers() {}
+};
+
+
+/** XR[v̊ԂɔsGPUR}hGPUԂv */
+class GpuTimerScope
+{
+public:
+	GpuTimerScope(RenderAPI* api, int op, int size) : _api(api) { _api->beginGpuTimer(op, size); }
+	~GpuTimerScope() { _api->endGpuTimer(); }
+
+private:
+	RenderAPI* _api;
+
+	GpuTimerScope(const GpuTimerScope&);
+	GpuTimerScope& operator=(const GpuTimerScope&);
 };
 
 
@@ -1,5 +1,7 @@
 #include "RenderAPI.h"
 #include "PlatformBase.h"
+#include "PixelFormat.h"
+#include "GpuTimer.h"
 
 //
 // Direct3D 11 p RenderAPI 
@@ -12,11 +14,38 @@
 #include "Unity/IUnityGraphicsD3D11.h"
 
 
+/**
+ * lCeBueNX`|C^AeNX`{̂擾B
+ * GetNativeTexturePtr ̓eNX`{̂AcreateCubemap ō쐬̂̓VF[_\[Xr[ŵŁA󂯕tB
+ * ߂l͎QƃJEg𑝂₵Ă̂ŁAgpRelease邱ƁBsnullptr
+ */
+static ID3D11Texture2D* getD3D11Texture2D(void* nativeTex)
+{
+	if (!nativeTex) return nullptr;
+	auto unknown = static_cast<IUnknown*>(nativeTex);
+
+	ID3D11Texture2D* tex = nullptr;
+	ID3D11ShaderResourceView* srv = nullptr;
+	if (SUCCEEDED(unknown->QueryInterface(__uuidof(ID3D11ShaderResourceView), reinterpret_cast<void**>(&srv)))) {
+		ID3D11Resource* res = nullptr;
+		srv->GetResource(&res);
+		srv->Release();
+		if (!res) return nullptr;
+		if (FAILED(res->QueryInterface(__uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&tex)))) tex = nullptr;
+		res->Release();
+		return tex;
+	}
+	if (FAILED(unknown->QueryInterface(__uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&tex)))) return nullptr;
+	return tex;
+}
+
+
 class RenderAPI_D3D11 : public RenderAPI
 {
 public:
 	RenderAPI_D3D11()
 		: _d3d11(nullptr)
+		, _gpuTimerState(0)
 	{}
 	virtual ~RenderAPI_D3D11() { }
 
@@ -26,6 +55,7 @@ public:
 			_d3d11 = interfaces->Get<IUnityGraphicsD3D11>();
 			break;
 		case kUnityGfxDeviceEventShutdown:
+			releaseGpuTimers();
 			break;
 		}
 	}
@@ -40,6 +70,9 @@ public:
 		void* cubemapTex,
 		int texWidth
 	) {
+		auto dstTex = getD3D11Texture2D(cubemapTex);
+		if (!dstTex) return;
+
 		auto device = _d3d11->GetDevice();
 		ID3D11DeviceContext* ctx = nullptr;
 		device->GetImmediateContext(&ctx);
@@ -53,7 +86,6 @@ public:
 			static_cast<ID3D11Texture2D*>( srcTex4 ),
 			static_cast<ID3D11Texture2D*>( srcTex5 ),
 		};
-		auto dstTex = static_cast<ID3D11Texture2D*>( cubemapTex );
 
 		// Rs[s
 		for (int i=0; i<6; ++i) {
@@ -61,10 +93,234 @@ public:
 		}
 
 		ctx->Release();
+		dstTex->Release();
+	}
+
+	virtual bool uploadCubemapLevel(
+		void* cubemapTex,
+		int level,
+		int levelSize,
+		int format,
+		const void* faces
+	) {
+		if (pixelFormatBytes(format) == 0) return false;
+		auto dstTex = getD3D11Texture2D(cubemapTex);
+		if (!dstTex) return false;
+
+		auto device = _d3d11->GetDevice();
+		ID3D11DeviceContext* ctx = nullptr;
+		device->GetImmediateContext(&ctx);
+
+		D3D11_TEXTURE2D_DESC desc;
+		dstTex->GetDesc(&desc);
+
+		// eʂTu\[X֒ړ]
+		const size_t faceBytes = cubemapFaceBytes(levelSize, 0, format);
+		for (int i=0; i<6; ++i) {
+			ctx->UpdateSubresource(
+				dstTex, D3D11CalcSubresource(level, i, desc.MipLevels), nullptr,
+				static_cast<const unsigned char*>(faces) + faceBytes * i,
+				levelSize * pixelFormatBytes(format), 0
+			);
+		}
+
+		ctx->Release();
+		dstTex->Release();
+		return true;
+	}
+
+	/**
+	 * D3D11̊OeNX`̓VF[_\[Xr[Ŏ󂯓n̂ŁAeNX`{̂ł͂ȂԂB
+	 * ̃vOC̑̏ɓnꍇ́AgetD3D11Texture2D ŃeNX`{̂oĎgp
+	 */
+	virtual void* createCubemap(int size, int mipCount, int format) {
+		D3D11_TEXTURE2D_DESC desc = {};
+		desc.Width = size;
+		desc.Height = size;
+		desc.MipLevels = mipCount;
+		desc.ArraySize = 6;
+		desc.SampleDesc.Count = 1;
+		desc.Usage = D3D11_USAGE_DEFAULT;
+		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+		desc.MiscFlags = D3D11_RESOURCE_MISC_TEXTURECUBE;
+		switch (format) {
+		case kPixelFormatRGBA8 : desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+		case kPixelFormatRGBA8_SRGB : desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; break;
+		case kPixelFormatRGBAHalf : desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT; break;
+		default : return nullptr;
+		}
+
+		auto device = _d3d11->GetDevice();
+		ID3D11Texture2D* tex = nullptr;
+		if (FAILED(device->CreateTexture2D(&desc, nullptr, &tex))) return nullptr;
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.Format = desc.Format;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+		srvDesc.TextureCube.MipLevels = mipCount;
+		ID3D11ShaderResourceView* srv = nullptr;
+		HRESULT hr = device->CreateShaderResourceView(tex, &srvDesc, &srv);
+		tex->Release();		// SRVQƂێ
+		return SUCCEEDED(hr) ? srv : nullptr;
+	}
+
+	virtual bool destroyCubemap(void* cubemapTex) {
+		static_cast<ID3D11ShaderResourceView*>(cubemapTex)->Release();
+		return true;
+	}
+
+	virtual bool getTextureInfo(void* tex, bool isCubemap, int* width, int* height, int* mipCount, int* format) {
+		auto tex2D = getD3D11Texture2D(tex);
+		if (!tex2D) return false;
+		D3D11_TEXTURE2D_DESC desc;
+		tex2D->GetDesc(&desc);
+		tex2D->Release();
+
+		*width = (int)desc.Width;
+		*height = (int)desc.Height;
+		*mipCount = (int)desc.MipLevels;
+		switch (desc.Format) {
+		case DXGI_FORMAT_R8G8B8A8_TYPELESS :
+		case DXGI_FORMAT_R8G8B8A8_UNORM : *format = kPixelFormatRGBA8; break;
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : *format = kPixelFormatRGBA8_SRGB; break;
+		case DXGI_FORMAT_R16G16B16A16_TYPELESS :
+		case DXGI_FORMAT_R16G16B16A16_FLOAT : *format = kPixelFormatRGBAHalf; break;
+		default : *format = -1; break;
+		}
+		return true;
+	}
+
+	/** D3D11ł̓CxgNGtFXƂĎgp */
+	virtual void* insertFence() {
+		auto device = _d3d11->GetDevice();
+		D3D11_QUERY_DESC desc = {};
+		desc.Query = D3D11_QUERY_EVENT;
+		ID3D11Query* query = nullptr;
+		if (FAILED(device->CreateQuery(&desc, &query))) return nullptr;
+
+		ID3D11DeviceContext* ctx = nullptr;
+		device->GetImmediateContext(&ctx);
+		ctx->End(query);
+		ctx->Release();
+		return query;
+	}
+
+	virtual int queryFence(void* fence) {
+		auto device = _d3d11->GetDevice();
+		ID3D11DeviceContext* ctx = nullptr;
+		device->GetImmediateContext(&ctx);
+		BOOL isDone = FALSE;
+		HRESULT hr = ctx->GetData(static_cast<ID3D11Query*>(fence), &isDone, sizeof(isDone), 0);
+		ctx->Release();
+		if (FAILED(hr)) return -1;
+		return (hr == S_OK && isDone) ? 1 : 0;
+	}
+
+	virtual void destroyFence(void* fence) {
+		static_cast<ID3D11Query*>(fence)->Release();
+	}
+
+	/** ̑Õ^CX^vAg肾𔻒肷 disjoint NGň͂ŋL^ */
+	virtual void beginGpuTimer(int op, int size) {
+		if (!prepareGpuTimers()) return;
+		pollGpuTimers();
+		auto e = _gpuTimers.begin(op, size);
+		if (!e) return;
+
+		ID3D11DeviceContext* ctx = nullptr;
+		_d3d11->GetDevice()->GetImmediateContext(&ctx);
+		ctx->Begin(e->query.disjoint);
+		ctx->End(e->query.timestamps[0]);
+		ctx->Release();
+	}
+
+	virtual void endGpuTimer() {
+		if (_gpuTimerState != 1) return;
+		auto e = _gpuTimers.end();
+		if (!e) return;
+
+		ID3D11DeviceContext* ctx = nullptr;
+		_d3d11->GetDevice()->GetImmediateContext(&ctx);
+		ctx->End(e->query.timestamps[1]);
+		ctx->End(e->query.disjoint);
+		ctx->Release();
+	}
+
+	virtual void pollGpuTimers() {
+		if (_gpuTimerState != 1) return;
+
+		ID3D11DeviceContext* ctx = nullptr;
+		_d3d11->GetDevice()->GetImmediateContext(&ctx);
+		while (auto e = _gpuTimers.front()) {
+			// ₢킹̂߂ɃtbV͂ȂBǂݖ߂悤ɂȂĂȂΎɉ
+			D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+			if (ctx->GetData(e->query.disjoint, &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) break;
+
+			UINT64 begin = 0, end = 0;
+			const bool isValid =
+				ctx->GetData(e->query.timestamps[0], &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+				ctx->GetData(e->query.timestamps[1], &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+				!disjoint.Disjoint && disjoint.Frequency != 0 && begin <= end;
+			_gpuTimers.pop(isValid ? (end - begin) * 1000000000ull / disjoint.Frequency : 0, isValid);
+		}
+		ctx->Release();
 	}
 
 private:
 	IUnityGraphicsD3D11* _d3d11;
+
+	struct D3D11TimerQuery
+	{
+		ID3D11Query* disjoint;
+		ID3D11Query* timestamps[2];		//!< ̑OẼ^CX^v
+	};
+	GpuTimerQueue<D3D11TimerQuery> _gpuTimers;
+	int _gpuTimerState;					//!< 0:mF 1:gp\ -1:쐬s
+
+	/** GPUԂ̌vp̃NGAgpɍ쐬BvłȂꍇfalse */
+	bool prepareGpuTimers() {
+		if (_gpuTimerState != 0) return _gpuTimerState == 1;
+
+		auto device = _d3d11->GetDevice();
+		D3D11_QUERY_DESC disjointDesc = {};
+		disjointDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+		D3D11_QUERY_DESC timestampDesc = {};
+		timestampDesc.Query = D3D11_QUERY_TIMESTAMP;
+
+		_gpuTimerState = 1;
+		auto entries = _gpuTimers.entries();
+		for (int i=0; i<_gpuTimers.capacity(); ++i) {
+			D3D11TimerQuery& q = entries[i].query;
+			q.disjoint = q.timestamps[0] = q.timestamps[1] = nullptr;
+			if (
+				FAILED(device->CreateQuery(&disjointDesc, &q.disjoint)) ||
+				FAILED(device->CreateQuery(&timestampDesc, &q.timestamps[0])) ||
+				FAILED(device->CreateQuery(&timestampDesc, &q.timestamps[1]))
+			) _gpuTimerState = -1;
+		}
+		if (_gpuTimerState != 1) releaseGpuTimerQueries();
+		setGpuTimerSupported(_gpuTimerState == 1);
+		return _gpuTimerState == 1;
+	}
+
+	/** GPUԂ̌vp̃NGjBʂ҂Ă͎̂̂Ă */
+	void releaseGpuTimers() {
+		if (_gpuTimerState == 1) releaseGpuTimerQueries();
+		_gpuTimers.clear();
+		_gpuTimerState = 0;
+		setGpuTimerSupported(false);
+	}
+
+	void releaseGpuTimerQueries() {
+		auto entries = _gpuTimers.entries();
+		for (int i=0; i<_gpuTimers.capacity(); ++i) {
+			D3D11TimerQuery& q = entries[i].query;
+			if (q.disjoint) q.disjoint->Release();
+			if (q.timestamps[0]) q.timestamps[0]->Release();
+			if (q.timestamps[1]) q.timestamps[1]->Release();
+			q.disjoint = q.timestamps[0] = q.timestamps[1] = nullptr;
+		}
+	}
 };
 
 
@@ -1,5 +1,6 @@
 #include "RenderAPI.h"
 #include "PlatformBase.h"
+#include "PixelFormat.h"
 
 #include <cmath>
 
@@ -98,6 +99,77 @@ public:
 		_d3d12FenceValue = _d3d12->ExecuteCommandList(_d3d12CmdList, 1, &resourceState);
 	}
 
+	virtual void* createCubemap(int size, int mipCount, int format) {
+		D3D12_RESOURCE_DESC desc = {};
+		desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+		desc.Width = size;
+		desc.Height = size;
+		desc.DepthOrArraySize = 6;
+		desc.MipLevels = (UINT16)mipCount;
+		desc.SampleDesc.Count = 1;
+		desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+		desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+		switch (format) {
+		case kPixelFormatRGBA8 : desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+		case kPixelFormatRGBA8_SRGB : desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; break;
+		case kPixelFormatRGBAHalf : desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT; break;
+		default : return nullptr;
+		}
+
+		D3D12_HEAP_PROPERTIES heap = {};
+		heap.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+		ID3D12Resource* tex = nullptr;
+		HRESULT hr = _d3d12->GetDevice()->CreateCommittedResource(
+			&heap, D3D12_HEAP_FLAG_NONE, &desc,
+			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, nullptr,
+			IID_PPV_ARGS(&tex)
+		);
+		return SUCCEEDED(hr) ? tex : nullptr;
+	}
+
+	virtual bool destroyCubemap(void* cubemapTex) {
+		static_cast<ID3D12Resource*>(cubemapTex)->Release();
+		return true;
+	}
+
+	virtual bool getTextureInfo(void* tex, bool isCubemap, int* width, int* height, int* mipCount, int* format) {
+		if (!tex) return false;
+		const D3D12_RESOURCE_DESC desc = static_cast<ID3D12Resource*>(tex)->GetDesc();
+		if (desc.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D) return false;
+
+		*width = (int)desc.Width;
+		*height = (int)desc.Height;
+		*mipCount = (int)desc.MipLevels;
+		switch (desc.Format) {
+		case DXGI_FORMAT_R8G8B8A8_TYPELESS :
+		case DXGI_FORMAT_R8G8B8A8_UNORM : *format = kPixelFormatRGBA8; break;
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : *format = kPixelFormatRGBA8_SRGB; break;
+		case DXGI_FORMAT_R16G16B16A16_TYPELESS :
+		case DXGI_FORMAT_R16G16B16A16_FLOAT : *format = kPixelFormatRGBAHalf; break;
+		default : *format = -1; break;
+		}
+		return true;
+	}
+
+	/**
+	 * D3D12łUnitỹt[tFX̒ltFXƂĎgpB
+	 * ݂̃t[̃R}hƁÃvOCŎsR}hXg̊̒l̂A傫҂
+	 */
+	virtual void* insertFence() {
+		UINT64 value = _d3d12->GetNextFrameFenceValue();
+		if (value < _d3d12FenceValue) value = _d3d12FenceValue;
+		return new UINT64(value);
+	}
+
+	virtual int queryFence(void* fence) {
+		return *static_cast<UINT64*>(fence) <= _d3d12->GetFrameFence()->GetCompletedValue() ? 1 : 0;
+	}
+
+	virtual void destroyFence(void* fence) {
+		delete static_cast<UINT64*>(fence);
+	}
+
 private:
 	const UINT kNodeMask = 0;
 	IUnityGraphicsD3D12v2* _d3d12;
@@ -1,5 +1,9 @@
 #include "RenderAPI.h"
 #include "PlatformBase.h"
+#include "CubeMath.h"
+#include "CubemapBlur.h"
+#include "LuminanceStats.h"
+#include "PixelFormat.h"
 
 //
 // OpenGL Core/ES p RenderAPI 
@@ -9,23 +13,216 @@
 #if SUPPORT_OPENGL_UNIFIED
 
 
+#include "OpenGLCommon.h"
+#include "GLWorker.h"
+#include "GpuTimer.h"
+#include "GLCopyTuner.h"
+
 #include <assert.h>
-#if UNITY_IOS || UNITY_TVOS
-#	include <OpenGLES/ES2/gl.h>
-#elif UNITY_ANDROID || UNITY_WEBGL
-#	include <GLES2/gl2.h>
-#elif UNITY_OSX
-#	include <OpenGL/gl3.h>
-#elif UNITY_WIN
-// On Windows, use gl3w to initialize and load OpenGL Core functions. In principle any other
-// library (like GLEW, GLFW etc.) can be used; here we use gl3w since it's simple and
-// straightforward.
-#	include "gl3w/gl3w.h"
-#elif UNITY_LINUX
-#	define GL_GLEXT_PROTOTYPES
-#	include <GL/gl.h>
-#else
-#	error Unknown platform
+#include <string.h>
+
+
+#if SUPPORT_OPENGL_SHADER_OPS
+
+// ẽtOgVF[_{́B
+// 擪GLSL̃o[W錾kGLSLCubeMatht
+
+/** L[u}bve@ ϊ */
+static const char* const kFSCubemapToProjection =
+	"uniform samplerCube uSrc;\n"
+	"uniform int uProjection;\n"
+	"in vec2 vUV;\n"
+	"out vec4 oColor;\n"
+	"void main() {\n"
+	"	oColor = textureLod(uSrc, projectionUVToDir(uProjection, vUV), 0.0);\n"
+	"}\n";
+
+/** e@L[u}bv ϊ */
+static const char* const kFSProjectionToCubemap =
+	"uniform sampler2D uSrc;\n"
+	"uniform int uProjection;\n"
+	"uniform int uFace;\n"
+	"in vec2 vUV;\n"
+	"out vec4 oColor;\n"
+	"void main() {\n"
+	"	vec3 d = normalize(faceUVToDir(uFace, vUV));\n"
+	"	oColor = textureLod(uSrc, dirToProjectionUV(uProjection, d), 0.0);\n"
+	"}\n";
+
+/** L[u}bv̉] */
+static const char* const kFSRotateCubemap =
+	"uniform samplerCube uSrc;\n"
+	"uniform mat3 uRotation;\n"
+	"uniform int uFace;\n"
+	"in vec2 vUV;\n"
+	"out vec4 oColor;\n"
+	"void main() {\n"
+	"	oColor = textureLod(uSrc, uRotation * faceUVToDir(uFace, vUV), 0.0);\n"
+	"}\n";
+
+/**
+ * L[u}bv̌pڂ̏CB
+ * ʂ̉̃eNZAאږʂ̑ΉeNZ(p̏ꍇ3ʕ)ƕς
+ */
+static const char* const kFSFixupCubemapSeams =
+	"uniform samplerCube uSrc;\n"
+	"uniform int uFace;\n"
+	"uniform float uLevel;\n"
+	"uniform float uSize;\n"
+	"in vec2 vUV;\n"
+	"out vec4 oColor;\n"
+	"vec4 fetchTexel(vec2 t) { return textureLod(uSrc, faceUVToDir(uFace, (t + 0.5) / uSize), uLevel); }\n"
+	"void main() {\n"
+	"	vec2 t = floor(vUV * uSize);\n"
+	"	float last = uSize - 1.0;\n"
+	"	vec2 o = vec2(\n"
+	"		t.x == 0.0 ? -1.0 : (t.x == last ? 1.0 : 0.0),\n"
+	"		t.y == 0.0 ? -1.0 : (t.y == last ? 1.0 : 0.0)\n"
+	"	);\n"
+	"	vec4 c = fetchTexel(t);\n"
+	"	float cnt = 1.0;\n"
+	"	if (o.x != 0.0) { c += fetchTexel(t + vec2(o.x, 0.0)); cnt += 1.0; }\n"
+	"	if (o.y != 0.0) { c += fetchTexel(t + vec2(0.0, o.y)); cnt += 1.0; }\n"
+	"	oColor = c / cnt;\n"
+	"}\n";
+
+/**
+ * L[u}bv1̃KEVAڂB
+ * ʊÕeNZ͕xNgoRŗאږʂ擾BuWeights̗vf kMaxBlurRadius+1
+ */
+static const char* const kFSBlurCubemap =
+	"uniform samplerCube uSrc;\n"
+	"uniform int uFace;\n"
+	"uniform float uSize;\n"
+	"uniform vec2 uAxis;\n"
+	"uniform int uRadius;\n"
+	"uniform float uWeights[65];\n"
+	"in vec2 vUV;\n"
+	"out vec4 oColor;\n"
+	"vec4 fetchTexel(vec2 t) { return textureLod(uSrc, faceUVToDir(uFace, (t + 0.5) / uSize), 0.0); }\n"
+	"void main() {\n"
+	"	vec2 t = floor(vUV * uSize);\n"
+	"	vec4 c = fetchTexel(t) * uWeights[0];\n"
+	"	for (int k=1; k<=uRadius; ++k) {\n"
+	"		vec2 o = uAxis * float(k);\n"
+	"		c += (fetchTexel(t - o) + fetchTexel(t + o)) * uWeights[k];\n"
+	"	}\n"
+	"	oColor = c;\n"
+	"}\n";
+
+/** eNX`̃Rs[B`Ɠ傫̃Rs[AeNẐ܂ܓǂ */
+static const char* const kFSCopyTexture =
+	"uniform sampler2D uSrc;\n"
+	"uniform int uLevel;\n"
+	"out vec4 oColor;\n"
+	"void main() {\n"
+	"	oColor = texelFetch(uSrc, ivec2(gl_FragCoord.xy), uLevel);\n"
+	"}\n";
+
+#endif
+
+#if SUPPORT_OPENGL_COMPUTE
+
+/**
+ * L[u}bv̋PxvWvRs[gVF[_B
+ * `ɂ炸jAȒlǂނ悤ɁAeeNZ̒SjAXg̃Tvœǂ(sRGB̓fR[h)B
+ * [NO[vł͋Lŕ_̂܂܍vAvobt@ւ̓O[vƂ1񂾂ZB
+ * vobt@̍vĺÅp̏d݂Ŝ1ɐKl2^48{64biťŒ菬_ŁA
+ * ʁE32bit̑gɕĕێBÂeNZ̊ۂߌ덷HDR̒l̂ӂ邽߁B
+ * ΐPx log2(kMinLuminance) ̍(0ȏ)v
+ */
+#define LUMINANCE_REDUCE_STEP(n) \
+	"	if (li < " #n ") reduce(li, " #n ");\n" \
+	"	barrier();\n"
+static const char* const kCSLuminanceStats =
+	"layout(local_size_x = 16, local_size_y = 16) in;\n"
+	"uniform highp samplerCube uSrc;\n"
+	"uniform int uSize;\n"
+	"uniform float uMinLog2Lum;\n"
+	"uniform float uMaxLog2Lum;\n"
+	"layout(std430, binding = 0) buffer StatsBuffer {\n"
+	"	uint minLumBits;\n"
+	"	uint maxLumBits;\n"
+	"	uint reserved[2];\n"
+	"	uint sums[134];\n"
+	"} uStats;\n"
+	"shared float sWeight[256], sLum[256], sLog2Lum[256], sMinLum[256], sMaxLum[256];\n"
+	"shared int sBin[256];\n"
+	"const float kMinLog2Lum = -16.0;\n"
+	"void reduce(int i, int s) {\n"
+	"	sWeight[i] += sWeight[i + s];\n"
+	"	sLum[i] += sLum[i + s];\n"
+	"	sLog2Lum[i] += sLog2Lum[i + s];\n"
+	"	sMinLum[i] = min(sMinLum[i], sMinLum[i + s]);\n"
+	"	sMaxLum[i] = max(sMaxLum[i], sMaxLum[i + s]);\n"
+	"}\n"
+	"void addFixed(int i, float x) {\n"
+	"	float v = x * 65536.0;\n"
+	"	float hi = floor(v);\n"
+	"	uint lo = uint((v - hi) * 4294967296.0);\n"
+	"	uint prev = atomicAdd(uStats.sums[i * 2], lo);\n"
+	"	atomicAdd(uStats.sums[i * 2 + 1], uint(hi) + (prev + lo < prev ? 1u : 0u));\n"
+	"}\n"
+	"void main() {\n"
+	"	int li = int(gl_LocalInvocationIndex);\n"
+	"	ivec2 t = ivec2(gl_GlobalInvocationID.xy);\n"
+	"	float w = 0.0, lum = 0.0, log2Lum = kMinLog2Lum;\n"
+	"	int bin = -1;\n"
+	"	if (t.x < uSize && t.y < uSize) {\n"
+	"		vec2 uv = (vec2(t) + 0.5) / float(uSize);\n"
+	"		vec3 c = textureLod(uSrc, faceUVToDir(int(gl_GlobalInvocationID.z), uv), 0.0).rgb;\n"
+	"		lum = max(dot(c, vec3(0.2126, 0.7152, 0.0722)), 0.0);\n"
+	"		log2Lum = log2(max(lum, exp2(kMinLog2Lum)));\n"
+	"		vec2 st = uv * 2.0 - 1.0;\n"
+	"		float r2 = 1.0 + dot(st, st);\n"
+	"		w = 4.0 / (float(uSize) * float(uSize) * r2 * sqrt(r2)) / (4.0 * PI);\n"
+	"		bin = clamp(int((log2Lum - uMinLog2Lum) / (uMaxLog2Lum - uMinLog2Lum) * 64.0), 0, 63);\n"
+	"	}\n"
+	"	sWeight[li] = w;\n"
+	"	sLum[li] = w * lum;\n"
+	"	sLog2Lum[li] = w * (log2Lum - kMinLog2Lum);\n"
+	"	sMinLum[li] = bin < 0 ? 3.0e38 : lum;\n"
+	"	sMaxLum[li] = lum;\n"
+	"	sBin[li] = bin;\n"
+	"	barrier();\n"
+	// qXgÓArƂ̒SO[v̑SeNZ𑖍čv
+	"	float binSum = 0.0;\n"
+	"	if (li < 64) {\n"
+	"		for (int i=0; i<256; ++i) if (sBin[i] == li) binSum += sWeight[i];\n"
+	"	}\n"
+	"	barrier();\n"
+	// ESł̓[vbarrieruȂ̂ŁAiƂɓWJ
+	LUMINANCE_REDUCE_STEP(128)
+	LUMINANCE_REDUCE_STEP(64)
+	LUMINANCE_REDUCE_STEP(32)
+	LUMINANCE_REDUCE_STEP(16)
+	LUMINANCE_REDUCE_STEP(8)
+	LUMINANCE_REDUCE_STEP(4)
+	LUMINANCE_REDUCE_STEP(2)
+	LUMINANCE_REDUCE_STEP(1)
+	"	if (li == 0) {\n"
+	"		atomicMin(uStats.minLumBits, floatBitsToUint(sMinLum[0]));\n"
+	"		atomicMax(uStats.maxLumBits, floatBitsToUint(sMaxLum[0]));\n"
+	"		addFixed(0, sWeight[0]);\n"
+	"		addFixed(1, sLum[0]);\n"
+	"		addFixed(2, sLog2Lum[0]);\n"
+	"	}\n"
+	"	if (li < 64 && 0.0 < binSum) addFixed(3 + li, binSum);\n"
+	"}\n";
+#undef LUMINANCE_REDUCE_STEP
+
+/** kCSLuminanceStats ̓vobt@̃CAEg */
+struct GLLuminanceStatsBuffer
+{
+	GLuint minLumBits, maxLumBits;
+	GLuint reserved[2];
+	/** d݁EPxEΐPxEeȑ̍vBʁE32bit̑gŁAVF[_ sums Ɠ傫 */
+	GLuint sums[2 * (3 + kLuminanceHistogramBinCount)];
+
+	/** Œ菬_̍vlo */
+	double sum(int i) const { return ((double)sums[i * 2 + 1] * 4294967296.0 + sums[i * 2]) / 281474976710656.0; }
+};
+
 #endif
 
 
@@ -35,6 +232,38 @@ public:
 	RenderAPI_OpenGLCoreES(UnityGfxRenderer apiType)
 		: _apiType(apiType)
 		, _frameBuffer(NULL)
+		, _isTuningCopy(false)
+#if SUPPORT_OPENGL_SHADER_OPS
+		, _isShaderResReady(false)
+		, _shaderFrameBuffer(0)
+		, _emptyVAO(0)
+		, _samplerClamp(0)
+		, _samplerRepeatU(0)
+		, _cube2ProjProgram(0)
+		, _proj2CubeProgram(0)
+		, _rotateProgram(0)
+		, _fixupSeamsProgram(0)
+		, _blurProgram(0)
+		, _samplerNearest(0)
+		, _scratchCubemap(0)
+		, _scratchCubemapSize(0)
+		, _scratchCubemapMipCnt(0)
+		, _scratchCubemapFormat(0)
+		, _copyProgram(0)
+		, _copyImageState(0)
+#endif
+#if SUPPORT_OPENGL_COMPUTE
+		, _luminanceStatsProgram(0)
+		, _luminanceStatsBuffer(0)
+		, _luminanceStatsFence(0)
+		, _isLuminanceStatsReady(false)
+#endif
+#if SUPPORT_OPENGL_WORKER
+		, _isWorkerUnavailable(false)
+#endif
+#if SUPPORT_OPENGL_TIMER_QUERY
+		, _gpuTimerState(0)
+#endif
 	{}
 	virtual ~RenderAPI_OpenGLCoreES() {}
 
@@ -44,6 +273,14 @@ public:
 			CreateResources();
 			break;
 		case kUnityGfxDeviceEventShutdown:
+#if SUPPORT_OPENGL_WORKER
+			_worker.stop();
+#endif
+#if SUPPORT_OPENGL_TIMER_QUERY
+			releaseGpuTimers();
+#endif
+			// foCX̃ZbĝтɃ[NȂ悤ɁA쐬ׂ̂͂Ĕj
+			ReleaseResources();
 			break;
 		}
 	}
@@ -74,9 +311,15 @@ public:
 //		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
 //		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
 
-		// TextureeʂBlit
+		// TextureeʂɃRs[B@͏̌vő傫ƂɑI񂾂
+#if SUPPORT_OPENGL_SHADER_OPS
+		const int strategy = _copyTuning.select(texWidth);
+#else
+		const int strategy = 0;
+#endif
 		for (int i=0; i<6; ++i) {
-			blitTexByFrameBuffer(
+			copyTex(
+				strategy,
 				srcTexs[i],
 				GL_TEXTURE_2D,
 				dstTex,
@@ -86,9 +329,666 @@ public:
 		}
 	}
 
+	virtual bool convertCubemapToProjection(
+		void* cubemapTex,
+		void* dstTex,
+		int dstWidth,
+		int dstHeight,
+		int projection
+	) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		GLuint program = getFullscreenProgram(&_cube2ProjProgram, kFSCubemapToProjection);
+		if (program == 0) return false;
+
+		GLStateScope stateScope(_apiType);
+		bindShaderTarget( GL_TEXTURE_2D, toGLTex(dstTex), dstWidth, dstHeight );
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "uProjection"), projection);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, toGLTex(cubemapTex));
+		glBindSampler(0, _samplerClamp);
+
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool convertProjectionToCubemap(
+		void* srcTex,
+		void* cubemapTex,
+		int cubemapSize,
+		int projection
+	) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		GLuint program = getFullscreenProgram(&_proj2CubeProgram, kFSProjectionToCubemap);
+		if (program == 0) return false;
+
+		GLStateScope stateScope(_apiType);
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "uProjection"), projection);
+		GLint faceLoc = glGetUniformLocation(program, "uFace");
+		glBindTexture(GL_TEXTURE_2D, toGLTex(srcTex));
+		glBindSampler(0, projection == kProjectionEquirect ? _samplerRepeatU : _samplerClamp);
+
+		// eʂɕ`悷
+		for (int i=0; i<6; ++i) {
+			bindShaderTarget( GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, toGLTex(cubemapTex), cubemapSize, cubemapSize );
+			glUniform1i(faceLoc, i);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool rotateCubemap(
+		void* srcCubemapTex,
+		void* dstCubemapTex,
+		int size,
+		const float* rotation
+	) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		GLuint program = getFullscreenProgram(&_rotateProgram, kFSRotateCubemap);
+		if (program == 0) return false;
+
+		// eNX`ǂݏ邱Ƃ͂łȂ̂ŁȀōXVꍇ͈ꎞL[u}bvɕ`悵Ă珑߂
+		// ꎞL[u}bv́AHDRsRGB̐x𗎂ƂȂ悤ɌƓ`ɂ
+		const bool isInPlace = srcCubemapTex == dstCubemapTex;
+		GLuint renderTgt = isInPlace
+			? getScratchCubemap(size, 1, getTexInternalFormat(toGLTex(srcCubemapTex), GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0))
+			: toGLTex(dstCubemapTex);
+
+		{
+			GLStateScope stateScope(_apiType);
+
+			glUseProgram(program);
+			glUniformMatrix3fv(glGetUniformLocation(program, "uRotation"), 1, GL_TRUE, rotation);
+			GLint faceLoc = glGetUniformLocation(program, "uFace");
+			glBindTexture(GL_TEXTURE_CUBE_MAP, toGLTex(srcCubemapTex));
+			glBindSampler(0, _samplerClamp);
+
+			for (int i=0; i<6; ++i) {
+				bindShaderTarget( GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, renderTgt, size, size );
+				glUniform1i(faceLoc, i);
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+			}
+		}
+
+		if (isInPlace) {
+			for (int i=0; i<6; ++i) {
+				copyTex(
+					_copyTuning.select(size),
+					renderTgt,
+					GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+					toGLTex(dstCubemapTex),
+					GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+					size
+				);
+			}
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool fixupCubemapSeams(
+		void* cubemapTex,
+		int size,
+		int mipCount
+	) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		GLuint program = getFullscreenProgram(&_fixupSeamsProgram, kFSFixupCubemapSeams);
+		if (program == 0) return false;
+
+		// ꎞL[u}bvɏCʂ`悵ĂÃL[u}bv֏߂B
+		// ߂ŒlςȂ悤ɁAꎞL[u}bv͌Ɠ`ɂ
+		GLuint tex = toGLTex(cubemapTex);
+		GLuint scratch = getScratchCubemap(size, mipCount, getTexInternalFormat(tex, GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0));
+
+		{
+			GLStateScope stateScope(_apiType);
+
+			glUseProgram(program);
+			GLint faceLoc = glGetUniformLocation(program, "uFace");
+			GLint levelLoc = glGetUniformLocation(program, "uLevel");
+			GLint sizeLoc = glGetUniformLocation(program, "uSize");
+			glBindTexture(GL_TEXTURE_CUBE_MAP, tex);
+			glBindSampler(0, _samplerNearest);
+
+			for (int level=0; level<mipCount; ++level) {
+				int levelSize = size >> level;
+				if (levelSize < 1) break;
+				glUniform1f(levelLoc, (float)level);
+				glUniform1f(sizeLoc, (float)levelSize);
+				for (int i=0; i<6; ++i) {
+					bindShaderTarget( GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, scratch, levelSize, levelSize, level );
+					glUniform1i(faceLoc, i);
+					glDrawArrays(GL_TRIANGLES, 0, 3);
+				}
+			}
+		}
+
+		for (int level=0; level<mipCount; ++level) {
+			int levelSize = size >> level;
+			if (levelSize < 1) break;
+			for (int i=0; i<6; ++i) {
+				copyTex(
+					_copyTuning.select(levelSize),
+					scratch, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+					tex, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+					levelSize, level
+				);
+			}
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool blurCubemap(
+		void* srcCubemapTex,
+		void* dstCubemapTex,
+		int size,
+		float sigma
+	) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		GLuint program = getFullscreenProgram(&_blurProgram, kFSBlurCubemap);
+		if (program == 0) return false;
+
+		float weights[kMaxBlurRadius + 1];
+		int radius = computeGaussianWeights(sigma, size, weights);
+
+		// ͈ꎞL[u}bvցAc͂o͐֕`悷B
+		// 2pXڂ͈ꎞL[u}bv̂ݎQƂ̂ŁAsrcdstłȂB
+		// HDR̒l1pXڂŖOaȂ悤ɁAꎞL[u}bv͌Ɠ`ɂ
+		GLuint srcTex = toGLTex(srcCubemapTex);
+		GLuint passSrc[2] = { srcTex, getScratchCubemap(size, 1, getTexInternalFormat(srcTex, GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0)) };
+		GLuint passDst[2] = { passSrc[1], toGLTex(dstCubemapTex) };
+
+		GLStateScope stateScope(_apiType);
+
+		glUseProgram(program);
+		GLint faceLoc = glGetUniformLocation(program, "uFace");
+		GLint axisLoc = glGetUniformLocation(program, "uAxis");
+		glUniform1f( glGetUniformLocation(program, "uSize"), (float)size );
+		glUniform1i( glGetUniformLocation(program, "uRadius"), radius );
+		glUniform1fv( glGetUniformLocation(program, "uWeights"), radius + 1, weights );
+		glBindSampler(0, _samplerNearest);
+
+		for (int pass=0; pass<2; ++pass) {
+			glBindTexture(GL_TEXTURE_CUBE_MAP, passSrc[pass]);
+			glUniform2f(axisLoc, pass == 0 ? 1.0f : 0.0f, pass == 0 ? 0.0f : 1.0f);
+			for (int i=0; i<6; ++i) {
+				bindShaderTarget( GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, passDst[pass], size, size );
+				glUniform1i(faceLoc, i);
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+			}
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool computeLuminanceStats(
+		void* cubemapTex,
+		int size,
+		float minLog2Lum,
+		float maxLog2Lum
+	) {
+#if SUPPORT_OPENGL_COMPUTE
+		if (!isGLComputeSupported(_apiType)) return false;
+		if (_luminanceStatsProgram == 0) {
+			const char* cs[] = { getGLSLComputeHeader(_apiType), kGLSLCubeMath, kCSLuminanceStats };
+			_luminanceStatsProgram = createGLComputeProgram(cs, 3);
+			if (_luminanceStatsProgram == 0) return false;
+		}
+
+		// vobt@lŖ߂ĂWv
+		GLLuminanceStatsBuffer init = {};
+		init.minLumBits = 0x7f7fffff;
+		if (_luminanceStatsBuffer == 0) glGenBuffers(1, &_luminanceStatsBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, _luminanceStatsBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(init), &init, GL_DYNAMIC_READ);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _luminanceStatsBuffer);
+
+		// ǂݍ݂̓eNX`jbg0ōŝŁAUnitỹoChۑĂ
+		prepareShaderResources();
+		GLint lastProgram = 0, lastActiveTex = 0, lastTex = 0, lastSampler = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &lastProgram);
+		glGetIntegerv(GL_ACTIVE_TEXTURE, &lastActiveTex);
+		glActiveTexture(GL_TEXTURE0);
+		glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &lastTex);
+		glGetIntegerv(GL_SAMPLER_BINDING, &lastSampler);
+		glUseProgram(_luminanceStatsProgram);
+		glUniform1i( glGetUniformLocation(_luminanceStatsProgram, "uSrc"), 0 );
+		glUniform1i( glGetUniformLocation(_luminanceStatsProgram, "uSize"), size );
+		glUniform1f( glGetUniformLocation(_luminanceStatsProgram, "uMinLog2Lum"), minLog2Lum );
+		glUniform1f( glGetUniformLocation(_luminanceStatsProgram, "uMaxLog2Lum"), maxLog2Lum );
+		glBindTexture(GL_TEXTURE_CUBE_MAP, toGLTex(cubemapTex));
+		glBindSampler(0, _samplerNearest);
+
+		GLuint groupCnt = (GLuint)( (size + 15) / 16 );
+		glDispatchCompute(groupCnt, groupCnt, 6);
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+		// 擾ɑ҂Ɋ₢킹悤ɁAtFX}GPU֑Ă
+		if (_luminanceStatsFence) glDeleteSync(_luminanceStatsFence);
+		_luminanceStatsFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		glBindSampler(0, lastSampler);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, lastTex);
+		glActiveTexture(lastActiveTex);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glUseProgram(lastProgram);
+
+		_luminanceStatsRange[0] = minLog2Lum;
+		_luminanceStatsRange[1] = maxLog2Lum;
+		_isLuminanceStatsReady = true;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool getLuminanceStats(CubemapLuminanceStats* out) {
+#if SUPPORT_OPENGL_COMPUTE
+		if (!_isLuminanceStatsReady) return false;
+
+		// WvGPUŏIĂȂ΁A}bvő҂ɎsƂ(̃t[ȍ~ɍēx擾)
+		if (_luminanceStatsFence) {
+			if (glClientWaitSync(_luminanceStatsFence, 0, 0) == GL_TIMEOUT_EXPIRED) return false;
+			glDeleteSync(_luminanceStatsFence);
+			_luminanceStatsFence = 0;
+		}
+
+		// vobt@(SoCg)̂ݓǂݖ߂
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, _luminanceStatsBuffer);
+		const GLLuminanceStatsBuffer* buf = static_cast<const GLLuminanceStatsBuffer*>(
+			glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLLuminanceStatsBuffer), GL_MAP_READ_BIT)
+		);
+		if (!buf) {
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			return false;
+		}
+
+		const double sumWeight = buf->sum(0) <= 0 ? 1 : buf->sum(0);
+		const float minLog2 = log2f(kMinLuminance);
+		memcpy(&out->minLuminance, &buf->minLumBits, sizeof(float));
+		memcpy(&out->maxLuminance, &buf->maxLumBits, sizeof(float));
+		out->averageLuminance = (float)(buf->sum(1) / sumWeight);
+		out->logAverageLuminance = exp2f( (float)(buf->sum(2) / sumWeight) + minLog2 );
+		out->minLog2Luminance = _luminanceStatsRange[0];
+		out->maxLog2Luminance = _luminanceStatsRange[1];
+		for (int i=0; i<kLuminanceHistogramBinCount; ++i)
+			out->histogram[i] = (float)(buf->sum(3 + i) / sumWeight);
+
+		glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool getTextureInfo(void* tex, bool isCubemap, int* width, int* height, int* mipCount, int* format) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		const GLenum bindTgt = isCubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+		const GLenum levelTgt = isCubemap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : GL_TEXTURE_2D;
+		GLint lastTex = 0;
+		glGetIntegerv(isCubemap ? GL_TEXTURE_BINDING_CUBE_MAP : GL_TEXTURE_BINDING_2D, &lastTex);
+		glBindTexture(bindTgt, toGLTex(tex));
+
+		GLint w = 0, h = 0, internalFormat = 0, levels = 0;
+		glGetTexLevelParameteriv(levelTgt, 0, GL_TEXTURE_WIDTH, &w);
+		glGetTexLevelParameteriv(levelTgt, 0, GL_TEXTURE_HEIGHT, &h);
+		glGetTexLevelParameteriv(levelTgt, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+#if SUPPORT_OPENGL_TEXTURE_STORAGE && defined(GL_TEXTURE_IMMUTABLE_LEVELS)
+		// ~bvm肷͕̂ύXsȃXg[W̏ꍇ̂
+		if (isGLTextureStorageSupported(_apiType)) {
+			GLint isImmutable = 0;
+			glGetTexParameteriv(bindTgt, GL_TEXTURE_IMMUTABLE_FORMAT, &isImmutable);
+			if (isImmutable) glGetTexParameteriv(bindTgt, GL_TEXTURE_IMMUTABLE_LEVELS, &levels);
+		}
+#endif
+		glBindTexture(bindTgt, lastTex);
+		if (w <= 0 || h <= 0) return false;
+
+		*width = w;
+		*height = h;
+		*mipCount = levels;
+		switch (internalFormat) {
+		case GL_RGBA8 : *format = kPixelFormatRGBA8; break;
+		case GL_SRGB8_ALPHA8 : *format = kPixelFormatRGBA8_SRGB; break;
+		case GL_RGBA16F : *format = kPixelFormatRGBAHalf; break;
+		default : *format = -1; break;
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool uploadCubemapLevel(
+		void* cubemapTex,
+		int level,
+		int levelSize,
+		int format,
+		const void* faces
+	) {
+		GLenum type = GL_UNSIGNED_BYTE;
+		if (format == kPixelFormatRGBAHalf) {
+#ifdef GL_HALF_FLOAT
+			type = GL_HALF_FLOAT;
+#else
+			return false;
+#endif
+		} else if (pixelFormatBytes(format) != 4) {
+			return false;
+		}
+
+		// UnitỹApbNݒɉeȂ悤ɁAlɂĂ]
+		GLint lastTex = 0, lastAlign = 0;
+		glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &lastTex);
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &lastAlign);
+#ifdef GL_PIXEL_UNPACK_BUFFER
+		GLint lastUnpackBuf = 0, lastRowLength = 0;
+		glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &lastUnpackBuf);
+		glGetIntegerv(GL_UNPACK_ROW_LENGTH, &lastRowLength);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, toGLTex(cubemapTex));
+		const size_t faceBytes = cubemapFaceBytes(levelSize, 0, format);
+		for (int i=0; i<6; ++i) {
+			glTexSubImage2D(
+				GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level,
+				0, 0, levelSize, levelSize,
+				GL_RGBA, type, static_cast<const unsigned char*>(faces) + faceBytes * i
+			);
+		}
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, lastTex);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, lastAlign);
+#ifdef GL_PIXEL_UNPACK_BUFFER
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, lastUnpackBuf);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, lastRowLength);
+#endif
+		return true;
+	}
+
+	virtual void* createCubemap(int size, int mipCount, int format) {
+#if SUPPORT_OPENGL_TEXTURE_STORAGE
+		if (!isGLTextureStorageSupported(_apiType)) return NULL;
+
+		GLenum internalFormat;
+		switch (format) {
+		case kPixelFormatRGBA8 : internalFormat = GL_RGBA8; break;
+		case kPixelFormatRGBA8_SRGB : internalFormat = GL_SRGB8_ALPHA8; break;
+		case kPixelFormatRGBAHalf : internalFormat = GL_RGBA16F; break;
+		default : return NULL;
+		}
+
+		GLint lastTex = 0;
+		glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &lastTex);
+
+		GLuint tex = 0;
+		glGenTextures(1, &tex);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, tex);
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, mipCount, internalFormat, size, size);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, mipCount <= 1 ? GL_LINEAR : GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		// Xg[W̊mۂɎsꍇ́AύXs̏ԂɂȂĂȂ
+		GLint isImmutable = 0;
+		glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_IMMUTABLE_FORMAT, &isImmutable);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, lastTex);
+		if (!isImmutable) {
+			glDeleteTextures(1, &tex);
+			return NULL;
+		}
+		return (void*)(size_t)tex;
+#else
+		return NULL;
+#endif
+	}
+
+	virtual bool destroyCubemap(void* cubemapTex) {
+		GLuint tex = toGLTex(cubemapTex);
+		glDeleteTextures(1, &tex);
+		return true;
+	}
+
+	virtual bool createCubemapFaceViews(void* cubemapTex, void** outFaceTexs) {
+#if SUPPORT_OPENGL_TEXTURE_VIEW
+		if (!isGLTextureViewSupported(_apiType)) return false;
+
+		// r[̌`E~bvi͌̃L[u}bvɍ킹
+		GLint lastTex = 0, isImmutable = 0, levels = 0, internalFormat = 0;
+		glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &lastTex);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, toGLTex(cubemapTex));
+		glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_IMMUTABLE_FORMAT, &isImmutable);
+		glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_IMMUTABLE_LEVELS, &levels);
+		glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, lastTex);
+		if (!isImmutable || levels <= 0) return false;
+
+		// r[ɂeNX`́AxoChĂȂ̂łKv
+		GLuint views[6] = {};
+		glGenTextures(6, views);
+		for (int i=0; i<6; ++i) {
+			glTextureView(views[i], GL_TEXTURE_2D, toGLTex(cubemapTex), internalFormat, 0, levels, i, 1);
+			outFaceTexs[i] = (void*)(size_t)views[i];
+		}
+
+		// 쐬Ɏŝ́Ar[ƂďĂȂ
+		GLint lastTex2D = 0, isView = 0;
+		glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTex2D);
+		glBindTexture(GL_TEXTURE_2D, views[5]);
+		glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT, &isView);
+		glBindTexture(GL_TEXTURE_2D, lastTex2D);
+		if (!isView) {
+			glDeleteTextures(6, views);
+			for (int i=0; i<6; ++i) outFaceTexs[i] = NULL;
+			return false;
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	virtual bool destroyTextureView(void* viewTex) {
+		GLuint tex = toGLTex(viewTex);
+		glDeleteTextures(1, &tex);
+		return true;
+	}
+
+	virtual bool runAsync(
+		const std::function<bool()>& job,
+		const std::function<void(bool succeeded)>& completion
+	) {
+#if SUPPORT_OPENGL_WORKER
+		// [J[͏gpɊJnBLReLXg쐬łȂł͈Ȍ㎎݂Ȃ
+		if (_isWorkerUnavailable) return false;
+		if (!_worker.isRunning() && !_worker.start()) {
+			_isWorkerUnavailable = true;
+			return false;
+		}
+		return _worker.submit(job, completion);
+#else
+		return false;
+#endif
+	}
+
+	virtual void pollAsync() {
+#if SUPPORT_OPENGL_WORKER
+		_worker.pollCompletions();
+#endif
+	}
+
+	virtual void* insertFence() {
+#if SUPPORT_OPENGL_SHADER_OPS
+		// ҂ɖ₢킹邾Ȃ̂ŁAtFXGPU֑悤ɖIɃtbVĂ
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+		return fence;
+#else
+		return NULL;
+#endif
+	}
+
+	virtual int queryFence(void* fence) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		switch (glClientWaitSync(static_cast<GLsync>(fence), 0, 0)) {
+		case GL_ALREADY_SIGNALED :
+		case GL_CONDITION_SATISFIED : return 1;
+		case GL_TIMEOUT_EXPIRED : return 0;
+		default : return -1;
+		}
+#else
+		return -1;
+#endif
+	}
+
+	virtual void destroyFence(void* fence) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		glDeleteSync(static_cast<GLsync>(fence));
+#endif
+	}
+
+	/** ̑OɃ^CX^vL^BGL_TIME_ELAPSED ƈႢAUnity̌vƏdȂĂȂ */
+	virtual void beginGpuTimer(int op, int size) {
+#if SUPPORT_OPENGL_TIMER_QUERY
+		if (!prepareGpuTimers()) return;
+		pollGpuTimers();
+		auto e = _gpuTimers.begin(op, size);
+		if (e) glQueryCounter(e->query.timestamps[0], GL_TIMESTAMP);
+#endif
+	}
+
+	virtual void endGpuTimer() {
+#if SUPPORT_OPENGL_TIMER_QUERY
+		if (_gpuTimerState != 1 || isOnWorkerThread()) return;
+		auto e = _gpuTimers.end();
+		if (e) glQueryCounter(e->query.timestamps[1], GL_TIMESTAMP);
+#endif
+	}
+
+	virtual void pollGpuTimers() {
+#if SUPPORT_OPENGL_TIMER_QUERY
+		if (_gpuTimerState != 1 || isOnWorkerThread()) return;
+		while (auto e = _gpuTimers.front()) {
+			// ɋL^ǂݖ߂悤ɂȂĂ΁AO̕ǂݖ߂
+			GLint isAvailable = 0;
+			glGetQueryObjectiv(e->query.timestamps[1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+			if (!isAvailable) break;
+
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(e->query.timestamps[0], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(e->query.timestamps[1], GL_QUERY_RESULT, &end);
+			_gpuTimers.pop(end - begin, begin <= end);
+		}
+#endif
+	}
+
 private:
 	UnityGfxRenderer _apiType;
 	GLuint _frameBuffer;
+	bool _isTuningCopy;				//!< Rs[@̌vۂBvp̃Rs[FBO̊mFʂvlɊ܂߂Ȃ
+
+#if SUPPORT_OPENGL_SHADER_OPS
+	bool _isShaderResReady;			//!< VF[_gp鏈p̃\[X쐬ς݂ۂ
+	GLuint _shaderFrameBuffer;		//!< VF[_ł̕`Ƃt[obt@
+	GLuint _emptyVAO;				//!< _Ȃŕ`悷邽߂̋VAO
+	GLuint _samplerClamp;			//!< oCjAENṽTv
+	GLuint _samplerRepeatU;			//!< oCjAEÛ݌JԂ̃Tv
+	GLuint _cube2ProjProgram;		//!< L[u}bve@ ϊp
+	GLuint _proj2CubeProgram;		//!< e@L[u}bv ϊp
+	GLuint _rotateProgram;			//!< L[u}bv]p
+	GLuint _fixupSeamsProgram;		//!< L[u}bv̌pڏCp
+	GLuint _blurProgram;			//!< L[u}bv̂ڂp
+	GLuint _samplerNearest;			//!< jAXgE~bvw̃Tv
+	GLuint _scratchCubemap;			//!< ̏ōXV鏈p̈ꎞL[u}bv
+	int _scratchCubemapSize;
+	int _scratchCubemapMipCnt;
+	GLenum _scratchCubemapFormat;
+	GLCopyTuning _copyTuning;		//!< 傫ƂɑI񂾃eNX`̃Rs[@
+	GLuint _copyProgram;			//!< Sʕ`ɂeNX`̃Rs[p
+	int _copyImageState;			//!< glCopyImageSubData  0:mF 1:gp\ -1:Ή
+#endif
+
+#if SUPPORT_OPENGL_COMPUTE
+	GLuint _luminanceStatsProgram;	//!< Pxv̏Wvp
+	GLuint _luminanceStatsBuffer;	//!< Pxv̏Wṽobt@
+	GLsync _luminanceStatsFence;	//!< ߂̏Wv̊tFXB擾ɊmFj
+	float _luminanceStatsRange[2];	//!< ߂̏WṽqXgO͈̔(log2Px)
+	bool _isLuminanceStatsReady;	//!< Wvς݂̋Pxv邩ۂ
+#endif
+
+#if SUPPORT_OPENGL_WORKER
+	GLWorker _worker;				//!< runAsync ̏sALReLXg[J[Xbh
+	bool _isWorkerUnavailable;		//!< LReLXg쐬łȂۂ
+#endif
+
+#if SUPPORT_OPENGL_TIMER_QUERY
+	struct GLTimerQuery
+	{
+		GLuint timestamps[2];		//!< ̑OẼ^CX^v
+	};
+	GpuTimerQueue<GLTimerQuery> _gpuTimers;
+	int _gpuTimerState;				//!< 0:mF 1:gp\ -1:Ή
+#endif
+
+	/** [J[XbhĂ΂Ă邩ۂB[J[̃ReLXgł́A_[Xbhp̃IuWFNggȂ */
+	bool isOnWorkerThread() const {
+#if SUPPORT_OPENGL_WORKER
+		return _worker.isWorkerThread();
+#else
+		return false;
+#endif
+	}
+
+#if SUPPORT_OPENGL_TIMER_QUERY
+	/** GPUԂ̌vp̃NGAgpɍ쐬BvłȂꍇfalse */
+	bool prepareGpuTimers() {
+		if (isOnWorkerThread()) return false;
+		if (_gpuTimerState == 0) {
+			_gpuTimerState = isGLTimerQuerySupported(_apiType) ? 1 : -1;
+			if (_gpuTimerState == 1) {
+				auto entries = _gpuTimers.entries();
+				for (int i=0; i<_gpuTimers.capacity(); ++i)
+					glGenQueries(2, entries[i].query.timestamps);
+			}
+			setGpuTimerSupported(_gpuTimerState == 1);
+		}
+		return _gpuTimerState == 1;
+	}
+
+	/** GPUԂ̌vp̃NGjBʂ҂Ă͎̂̂Ă */
+	void releaseGpuTimers() {
+		if (_gpuTimerState == 1) {
+			auto entries = _gpuTimers.entries();
+			for (int i=0; i<_gpuTimers.capacity(); ++i)
+				glDeleteQueries(2, entries[i].query.timestamps);
+		}
+		_gpuTimers.clear();
+		_gpuTimerState = 0;
+		setGpuTimerSupported(false);
+	}
+#endif
 
 	/** ̃NXŎgp郊\[Xނŏɍ쐬鏈 */
 	void CreateResources() {
@@ -98,21 +998,287 @@ private:
 		#	endif
 
 		glGenFramebuffers(1, &_frameBuffer);
+
+#if SUPPORT_OPENGL_SHADER_OPS
+		// ǂ̃Rs[@̓hCoɂđ傫قȂ̂ŁAvđIłB
+		// vʂGPUEhCoƂɕۑ̂ŁAv̂͏̂
+		_isTuningCopy = true;
+		_copyTuning = tuneGLCopy([this](int strategy, GLuint srcTex, GLuint dstCubemapTex, int face, int size) {
+			return tryCopyTex(strategy, srcTex, GL_TEXTURE_2D, dstCubemapTex, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, size);
+		});
+		_isTuningCopy = false;
+#endif
 	}
 
 	/** ̃NXŎgp郊\[XނŌɔj鏈 */
 	void ReleaseResources() {
 		glDeleteFramebuffers(1, &_frameBuffer);
 		_frameBuffer = NULL;
+
+#if SUPPORT_OPENGL_SHADER_OPS
+		if (_isShaderResReady) {
+			glDeleteFramebuffers(1, &_shaderFrameBuffer);
+			glDeleteVertexArrays(1, &_emptyVAO);
+			glDeleteSamplers(1, &_samplerClamp);
+			glDeleteSamplers(1, &_samplerRepeatU);
+			glDeleteProgram(_cube2ProjProgram);
+			glDeleteProgram(_proj2CubeProgram);
+			glDeleteProgram(_rotateProgram);
+			glDeleteProgram(_fixupSeamsProgram);
+			glDeleteProgram(_blurProgram);
+			glDeleteProgram(_copyProgram);
+			glDeleteSamplers(1, &_samplerNearest);
+			glDeleteTextures(1, &_scratchCubemap);
+			// ̃foCX̏ɍ蒼悤ɁAׂĖ쐬̏Ԃɖ߂
+			_shaderFrameBuffer = _emptyVAO = 0;
+			_samplerClamp = _samplerRepeatU = _samplerNearest = 0;
+			_cube2ProjProgram = _proj2CubeProgram = _rotateProgram = _fixupSeamsProgram = _blurProgram = _copyProgram = 0;
+			_scratchCubemap = 0;
+			_scratchCubemapSize = _scratchCubemapMipCnt = 0;
+			_scratchCubemapFormat = 0;
+			_isShaderResReady = false;
+		}
+		_copyImageState = 0;
+#endif
+#if SUPPORT_OPENGL_COMPUTE
+		glDeleteProgram(_luminanceStatsProgram);
+		glDeleteBuffers(1, &_luminanceStatsBuffer);
+		if (_luminanceStatsFence) glDeleteSync(_luminanceStatsFence);
+		_luminanceStatsProgram = 0;
+		_luminanceStatsFence = 0;
+		_luminanceStatsBuffer = 0;
+		_isLuminanceStatsReady = false;
+#endif
+	}
+
+#if SUPPORT_OPENGL_SHADER_OPS
+	/**
+	 * VF[_gp鏈ŋʂ̃\[XB
+	 * gpȂꍇ̓RXg𕥂Ȃ悤ɁAgpɍ쐬
+	 */
+	void prepareShaderResources() {
+		if (_isShaderResReady) return;
+		_isShaderResReady = true;
+
+		glGenFramebuffers(1, &_shaderFrameBuffer);
+		glGenVertexArrays(1, &_emptyVAO);
+
+		glGenSamplers(1, &_samplerClamp);
+		glSamplerParameteri(_samplerClamp, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glSamplerParameteri(_samplerClamp, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glSamplerParameteri(_samplerClamp, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(_samplerClamp, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(_samplerClamp, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		glGenSamplers(1, &_samplerRepeatU);
+		glSamplerParameteri(_samplerRepeatU, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glSamplerParameteri(_samplerRepeatU, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glSamplerParameteri(_samplerRepeatU, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glSamplerParameteri(_samplerRepeatU, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glGenSamplers(1, &_samplerNearest);
+		glSamplerParameteri(_samplerNearest, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glSamplerParameteri(_samplerNearest, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glSamplerParameteri(_samplerNearest, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(_samplerNearest, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(_samplerNearest, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 	}
 
-	/** t[obt@gpāAeNX`Rs[ */
-	void blitTexByFrameBuffer(
+	/**
+	 * tOgVF[_{̂w肵āASʕ`p̃vO擾B
+	 * vO͏gpɍ쐬āAprogramɃLbVB쐬Ɏsꍇ0Ԃ
+	 */
+	GLuint getFullscreenProgram(GLuint* program, const char* fsBody) {
+		prepareShaderResources();
+		if (*program != 0) return *program;
+
+		const char* header = getGLSLHeader(_apiType);
+		const char* vs[] = { header, kGLSLFullscreenVS };
+		const char* fs[] = { header, kGLSLCubeMath, fsBody };
+		*program = createGLProgram(vs, 2, fs, 3);
+		return *program;
+	}
+
+	/**
+	 * ̏ōXV鏈ṕAwTCYE~bvE`̈ꎞL[u}bv擾B
+	 * `Ȃ(0)ꍇRGBA8Ƃ
+	 */
+	GLuint getScratchCubemap(int size, int mipCount = 1, GLenum internalFormat = GL_RGBA8) {
+		if (internalFormat == 0) internalFormat = GL_RGBA8;
+		if (
+			_scratchCubemap != 0 &&
+			_scratchCubemapSize == size &&
+			_scratchCubemapFormat == internalFormat &&
+			mipCount <= _scratchCubemapMipCnt
+		) return _scratchCubemap;
+
+		// ES̃ReLXgł͓`ɍ`E^̑gݍ킹łȂƊmۂłȂ
+		GLenum pixelFormat = GL_RGBA, pixelType = GL_UNSIGNED_BYTE;
+		switch (internalFormat) {
+		case GL_RGBA16F : pixelType = GL_HALF_FLOAT; break;
+		case GL_RGBA32F : pixelType = GL_FLOAT; break;
+		case GL_R11F_G11F_B10F : pixelFormat = GL_RGB; pixelType = GL_FLOAT; break;
+		case GL_RGB10_A2 : pixelType = GL_UNSIGNED_INT_2_10_10_10_REV; break;
+		}
+
+		if (_scratchCubemap != 0) glDeleteTextures(1, &_scratchCubemap);
+		GLint lastTex = 0;
+		glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &lastTex);
+		glGenTextures(1, &_scratchCubemap);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, _scratchCubemap);
+		for (int level=0; level<mipCount; ++level) {
+			int levelSize = size >> level;
+			if (levelSize < 1) levelSize = 1;
+			for (int i=0; i<6; ++i) {
+				glTexImage2D(
+					GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, internalFormat,
+					levelSize, levelSize, 0, pixelFormat, pixelType, NULL
+				);
+			}
+		}
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, lastTex);
+		_scratchCubemapSize = size;
+		_scratchCubemapMipCnt = mipCount;
+		_scratchCubemapFormat = internalFormat;
+		return _scratchCubemap;
+	}
+
+	static bool isCubemapFace(GLenum texTgt) {
+		return GL_TEXTURE_CUBE_MAP_POSITIVE_X <= texTgt && texTgt <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z;
+	}
+
+	/** eNX`(܂̓L[u}bv̖)̓`擾BoCh͌ɖ߂B擾łȂꍇ0 */
+	static GLenum getTexInternalFormat(GLuint tex, GLenum texTgt, int level) {
+		const bool isCube = isCubemapFace(texTgt);
+		GLint lastTex = 0;
+		glGetIntegerv(isCube ? GL_TEXTURE_BINDING_CUBE_MAP : GL_TEXTURE_BINDING_2D, &lastTex);
+		glBindTexture(isCube ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, tex);
+		GLint format = 0;
+		glGetTexLevelParameteriv(texTgt, level, GL_TEXTURE_INTERNAL_FORMAT, &format);
+		glBindTexture(isCube ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, lastTex);
+		return (GLenum)format;
+	}
+
+	/** VF[_ł̕`ƂāAw̃eNX`(܂̓L[u}bv̖)oCh */
+	void bindShaderTarget(GLenum texTgt, GLuint tex, int width, int height, int level = 0) {
+		glBindFramebuffer(GL_FRAMEBUFFER, _shaderFrameBuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texTgt, tex, level);
+		GLenum drawBuffer = GL_COLOR_ATTACHMENT0;
+		glDrawBuffers(1, &drawBuffer);
+		glViewport(0, 0, width, height);
+		glBindVertexArray(_emptyVAO);
+		glActiveTexture(GL_TEXTURE0);
+	}
+
+	/** w̕@ŃeNX`(܂̓L[u}bv̖)Rs[B̕@gȂꍇ͉falseԂ */
+	bool tryCopyTex(
+		int strategy,
 		GLuint srcTex,
 		GLenum srcTexTgt,
 		GLuint dstTex,
 		GLenum dstTexTgt,
-		int texWidth
+		int texWidth,
+		int level = 0
+	) {
+		switch (strategy) {
+		case kGLCopyStrategyBlit:
+			return blitTexByFrameBuffer(srcTex, srcTexTgt, dstTex, dstTexTgt, texWidth, level);
+		case kGLCopyStrategyCopyImage:
+			return copyTexByCopyImage(srcTex, srcTexTgt, dstTex, dstTexTgt, texWidth, level);
+		case kGLCopyStrategyDraw:
+			return copyTexByDraw(srcTex, srcTexTgt, dstTex, dstTexTgt, texWidth, level);
+		}
+		return false;
+	}
+
+	/** glCopyImageSubData ŃRs[BGL4.3ȏŁA`ꍇ̂ */
+	bool copyTexByCopyImage(
+		GLuint srcTex,
+		GLenum srcTexTgt,
+		GLuint dstTex,
+		GLenum dstTexTgt,
+		int texWidth,
+		int level
+	) {
+#if SUPPORT_OPENGL_COPY_IMAGE
+		if (_copyImageState == 0) _copyImageState = isGLCopyImageSupported(_apiType) ? 1 : -1;
+		if (_copyImageState != 1) return false;
+
+		// `ϊȂ̂ŁAsRGBƃjAȂǓ`قȂꍇBlitɔC
+		if (getTexInternalFormat(srcTex, srcTexTgt, level) != getTexInternalFormat(dstTex, dstTexTgt, level)) return false;
+
+		// L[u}bv̖ʂ́AL[u}bvŜɑ΂鉜s̈ʒuŎw肷
+		GLenum srcTarget = isCubemapFace(srcTexTgt) ? GL_TEXTURE_CUBE_MAP : srcTexTgt;
+		GLenum dstTarget = isCubemapFace(dstTexTgt) ? GL_TEXTURE_CUBE_MAP : dstTexTgt;
+		GLint srcZ = isCubemapFace(srcTexTgt) ? srcTexTgt - GL_TEXTURE_CUBE_MAP_POSITIVE_X : 0;
+		GLint dstZ = isCubemapFace(dstTexTgt) ? dstTexTgt - GL_TEXTURE_CUBE_MAP_POSITIVE_X : 0;
+		glCopyImageSubData(
+			srcTex, srcTarget, level, 0, 0, srcZ,
+			dstTex, dstTarget, level, 0, 0, dstZ,
+			texWidth, texWidth, 1
+		);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Rs[ɑSʕ`悵ăRs[B
+	 * L[u}bv̖ʂǂނɂ͖ʂƂ̏v̂ŁARs[2DeNX`̏ꍇ̂
+	 */
+	bool copyTexByDraw(
+		GLuint srcTex,
+		GLenum srcTexTgt,
+		GLuint dstTex,
+		GLenum dstTexTgt,
+		int texWidth,
+		int level
+	) {
+		if (srcTexTgt != GL_TEXTURE_2D) return false;
+		GLuint program = getFullscreenProgram(&_copyProgram, kFSCopyTexture);
+		if (program == 0) return false;
+
+		GLStateScope stateScope(_apiType);
+		bindShaderTarget( dstTexTgt, dstTex, texWidth, texWidth, level );
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "uLevel"), level);
+		glBindTexture(GL_TEXTURE_2D, srcTex);
+		// texelFetch ̓TṽtB^gȂ̂ŁAeNX`g̐ݒ̂܂܂ł悢
+		glBindSampler(0, 0);
+
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		return true;
+	}
+#endif
+
+	/** I񂾕@ŃeNX`Rs[B̕@gȂgݍ킹̏ꍇBlitŃRs[ */
+	void copyTex(
+		int strategy,
+		GLuint srcTex,
+		GLenum srcTexTgt,
+		GLuint dstTex,
+		GLenum dstTexTgt,
+		int texWidth,
+		int level = 0
+	) {
+#if SUPPORT_OPENGL_SHADER_OPS
+		if (tryCopyTex(strategy, srcTex, srcTexTgt, dstTex, dstTexTgt, texWidth, level)) return;
+#endif
+		blitTexByFrameBuffer(srcTex, srcTexTgt, dstTex, dstTexTgt, texWidth, level);
+	}
+
+	/** t[obt@gpāAeNX`Rs[Bt[obt@sSȂǂŃRs[ȂꍇfalseԂ */
+	bool blitTexByFrameBuffer(
+		GLuint srcTex,
+		GLenum srcTexTgt,
+		GLuint dstTex,
+		GLenum dstTexTgt,
+		int texWidth,
+		int level = 0
 	) {
 		// QlFhttps://gamedev.net/forums/topic/632847-how-do-i-do-opengl-texture-blitting/4990712/
 		glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffer);
@@ -120,15 +1286,20 @@ private:
 #if UNITY_ANDROID || UNITY_WEBGL
 		// TODO : ES2.0GL_COLOR_ATTACHMENT1gȂ̂ŁAփR[h
 		// QlFhttps://stackoverflow.com/questions/25439137/alternative-for-glblitframebuffer-in-opengl-es-2-0
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		return false;
 #else
 		// attach the textures to the frame buffer
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, srcTexTgt, srcTex, 0);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, dstTexTgt, dstTex, 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, srcTexTgt, srcTex, level);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, dstTexTgt, dstTex, level);
 
+		// sSȏꍇ̓Rs[ɁAvl̎sƂċL^B
+		// `̑gݍ킹ȂǌĂяo̖Ȃ̂ŁAAT[gł͎~߂Ȃ
 		GLenum fboStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		if (!_isTuningCopy) recordFboValidation(fboStatus == GL_FRAMEBUFFER_COMPLETE);
 		if (fboStatus != GL_FRAMEBUFFER_COMPLETE) {
-			assert(false);
-			return;
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			return false;
 		}
 
 		GLenum bufferlist[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
@@ -139,9 +1310,10 @@ private:
 			0, 0, texWidth, texWidth,
 			GL_COLOR_BUFFER_BIT, GL_NEAREST
 		);
-#endif
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0); // Disable FBO when done
+		return true;
+#endif
 	}
 };
 
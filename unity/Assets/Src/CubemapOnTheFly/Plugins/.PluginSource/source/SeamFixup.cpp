@@ -0,0 +1,49 @@
+#include "SeamFixup.h"
+#include "FrameArena.h"
+
+
+bool fixupCubemapSeamsCPU(const CubemapImageView& img)
+{
+	if (!img.pixels || img.size <= 0) return false;
+
+	const int n = img.size;
+	const int last = n - 1;
+
+	// ςO̒lQƂ邽߂ɁA݂͑SeNZvZIĂsB
+	// LeNZm͓gݍ킹ŕς̂ŁAǂ炩vZĂlɂȂ
+	struct Result { unsigned char* dst; unsigned char rgba[4]; };
+	FrameArena::Scope arena( getFrameArena() );
+	Result* results = arena.allocateArray<Result>( (size_t)6 * (n < 2 ? 1 : 4*(n-1)) );
+	if (!results) return false;
+	size_t resultCnt = 0;
+
+	for (int f=0; f<6; ++f) {
+		for (int y=0; y<n; ++y) {
+			const bool isEdgeY = y == 0 || y == last;
+			const int step = isEdgeY ? 1 : (n < 2 ? 1 : last);
+			for (int x=0; x<n; x+=step) {
+				int ox = x == 0 ? -1 : (x == last ? 1 : 0);
+				int oy = y == 0 ? -1 : (y == last ? 1 : 0);
+
+				SimdFloat4 c = simdLoadRGBA8( img.texel(f, x, y) );
+				float cnt = 1;
+				if (ox != 0) { c = simdAdd( c, simdLoadRGBA8( fetchCubeTexel(img, f, x+ox, y) ) ); cnt += 1; }
+				if (oy != 0) { c = simdAdd( c, simdLoadRGBA8( fetchCubeTexel(img, f, x, y+oy) ) ); cnt += 1; }
+
+				Result r;
+				r.dst = img.texel(f, x, y);
+				simdStoreRGBA8( r.rgba, simdMul( c, simdSet(1 / cnt) ) );
+				results[resultCnt++] = r;
+			}
+		}
+	}
+
+	for (size_t i=0; i<resultCnt; ++i) {
+		unsigned char* dst = results[i].dst;
+		dst[0] = results[i].rgba[0];
+		dst[1] = results[i].rgba[1];
+		dst[2] = results[i].rgba[2];
+		dst[3] = results[i].rgba[3];
+	}
+	return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CubemapImage.h"
+
+//
+// L[u}bv̌pڏCCPUB
+// V[XȃL[u}bvtB^OɁAʂ̉̃eNZאږʂƋLB
+// GPU͊eRenderAPI fixupCubemapSeams QƁB
+//
+
+
+/**
+ * L[u}bv̊eʂ̉̃eNZAאږʂ̑ΉeNZƕςB
+ * p̃eNZ3ʕŕςB1~bvx̏ōXV
+ */
+bool fixupCubemapSeamsCPU(const CubemapImageView& img);
@@ -0,0 +1,127 @@
+#include "SharedFaceRing.h"
+#include "PlatformBase.h"
+#include "PixelFormat.h"
+
+#include <string.h>
+
+#if UNITY_LINUX || UNITY_OSX
+#	define SUPPORT_SHARED_FACE_RING 1
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+
+static size_t roundUp(size_t v, size_t align) { return (v + align - 1) / align * align; }
+
+
+SharedFaceRing::SharedFaceRing() :
+	_base(NULL),
+	_bytes(0)
+{}
+
+SharedFaceRing::~SharedFaceRing()
+{
+	close();
+}
+
+bool SharedFaceRing::create(const char* name, int slotCount, int maxFaceSize, int format)
+{
+	close();
+	if (!name || !name[0] || slotCount <= 0 || maxFaceSize <= 0 || pixelFormatBytes(format) == 0) return false;
+
+#if SUPPORT_SHARED_FACE_RING
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::string shmName = name[0] == '/' ? name : std::string("/") + name;
+	const size_t headerBytes = roundUp(sizeof(SharedFaceRingHeader), kSharedFaceRingAlignment);
+	const size_t slotBytes = roundUp(
+		kSharedFaceRingSlotDataOffset + cubemapFaceBytes(maxFaceSize, 0, format),
+		kSharedFaceRingAlignment
+	);
+	const size_t bytes = headerBytes + slotBytes * slotCount;
+
+	// ȌݑُIĎcĂꍇɔāA蒼
+	shm_unlink(shmName.c_str());
+	int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0) return false;
+	if (ftruncate(fd, (off_t)bytes) != 0) {
+		::close(fd);
+		shm_unlink(shmName.c_str());
+		return false;
+	}
+	void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (p == MAP_FAILED) {
+		shm_unlink(shmName.c_str());
+		return false;
+	}
+
+	// ftruncatë0Ŗ܂Ă̂ŁAwb_ݒ肷B
+	// ǂݍݑr̃wb_Ȃ悤ɁAʎq͍Ōɏ
+	_base = static_cast<unsigned char*>(p);
+	_bytes = bytes;
+	_name = shmName;
+
+	SharedFaceRingHeader* h = header();
+	h->version = kSharedFaceRingVersion;
+	h->slotCount = (uint32_t)slotCount;
+	h->maxFaceSize = (uint32_t)maxFaceSize;
+	h->headerBytes = headerBytes;
+	h->slotBytes = slotBytes;
+	h->writerPid = (uint64_t)getpid();
+	h->publishedCount.store(0, std::memory_order_relaxed);
+	h->magic.store(kSharedFaceRingMagic, std::memory_order_release);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SharedFaceRing::close()
+{
+#if SUPPORT_SHARED_FACE_RING
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_base) return;
+
+	munmap(_base, _bytes);
+	shm_unlink(_name.c_str());
+	_base = NULL;
+	_bytes = 0;
+	_name.clear();
+#endif
+}
+
+bool SharedFaceRing::publish(int face, int size, int format, uint64_t frameId, const void* data)
+{
+	if (face < 0 || 6 <= face || size <= 0 || !data || pixelFormatBytes(format) == 0) return false;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_base) return false;
+
+	SharedFaceRingHeader* h = header();
+	const size_t dataBytes = cubemapFaceBytes(size, 0, format);
+	if (h->slotBytes - kSharedFaceRingSlotDataOffset < dataBytes) return false;
+
+	const uint64_t index = h->publishedCount.load(std::memory_order_relaxed);
+	unsigned char* slotPtr = _base + h->headerBytes + h->slotBytes * (index % h->slotCount);
+	SharedFaceRingSlot* slot = reinterpret_cast<SharedFaceRingSlot*>(slotPtr);
+
+	// V[PXԍɂĂ珑݁A݊ɋ֖߂
+	const uint32_t seq = slot->sequence.load(std::memory_order_relaxed);
+	slot->sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot->size = (uint32_t)size;
+	slot->format = (uint32_t)format;
+	slot->face = (uint32_t)face;
+	slot->frameId = frameId;
+	slot->index = index;
+	slot->dataBytes = dataBytes;
+	memcpy(slotPtr + kSharedFaceRingSlotDataOffset, data, dataBytes);
+
+	slot->sequence.store(seq + 2, std::memory_order_release);
+	h->publishedCount.store(index + 1, std::memory_order_release);
+	return true;
+}
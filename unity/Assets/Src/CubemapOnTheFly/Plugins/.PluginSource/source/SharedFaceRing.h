@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+//
+// L[u}bv̖ʂAOtPOSIXL̃Oobt@ővZX֌JB
+// L̐擪ɃOŜ̃wb_uǍ1ʂi[XbgׂB
+//
+// eXbg̓V[PXbNŕی삷Bݒ̓V[PXԍɂȂA݊ŋɖ߂B
+// ǂݍݑ́AV[PXԍǂ -> wb_ƃf[^QƂ -> ēxV[PXԍǂށȀɍsA
+// Oオł΂̊ԂɎQƂe͐Bf[^̓Rs[Ƀ}bv܂܎QƂłB
+//
+// CAEg̒`́AvOCO̓ǂݍݑvÕt@C include ĎgpB
+// ΉLinuxEmacOŜ݁B̑̊ł͍쐬ɎsB
+//
+
+
+/** L̐擪ɒuwb_̎ʎq("CBFR") */
+static const uint32_t kSharedFaceRingMagic = 0x52464243;
+/** CAEg̃o[WB݊̂ȂύXグ */
+static const uint32_t kSharedFaceRingVersion = 1;
+/** wb_EeXbg̔zuEBǂݍݑł̂܂܃y[WPʂɈ悤Ƀy[WTCYɑ */
+static const size_t kSharedFaceRingAlignment = 4096;
+/** Xbg擪ʂ̃f[^܂ł̃oCg */
+static const size_t kSharedFaceRingSlotDataOffset = 64;
+
+
+/** L̐擪ɒuAOŜ̃wb_ */
+struct SharedFaceRingHeader
+{
+	std::atomic<uint32_t> magic;		//!<  kSharedFaceRingMagic ɂȂ
+	uint32_t version;					//!< kSharedFaceRingVersion
+	uint32_t slotCount;					//!< Xbg
+	uint32_t maxFaceSize;				//!< i[łʂ̈ӂ̍ősNZ
+	uint64_t headerBytes;				//!< L擪ŏ̃Xbg܂ł̃oCg
+	uint64_t slotBytes;					//!< 1Xbg̃oCg(Xbgwb_)
+	uint64_t writerPid;					//!< ݑ̃vZXID
+	std::atomic<uint64_t> publishedCount;	//!< Jς݂̖ʂ̗݌vBnԖڂ̖ʂ̓Xbg n % slotCount ɓ
+};
+
+/** eXbg̐擪ɒuwb_Bf[^̓Xbg擪 kSharedFaceRingSlotDataOffset ̈ʒuɑ */
+struct SharedFaceRingSlot
+{
+	std::atomic<uint32_t> sequence;		//!< V[PXbNBݒ͊
+	uint32_t size;						//!< ʂ̈ӂ̃sNZ
+	uint32_t format;					//!< sNZ`(PixelFormat)
+	uint32_t face;						//!< ʂ̔ԍ(0~5B+X,-X,+Y,-Y,+Z,-Z)
+	uint64_t frameId;					//!< ݑw肵t[ԍ
+	uint64_t index;						//!< ̖ʂ̌J̒ʂԍ(0n܂)
+	uint64_t dataBytes;					//!< f[^̃oCg
+};
+
+static_assert(sizeof(SharedFaceRingSlot) <= kSharedFaceRingSlotDataOffset, "slot header too large");
+static_assert(sizeof(SharedFaceRingHeader) <= kSharedFaceRingAlignment, "ring header too large");
+
+
+/** ݑ̃OBvOCŎgp */
+class SharedFaceRing
+{
+public:
+	SharedFaceRing();
+	~SharedFaceRing();
+
+	/**
+	 * OtL쐬ăOBname'/'n܂łȂΐ擪ɕtB
+	 * ̋LcĂꍇ͍폜č蒼Bɍ쐬ς݂̏ꍇ͕Ă쐬
+	 */
+	bool create(const char* name, int slotCount, int maxFaceSize, int format);
+
+	/** }bvċL폜BɐڑĂǂݍݑ́A}bv܂ŎQƂ𑱂 */
+	void close();
+
+	bool isOpen() const { return _base != NULL; }
+
+	/** 1ʕ̃f[^̃Xbg֏ŌJBdata͌ԂȂ1ʕ */
+	bool publish(int face, int size, int format, uint64_t frameId, const void* data);
+
+private:
+	std::mutex _mutex;
+	std::string _name;
+	unsigned char* _base;
+	size_t _bytes;
+
+	SharedFaceRingHeader* header() const { return reinterpret_cast<SharedFaceRingHeader*>(_base); }
+
+	SharedFaceRing(const SharedFaceRing&);
+	SharedFaceRing& operator=(const SharedFaceRing&);
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string.h>
+
+//
+// CPŨsNZŎgpA4vffloatSIMDbp[B
+// RGBA1sNZ1WX^ƂĈB
+//   x86/x64 : SSE2
+//   ARM     : NEON
+//   ̑  : XJ[
+//
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+#	define SIMD_SSE2 1
+#	include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define SIMD_NEON 1
+#	include <arm_neon.h>
+#endif
+
+
+#if SIMD_SSE2
+
+struct SimdFloat4 { __m128 v; };
+
+static inline SimdFloat4 simdSet(float a) { SimdFloat4 r = { _mm_set1_ps(a) }; return r; }
+static inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { _mm_add_ps(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdSub(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { _mm_sub_ps(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { _mm_mul_ps(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { _mm_min_ps(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { _mm_max_ps(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdLoad(const float* p) { SimdFloat4 r = { _mm_loadu_ps(p) }; return r; }
+static inline void simdStore(float* p, SimdFloat4 a) { _mm_storeu_ps(p, a.v); }
+
+/** RGBA81sNZ0~255float4Ƃēǂݍ */
+static inline SimdFloat4 simdLoadRGBA8(const unsigned char* p) {
+	int word; memcpy(&word, p, 4);
+	__m128i z = _mm_setzero_si128();
+	__m128i i = _mm_cvtsi32_si128(word);
+	i = _mm_unpacklo_epi8(i, z);
+	i = _mm_unpacklo_epi16(i, z);
+	SimdFloat4 r = { _mm_cvtepi32_ps(i) };
+	return r;
+}
+
+/** 0~255float4Aۂ߁EOaRGBA81sNZƂď */
+static inline void simdStoreRGBA8(unsigned char* p, SimdFloat4 a) {
+	__m128i i = _mm_cvtps_epi32(a.v);
+	i = _mm_packs_epi32(i, i);
+	i = _mm_packus_epi16(i, i);
+	int word = _mm_cvtsi128_si32(i);
+	memcpy(p, &word, 4);
+}
+
+#elif SIMD_NEON
+
+struct SimdFloat4 { float32x4_t v; };
+
+static inline SimdFloat4 simdSet(float a) { SimdFloat4 r = { vdupq_n_f32(a) }; return r; }
+static inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { vaddq_f32(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdSub(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { vsubq_f32(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { vmulq_f32(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { vminq_f32(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r = { vmaxq_f32(a.v, b.v) }; return r; }
+static inline SimdFloat4 simdLoad(const float* p) { SimdFloat4 r = { vld1q_f32(p) }; return r; }
+static inline void simdStore(float* p, SimdFloat4 a) { vst1q_f32(p, a.v); }
+
+/** RGBA81sNZ0~255float4Ƃēǂݍ */
+static inline SimdFloat4 simdLoadRGBA8(const unsigned char* p) {
+	uint32_t word; memcpy(&word, p, 4);
+	uint8x8_t b = vreinterpret_u8_u32( vdup_n_u32(word) );
+	uint32x4_t d = vmovl_u16( vget_low_u16( vmovl_u8(b) ) );
+	SimdFloat4 r = { vcvtq_f32_u32(d) };
+	return r;
+}
+
+/** 0~255float4Aۂ߁EOaRGBA81sNZƂď */
+static inline void simdStoreRGBA8(unsigned char* p, SimdFloat4 a) {
+	float32x4_t c = vminq_f32( vmaxq_f32(a.v, vdupq_n_f32(0)), vdupq_n_f32(255) );
+	uint32x4_t d = vcvtq_u32_f32( vaddq_f32(c, vdupq_n_f32(0.5f)) );
+	uint16x4_t w = vmovn_u32(d);
+	uint8x8_t b = vqmovn_u16( vcombine_u16(w, w) );
+	uint32_t word = vget_lane_u32( vreinterpret_u32_u8(b), 0 );
+	memcpy(p, &word, 4);
+}
+
+#else
+
+struct SimdFloat4 { float v[4]; };
+
+static inline SimdFloat4 simdSet(float a) { SimdFloat4 r = {{a, a, a, a}}; return r; }
+static inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b) { for (int i=0; i<4; ++i) a.v[i] += b.v[i]; return a; }
+static inline SimdFloat4 simdSub(SimdFloat4 a, SimdFloat4 b) { for (int i=0; i<4; ++i) a.v[i] -= b.v[i]; return a; }
+static inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b) { for (int i=0; i<4; ++i) a.v[i] *= b.v[i]; return a; }
+static inline SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) { for (int i=0; i<4; ++i) a.v[i] = b.v[i] < a.v[i] ? b.v[i] : a.v[i]; return a; }
+static inline SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) { for (int i=0; i<4; ++i) a.v[i] = a.v[i] < b.v[i] ? b.v[i] : a.v[i]; return a; }
+static inline SimdFloat4 simdLoad(const float* p) { SimdFloat4 r; memcpy(r.v, p, 16); return r; }
+static inline void simdStore(float* p, SimdFloat4 a) { memcpy(p, a.v, 16); }
+
+/** RGBA81sNZ0~255float4Ƃēǂݍ */
+static inline SimdFloat4 simdLoadRGBA8(const unsigned char* p) {
+	SimdFloat4 r = {{ (float)p[0], (float)p[1], (float)p[2], (float)p[3] }};
+	return r;
+}
+
+/** 0~255float4Aۂ߁EOaRGBA81sNZƂď */
+static inline void simdStoreRGBA8(unsigned char* p, SimdFloat4 a) {
+	for (int i=0; i<4; ++i) {
+		float c = a.v[i] < 0 ? 0 : (255 < a.v[i] ? 255 : a.v[i]);
+		p[i] = (unsigned char)(c + 0.5f);
+	}
+}
+
+#endif
+
+
+/** a + b*c */
+static inline SimdFloat4 simdMulAdd(SimdFloat4 a, SimdFloat4 b, SimdFloat4 c) { return simdAdd(a, simdMul(b, c)); }
+
+/** a  b  t Ő`Ԃ */
+static inline SimdFloat4 simdLerp(SimdFloat4 a, SimdFloat4 b, float t) {
+	return simdMulAdd(a, simdSub(b, a), simdSet(t));
+}
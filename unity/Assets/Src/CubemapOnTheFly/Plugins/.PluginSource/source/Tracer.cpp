@@ -0,0 +1,244 @@
+#include "Tracer.h"
+#include "PlatformBase.h"
+#include "Epoch.h"
+#include "FileIO.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if UNITY_WIN
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif UNITY_LINUX || UNITY_ANDROID
+#	include <unistd.h>
+#	include <sys/syscall.h>
+#elif UNITY_OSX || UNITY_IOS || UNITY_TVOS
+#	include <unistd.h>
+#	include <pthread.h>
+#endif
+
+
+std::atomic<bool> g_IsTracing(false);
+
+
+namespace {
+
+/** XbhƂɋL^ł鏈̊l */
+const int kDefaultEventCapacity = 16384;
+
+/** XbhƂ̋L^BǋL͎̃Xbĥ݂sAo͋L^̒~ɍs */
+struct ThreadBuffer
+{
+	std::vector<TraceEvent> events;
+	std::atomic<int> count;
+	unsigned long long droppedCnt;
+	unsigned long long tid;
+	const char* name;
+	std::atomic<bool> isOrphan;		//!< ̃XbhIۂ
+
+	ThreadBuffer() : count(0), droppedCnt(0), tid(0), name(NULL), isOrphan(false) {}
+};
+
+std::mutex s_TraceMutex;
+std::vector<ThreadBuffer*> s_Buffers;
+int s_EventCapacity = kDefaultEventCapacity;
+
+/** L^̒~AǋL̃Xbh܂ő҂߂̃G|bN */
+EpochDomain s_TraceEpoch;
+
+/** Xbh̏IɁÃXbh̃obt@̂Ȃ̂ƂĈt */
+struct ThreadBufferOwner
+{
+	ThreadBuffer* buffer;
+	const char* name;
+
+	ThreadBufferOwner() : buffer(NULL), name(NULL) {}
+	~ThreadBufferOwner() { if (buffer) buffer->isOrphan.store(true, std::memory_order_release); }
+};
+thread_local ThreadBufferOwner t_owner;
+
+unsigned long long currentThreadId()
+{
+#if UNITY_WIN
+	return GetCurrentThreadId();
+#elif UNITY_LINUX || UNITY_ANDROID
+	return (unsigned long long)syscall(SYS_gettid);
+#elif UNITY_OSX || UNITY_IOS || UNITY_TVOS
+	uint64_t tid = 0;
+	pthread_threadid_np(NULL, &tid);
+	return tid;
+#else
+	static std::atomic<unsigned long long> s_nextTid(1);
+	return s_nextTid++;
+#endif
+}
+
+unsigned long long currentProcessId()
+{
+#if UNITY_WIN
+	return GetCurrentProcessId();
+#elif UNITY_WEBGL
+	return 1;
+#else
+	return (unsigned long long)getpid();
+#endif
+}
+
+/** ݂̃Xbh̃obt@ԂB͍쐬ēo^ */
+ThreadBuffer* getThreadBuffer()
+{
+	if (t_owner.buffer) return t_owner.buffer;
+
+	ThreadBuffer* b = new ThreadBuffer();
+	b->tid = currentThreadId();
+	b->name = t_owner.name;
+
+	std::lock_guard<std::mutex> lock(s_TraceMutex);
+	b->events.resize(s_EventCapacity);
+	s_Buffers.push_back(b);
+	t_owner.buffer = b;
+	return b;
+}
+
+/** JSON̕ƂďoBO͐ÓIȎʎq݂̂Ȃ̂ŁA䕶ƈp */
+void writeJsonString(FILE* fp, const char* s)
+{
+	fputc('"', fp);
+	for (; *s; ++s) {
+		if (*s == '"' || *s == '\\' || (unsigned char)*s < 0x20) continue;
+		fputc(*s, fp);
+	}
+	fputc('"', fp);
+}
+
+/** SXbh̋L^ trace_event `ŏoBs_TraceMutex ԂŌĂ */
+bool writeTraceFileLocked(FILE* fp)
+{
+	const unsigned long long pid = currentProcessId();
+	unsigned long long droppedCnt = 0;
+	for (size_t i=0; i<s_Buffers.size(); ++i) droppedCnt += s_Buffers[i]->droppedCnt;
+
+	fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%llu},\"traceEvents\":[\n", droppedCnt);
+	fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%llu,\"args\":{\"name\":\"CubemapBuilderPlugin\"}}", pid);
+
+	for (size_t i=0; i<s_Buffers.size(); ++i) {
+		const ThreadBuffer& b = *s_Buffers[i];
+		const int cnt = b.count.load(std::memory_order_acquire);
+		if (cnt == 0) continue;
+
+		if (b.name) {
+			fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%llu,\"tid\":%llu,\"args\":{\"name\":", pid, b.tid);
+			writeJsonString(fp, b.name);
+			fputs("}}", fp);
+		}
+
+		for (int j=0; j<cnt; ++j) {
+			const TraceEvent& e = b.events[j];
+			fputs(",\n{\"name\":", fp);
+			writeJsonString(fp, e.name);
+			// ̓sPʁBsteady_clock ̒l̂܂܎ĝŁAvŋL^̃g[Xƕׂ
+			fprintf(
+				fp, ",\"cat\":\"CubemapBuilderPlugin\",\"ph\":\"X\",\"pid\":%llu,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+				pid, b.tid, e.beginNs / 1000.0, e.durationNs / 1000.0
+			);
+			bool isFirst = true;
+			for (int k=0; k<3; ++k) {
+				const TraceArg& a = e.args[k];
+				if (!a.name) continue;
+				if (!isFirst) fputc(',', fp);
+				isFirst = false;
+				writeJsonString(fp, a.name);
+				if (a.isHandle) fprintf(fp, ":\"0x%llx\"", (unsigned long long)a.value);
+				else fprintf(fp, ":%lld", a.value);
+			}
+			fputs("}}", fp);
+		}
+	}
+
+	fputs("\n]}\n", fp);
+	return ferror(fp) == 0;
+}
+
+}	// namespace
+
+
+unsigned long long traceNowNs()
+{
+	return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+void writeTraceEvent(const TraceEvent& e)
+{
+	// ~ɔĂXR[v͎̂̕ĂB~͂̃K[h𔲂̂҂Ă珑o
+	EpochDomain::Guard guard(s_TraceEpoch);
+	if (!isTracing()) return;
+
+	ThreadBuffer* b = getThreadBuffer();
+	const int n = b->count.load(std::memory_order_relaxed);
+	if ((int)b->events.size() <= n) {
+		++b->droppedCnt;
+		return;
+	}
+	b->events[n] = e;
+	b->count.store(n + 1, std::memory_order_release);
+}
+
+void setTraceThreadName(const char* name)
+{
+	t_owner.name = name;
+	if (t_owner.buffer) t_owner.buffer->name = name;
+}
+
+bool startTrace(int eventCapacityPerThread)
+{
+	std::lock_guard<std::mutex> lock(s_TraceMutex);
+	if (isTracing()) return false;
+
+	s_EventCapacity = 0 < eventCapacityPerThread ? eventCapacityPerThread : kDefaultEventCapacity;
+
+	// L^łȂΒǋL͍sȂ̂ŁAŃobt@蒼Ă悢B
+	// IXbh̃obt@́AgȂ̂ŉ
+	for (size_t i=0; i<s_Buffers.size();) {
+		ThreadBuffer* b = s_Buffers[i];
+		if (b->isOrphan.load(std::memory_order_acquire)) {
+			delete b;
+			s_Buffers[i] = s_Buffers.back();
+			s_Buffers.pop_back();
+			continue;
+		}
+		b->events.resize(s_EventCapacity);
+		b->count.store(0, std::memory_order_relaxed);
+		b->droppedCnt = 0;
+		++i;
+	}
+
+	g_IsTracing.store(true, std::memory_order_release);
+	return true;
+}
+
+bool stopTrace(const char* path)
+{
+	if (!g_IsTracing.exchange(false)) return false;
+	s_TraceEpoch.synchronize();
+
+	std::lock_guard<std::mutex> lock(s_TraceMutex);
+	if (!path) return true;
+
+	std::string tmpPath = std::string(path) + ".tmp";
+	FILE* fp = openFileUtf8(tmpPath.c_str(), "wb");
+	if (!fp) return false;
+
+	bool isSucceeded = writeTraceFileLocked(fp);
+	isSucceeded = fclose(fp) == 0 && isSucceeded;
+
+	if (!isSucceeded || !replaceFileUtf8(tmpPath.c_str(), path)) {
+		removeFileUtf8(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
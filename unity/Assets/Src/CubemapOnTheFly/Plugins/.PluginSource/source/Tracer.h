@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stddef.h>
+#include <atomic>
+
+//
+// vOC̏̃^CCL^ACӂŗLɂg[TB
+// e TraceScope ň͂ނƁAIɊJnEvԁEĂяoXbh̃obt@֒ǋLB
+// obt@̓XbhƂɎ̂ŁAǋL̓bNȂBLłȂԂׂ̕ TraceScope ̕1̂݁B
+// ~ɑSXbh̋L^ Chrome  trace_event `JSON֏oAPerfetto ŕ\łB
+//
+//   TraceScope trace("BlitCubemap", TraceArg("size", texWidth), TraceArg("dst", cubemapTex));
+//
+
+
+/** g[X̋L^ۂBTraceScope QƂ̂ŁACCŔł悤ɌJĂ */
+extern std::atomic<bool> g_IsTracing;
+
+static inline bool isTracing() { return g_IsTracing.load(std::memory_order_relaxed); }
+
+
+/** L^Bl͐nh(|C^)ŁAnh16iŏo */
+struct TraceArg
+{
+	const char* name;		//!< NULL̏ꍇ͖gpBÓIȕ̂
+	long long value;
+	bool isHandle;
+
+	TraceArg() : name(NULL), value(0), isHandle(false) {}
+	TraceArg(const char* n, int v) : name(n), value(v), isHandle(false) {}
+	TraceArg(const char* n, long long v) : name(n), value(v), isHandle(false) {}
+	TraceArg(const char* n, const void* p) : name(n), value((long long)(size_t)p), isHandle(true) {}
+};
+
+/** 1̏̋L^ */
+struct TraceEvent
+{
+	const char* name;				//!< ÓIȕ̂
+	unsigned long long beginNs;		//!< steady_clock ̎
+	unsigned long long durationNs;
+	TraceArg args[3];
+};
+
+
+/**
+ * g[X̋L^JnBɋL^̏ꍇ͉falseԂB
+ * eventCapacityPerThread ̓XbhƂɋL^ł鏈ŁA0ȉ̏ꍇ͊lBꂽ͎̂Ă
+ */
+bool startTrace(int eventCapacityPerThread);
+
+/**
+ * g[X̋L^~AL^e Chrome  trace_event `Ńt@C֏oB
+ * pathUTF-8BNULL̏ꍇ͏oɎ̂ĂBL^łȂꍇ⏑oɎsꍇfalse
+ */
+bool stopTrace(const char* path);
+
+/** ݂̃Xbh̖Oݒ肷Bg[X̃XbhƂďoBname͐ÓIȕ̂ */
+void setTraceThreadName(const char* name);
+
+/** L^Ã݂Xbh̃obt@֒ǋLBTraceScope Ă */
+void writeTraceEvent(const TraceEvent& e);
+
+/** g[Xp̌ݎ */
+unsigned long long traceNowNs();
+
+
+/** XR[v̊Ԃ̏L^BL^łȂꍇ͉Ȃ */
+class TraceScope
+{
+public:
+	TraceScope(
+		const char* name,
+		const TraceArg& a0 = TraceArg(),
+		const TraceArg& a1 = TraceArg(),
+		const TraceArg& a2 = TraceArg()
+	) : _isActive(isTracing())
+	{
+		if (!_isActive) return;
+		_event.name = name;
+		_event.args[0] = a0;
+		_event.args[1] = a1;
+		_event.args[2] = a2;
+		_event.beginNs = traceNowNs();
+	}
+
+	~TraceScope()
+	{
+		if (!_isActive) return;
+		_event.durationNs = traceNowNs() - _event.beginNs;
+		writeTraceEvent(_event);
+	}
+
+private:
+	bool _isActive;
+	TraceEvent _event;
+
+	TraceScope(const TraceScope&);
+	TraceScope& operator=(const TraceScope&);
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include "IUnityInterface.h"
+#include <stddef.h>
+#include <stdint.h>
+#ifndef __cplusplus
+    #include <stdbool.h>
+#endif
+
+typedef uint16_t UnityProfilerMarkerCategory;
+typedef uint16_t UnityProfilerCategoryId;
+
+enum UnityBuiltinProfilerCategory_
+{
+    kUnityProfilerCategoryRender = 0,
+    kUnityProfilerCategoryScripts = 1,
+    kUnityProfilerCategoryManagedJobs = 2,
+    kUnityProfilerCategoryBurstJobs = 3,
+    kUnityProfilerCategoryGUI = 4,
+    kUnityProfilerCategoryPhysics = 5,
+    kUnityProfilerCategoryAnimation = 6,
+    kUnityProfilerCategoryAi = 7,
+    kUnityProfilerCategoryAudio = 8,
+    kUnityProfilerCategoryAudioJob = 9,
+    kUnityProfilerCategoryAudioUpdateJob = 10,
+    kUnityProfilerCategoryVideo = 11,
+    kUnityProfilerCategoryParticles = 12,
+    kUnityProfilerCategoryGi = 13,
+    kUnityProfilerCategoryNetwork = 14,
+    kUnityProfilerCategoryLoading = 15,
+    kUnityProfilerCategoryOther = 16,
+    kUnityProfilerCategoryGC = 17,
+    kUnityProfilerCategoryVSync = 18,
+    kUnityProfilerCategoryOverhead = 19,
+    kUnityProfilerCategoryPlayerLoop = 20,
+    kUnityProfilerCategoryDirector = 21,
+    kUnityProfilerCategoryVR = 22,
+    kUnityProfilerCategoryAllocation = 23,
+    kUnityProfilerCategoryInternal = 24,
+    kUnityProfilerCategoryFileIO = 25,
+    kUnityProfilerCategoryUISystemLayout = 26,
+    kUnityProfilerCategoryUISystemRender = 27,
+    kUnityProfilerCategoryVFX = 28,
+    kUnityProfilerCategoryBuildInterface = 29,
+    kUnityProfilerCategoryInput = 30,
+    kUnityProfilerCategoryVirtualTexturing = 31,
+};
+typedef uint16_t UnityBuiltinProfilerCategory;
+
+typedef uint16_t UnityProfilerMarkerFlags;
+enum UnityProfilerMarkerFlag_
+{
+    kUnityProfilerMarkerFlagDefault = 0,
+
+    kUnityProfilerMarkerFlagScriptUser = 1 << 1,
+    kUnityProfilerMarkerFlagScriptInvoke = 1 << 5,
+    kUnityProfilerMarkerFlagScriptEnterLeave = 1 << 6,
+
+    kUnityProfilerMarkerFlagAvailabilityEditor = 1 << 2,
+    kUnityProfilerMarkerFlagAvailabilityNonDev = 1 << 3,
+
+    kUnityProfilerMarkerFlagWarning = 1 << 4,
+
+    kUnityProfilerMarkerFlagCounter = 1 << 7,
+
+    kUnityProfilerMarkerFlagVerbosityDebug = 1 << 10,
+    kUnityProfilerMarkerFlagVerbosityInternal = 1 << 11,
+    kUnityProfilerMarkerFlagVerbosityAdvanced = 1 << 12
+};
+
+typedef uint16_t UnityProfilerMarkerEventType;
+enum UnityProfilerMarkerEventType_
+{
+    kUnityProfilerMarkerEventTypeBegin = 0,
+    kUnityProfilerMarkerEventTypeEnd = 1,
+    kUnityProfilerMarkerEventTypeSingle = 2
+};
+
+typedef struct UnityProfilerMarkerDesc
+{
+    const void* callback;
+    const struct UnityProfilerMarkerDesc* next;
+    const char* name;
+    UnityProfilerCategoryId categoryId;
+    UnityProfilerMarkerFlags flags;
+    int32_t metaDataCount;
+} UnityProfilerMarkerDesc;
+
+typedef uint8_t UnityProfilerMarkerDataType;
+enum UnityProfilerMarkerDataType_
+{
+    kUnityProfilerMarkerDataTypeNone = 0,
+    kUnityProfilerMarkerDataTypeInstanceId = 1,
+    kUnityProfilerMarkerDataTypeInt32 = 2,
+    kUnityProfilerMarkerDataTypeUInt32 = 3,
+    kUnityProfilerMarkerDataTypeInt64 = 4,
+    kUnityProfilerMarkerDataTypeUInt64 = 5,
+    kUnityProfilerMarkerDataTypeFloat = 6,
+    kUnityProfilerMarkerDataTypeDouble = 7,
+    kUnityProfilerMarkerDataTypeString = 8,
+    kUnityProfilerMarkerDataTypeString16 = 9,
+    kUnityProfilerMarkerDataTypeBlob8 = 11,
+    kUnityProfilerMarkerDataTypeGfxResourceId = 12,
+    kUnityProfilerMarkerDataTypeCount
+};
+
+typedef uint8_t UnityProfilerMarkerDataUnit;
+enum UnityProfilerMarkerDataUnit_
+{
+    kUnityProfilerMarkerDataUnitUndefined = 0,
+    kUnityProfilerMarkerDataUnitTimeNanoseconds = 1,
+    kUnityProfilerMarkerDataUnitBytes = 2,
+    kUnityProfilerMarkerDataUnitCount = 3,
+    kUnityProfilerMarkerDataUnitPercent = 4,
+    kUnityProfilerMarkerDataUnitFrequencyHz = 5,
+};
+
+typedef struct UnityProfilerMarkerData
+{
+    UnityProfilerMarkerDataType type;
+    uint8_t reserved0;
+    uint16_t reserved1;
+    uint32_t size;
+    const void* ptr;
+} UnityProfilerMarkerData;
+
+typedef uint64_t UnityProfilerThreadId;
+
+typedef uint8_t UnityProfilerCounterFlags;
+enum UnityProfilerCounterFlags_
+{
+    kUnityProfilerCounterFlagNone = 0,
+    kUnityProfilerCounterFlushOnEndOfFrame = 1 << 1,
+    kUnityProfilerCounterFlagResetToZeroOnFlush = 1 << 2,
+    kUnityProfilerCounterFlagAtomic = 1 << 3,
+    kUnityProfilerCounterFlagGetter = 1 << 4
+};
+
+typedef void (UNITY_INTERFACE_API * UnityProfilerCounterStatePtrCallback)(void* userData);
+
+// Profiler interface. EmitEvent can be called from any thread registered with the profiler.
+UNITY_DECLARE_INTERFACE(IUnityProfiler)
+{
+    // Emits a begin, end or single event for the marker.
+    void(UNITY_INTERFACE_API * EmitEvent)(const UnityProfilerMarkerDesc* markerDesc, UnityProfilerMarkerEventType eventType, uint16_t eventDataCount, const UnityProfilerMarkerData* eventData);
+
+    // Returns 1 when the profiler is capturing.
+    int(UNITY_INTERFACE_API * IsEnabled)();
+
+    // Returns 1 when the profiler is available (Editor and Development Players).
+    int(UNITY_INTERFACE_API * IsAvailable)();
+
+    // Creates (or gets an existing) marker. Returns 0 on success.
+    int(UNITY_INTERFACE_API * CreateMarker)(const UnityProfilerMarkerDesc** desc, const char* name, UnityProfilerCategoryId category, UnityProfilerMarkerFlags flags, int eventDataCount);
+
+    // Sets the name and type of a marker metadata parameter. Returns 0 on success.
+    int(UNITY_INTERFACE_API * SetMarkerMetadataName)(const UnityProfilerMarkerDesc* desc, int index, const char* metadataName, UnityProfilerMarkerDataType metadataType, UnityProfilerMarkerDataUnit metadataUnit);
+
+    // Registers the current thread with the profiler. Returns 0 on success.
+    int(UNITY_INTERFACE_API * RegisterThread)(UnityProfilerThreadId* threadId, const char* groupName, const char* name);
+
+    // Unregisters the current thread. Returns 0 on success.
+    int(UNITY_INTERFACE_API * UnregisterThread)(UnityProfilerThreadId threadId);
+
+#ifdef __cplusplus
+    void BeginSample(const UnityProfilerMarkerDesc* markerDesc)
+    {
+        (*EmitEvent)(markerDesc, kUnityProfilerMarkerEventTypeBegin, 0, NULL);
+    }
+
+    void EndSample(const UnityProfilerMarkerDesc* markerDesc)
+    {
+        (*EmitEvent)(markerDesc, kUnityProfilerMarkerEventTypeEnd, 0, NULL);
+    }
+#endif
+};
+UNITY_REGISTER_INTERFACE_GUID(0x2CE79ED8316A4833ULL, 0x87076B2013E1571FULL, IUnityProfiler)
+
+// Profiler interface with categories and counters (Unity 2020.1 and later).
+UNITY_DECLARE_INTERFACE(IUnityProfilerV2)
+{
+    void(UNITY_INTERFACE_API * EmitEvent)(const UnityProfilerMarkerDesc* markerDesc, UnityProfilerMarkerEventType eventType, uint16_t eventDataCount, const UnityProfilerMarkerData* eventData);
+    int(UNITY_INTERFACE_API * IsEnabled)();
+    int(UNITY_INTERFACE_API * IsAvailable)();
+    int(UNITY_INTERFACE_API * CreateMarker)(const UnityProfilerMarkerDesc** desc, const char* name, UnityProfilerCategoryId category, UnityProfilerMarkerFlags flags, int eventDataCount);
+    int(UNITY_INTERFACE_API * SetMarkerMetadataName)(const UnityProfilerMarkerDesc* desc, int index, const char* metadataName, UnityProfilerMarkerDataType metadataType, UnityProfilerMarkerDataUnit metadataUnit);
+
+    // Creates (or gets an existing) category. Returns 0 on success.
+    int(UNITY_INTERFACE_API * CreateCategory)(UnityProfilerCategoryId* category, const char* name, uint32_t unused);
+
+    int(UNITY_INTERFACE_API * RegisterThread)(UnityProfilerThreadId* threadId, const char* groupName, const char* name);
+    int(UNITY_INTERFACE_API * UnregisterThread)(UnityProfilerThreadId threadId);
+
+    // Creates a counter and returns the pointer to its value storage of valueSize bytes, or NULL on failure.
+    // The value is sampled when flushed, either by FlushCounterValue or at the end of the frame (kUnityProfilerCounterFlushOnEndOfFrame).
+    void*(UNITY_INTERFACE_API * CreateCounterValue)(const UnityProfilerCategoryId category, const char* name, const UnityProfilerMarkerFlags flags, UnityProfilerMarkerDataType valueType, UnityProfilerMarkerDataUnit valueUnit, size_t valueSize, UnityProfilerCounterFlags counterFlags, UnityProfilerCounterStatePtrCallback activateFunc, UnityProfilerCounterStatePtrCallback deactivateFunc, void* userData);
+
+    // Pushes the current value of the counter to the profiler.
+    void(UNITY_INTERFACE_API * FlushCounterValue)(void* counter);
+};
+UNITY_REGISTER_INTERFACE_GUID(0xB957E0189CB6A30BULL, 0x83CE589AE85B9068ULL, IUnityProfilerV2)
@@ -0,0 +1,180 @@
+//
+// BoundedMPSCQueue  EpochDomain ̋̐\EmFx`}[NB
+//
+//   CommandQueueBench [-n 1Xbȟ] [-c L[̗e]
+//
+// 1~64̒ǉXbh瓯ɒǉA1̎oXbhŎoāA
+// EXbhƂ̏ۂĂ邩ƁAbԂ̏\B
+// āAQƒ̃XbhԂŋLIuWFNg̍ւEjJԂAjς݂̂̂QƂȂmFB
+//
+// rh : projects/GNUMake  make tools
+//
+
+#include "CommandQueue.h"
+#include "Epoch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+typedef std::chrono::steady_clock Clock;
+
+
+/** L[ɗvfBۂ̃R}h(RenderCommand)Ɠx̑傫ɂ */
+struct BenchCommand
+{
+	int producer;
+	int padding;
+	unsigned long long seq;
+	void* payload[7];
+};
+
+/** ǉXbhw肵1vBĂꍇfalse */
+static bool runQueueBench(int producerCnt, int perProducer, size_t capacity)
+{
+	BoundedMPSCQueue<BenchCommand> queue(capacity);
+	std::atomic<int> readyCnt(0);
+	std::atomic<bool> isStarted(false);
+	std::atomic<unsigned long long> fullCnt(0);
+
+	std::vector<std::thread> producers;
+	for (int p=0; p<producerCnt; ++p) {
+		producers.emplace_back( [&, p]() {
+			BenchCommand cmd;
+			memset(&cmd, 0, sizeof(cmd));
+			cmd.producer = p;
+			unsigned long long full = 0;
+
+			++readyCnt;
+			while (!isStarted.load(std::memory_order_acquire)) std::this_thread::yield();
+			for (int i=0; i<perProducer; ++i) {
+				cmd.seq = i;
+				while (!queue.tryPush(cmd)) {
+					++full;
+					std::this_thread::yield();
+				}
+			}
+			fullCnt += full;
+		} );
+	}
+	while (readyCnt.load() < producerCnt) std::this_thread::yield();
+
+	// o͂̃Xbhōs
+	std::vector<unsigned long long> nextSeq(producerCnt, 0);
+	const long long total = (long long)producerCnt * perProducer;
+	long long popped = 0;
+	bool isOrdered = true;
+
+	const Clock::time_point start = Clock::now();
+	isStarted.store(true, std::memory_order_release);
+	BenchCommand cmd;
+	while (popped < total) {
+		if (!queue.tryPop(&cmd)) {
+			std::this_thread::yield();
+			continue;
+		}
+		if (cmd.seq != nextSeq[cmd.producer]) isOrdered = false;
+		nextSeq[cmd.producer] = cmd.seq + 1;
+		++popped;
+	}
+	const double sec = std::chrono::duration<double>(Clock::now() - start).count();
+	for (size_t i=0; i<producers.size(); ++i) producers[i].join();
+
+	printf(
+		"  producers %2d : %8.2f Mops/s, %7.1f ns/op, full retries %llu, order %s\n",
+		producerCnt, total / sec / 1e6, sec * 1e9 / total,
+		(unsigned long long)fullCnt.load(), isOrdered ? "ok" : "BROKEN"
+	);
+	return isOrdered;
+}
+
+
+/** ւΏۂ̋LIuWFNgBjς݂ǂŔ肷 */
+struct BenchDevice
+{
+	static const unsigned kAlive = 0x600dc0de;
+	static const unsigned kDead = 0xdeadbeef;
+	std::atomic<unsigned> mark;
+	BenchDevice() : mark(kAlive) {}
+};
+
+/** Qƒ̃XbhԂōւEjJԂBjς݂QƂꍇfalse */
+static bool runEpochBench(int readerCnt, double seconds)
+{
+	EpochDomain domain;
+	std::atomic<BenchDevice*> current( new BenchDevice() );
+	std::atomic<bool> isRunning(true);
+	std::atomic<unsigned long long> readCnt(0), badCnt(0);
+
+	std::vector<std::thread> readers;
+	for (int r=0; r<readerCnt; ++r) {
+		readers.emplace_back( [&]() {
+			unsigned long long reads = 0, bad = 0;
+			while (isRunning.load(std::memory_order_relaxed)) {
+				EpochDomain::Guard g(domain);
+				BenchDevice* d = current.load(std::memory_order_acquire);
+				if (d && d->mark.load(std::memory_order_relaxed) != BenchDevice::kAlive) ++bad;
+				++reads;
+			}
+			readCnt += reads;
+			badCnt += bad;
+		} );
+	}
+
+	// ĵ͂ɂ͉AtĎcĂAQƂĂȂmF
+	std::vector<BenchDevice*> graveyard;
+	const Clock::time_point start = Clock::now();
+	int swapCnt = 0;
+	while (std::chrono::duration<double>(Clock::now() - start).count() < seconds) {
+		BenchDevice* old = current.exchange( new BenchDevice() );
+		domain.synchronize();
+		old->mark = BenchDevice::kDead;
+		graveyard.push_back(old);
+		++swapCnt;
+	}
+	isRunning = false;
+	for (size_t i=0; i<readers.size(); ++i) readers[i].join();
+
+	printf(
+		"  readers %2d : %d teardowns, %.1f M reads/s, stale reads %llu\n",
+		readerCnt, swapCnt, readCnt.load() / seconds / 1e6, (unsigned long long)badCnt.load()
+	);
+	for (size_t i=0; i<graveyard.size(); ++i) delete graveyard[i];
+	delete current.load();
+	return badCnt.load() == 0;
+}
+
+
+int main(int argc, char** argv)
+{
+	int perProducer = 200000;
+	size_t capacity = 1024;
+	for (int i=1; i<argc; ++i) {
+		const bool hasValue = i + 1 < argc;
+		if (!strcmp(argv[i], "-n") && hasValue) perProducer = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-c") && hasValue) capacity = (size_t)atoi(argv[++i]);
+		else {
+			fprintf(stderr, "usage: %s [-n countPerProducer] [-c capacity]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	bool isOk = true;
+	printf("BoundedMPSCQueue : capacity %d, %d commands per producer, %d hardware threads\n",
+		(int)capacity, perProducer, (int)std::thread::hardware_concurrency());
+	static const int kProducerCnts[] = { 1, 2, 4, 8, 16, 32, 64 };
+	for (size_t i=0; i<sizeof(kProducerCnts)/sizeof(kProducerCnts[0]); ++i)
+		isOk &= runQueueBench(kProducerCnts[i], perProducer, capacity);
+
+	printf("EpochDomain :\n");
+	static const int kReaderCnts[] = { 1, 4, 16, 64 };
+	for (size_t i=0; i<sizeof(kReaderCnts)/sizeof(kReaderCnts[0]); ++i)
+		isOk &= runEpochBench(kReaderCnts[i], 0.5);
+
+	return isOk ? 0 : 1;
+}
@@ -0,0 +1,629 @@
+//
+// StartPluginCapture ŋL^vOČĂяõOAEBhEOpenGLReLXgōĐc[B
+//
+//   PluginReplay [--realtime] [--finish] [--repeat ] capture.bin
+//
+// vOCÓIɃNAUnity ̃OtBbNXC^[tF[X͂ԂŃ[hāAL^ɌJ֐ĂԁB
+// L^̃eNX`́AnhƂɓށE傫E`̂̂蒼đΉt(e͋L^ĂȂ̂ŋ)B
+// zXgobt@gCPU͓傫̃_~[̃obt@ŁAKTX2t@C̓ǂݍ݂͓`̈ꎞt@CōČB
+//   --realtime  L^ƓԊuŌĂԁBw肵Ȃꍇ͑҂ɘAČĂ
+//   --finish    eĂяǒ glFinish Ŋ҂BvԂGPȔԂ܂߂ꍇɎw肷
+//   --repeat    OŜw񐔌JԂ
+// IɁAR[h̎ނƂ̋L^ƍĐ̏v(CPU)\B
+// GL̃ReLXg EGL  surfaceless vbgtH[(Mesa)ō쐬̂ŁAGPUEfBXvC̖łB
+//
+// rh : projects/GNUMake  make tools
+//
+
+#include "PluginCapture.h"
+#include "LuminanceStats.h"
+#include "OpenGLCommon.h"
+#include "PixelFormat.h"
+#include "Unity/IUnityGraphics.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+// vOČJ֐BvOCÓIɃNĒڌĂ
+extern "C" {
+void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces* unityInterfaces);
+void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginUnload();
+void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlitCubemap(void* srcTex0, void* srcTex1, void* srcTex2, void* srcTex3, void* srcTex4, void* srcTex5, void* cubemapTex, int texWidth);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertCubemapToProjection(void* cubemapTex, void* dstTex, int dstWidth, int dstHeight, int projection);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertProjectionToCubemap(void* srcTex, void* cubemapTex, int cubemapSize, int projection);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertCubemapToProjectionCPU(void* srcFaces, int srcSize, void* dst, int dstWidth, int dstHeight, int projection);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ConvertProjectionToCubemapCPU(void* src, int srcWidth, int srcHeight, void* dstFaces, int dstSize, int projection);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API RotateCubemap(void* srcCubemapTex, void* dstCubemapTex, int size, const float* rotation);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API RotateCubemapCPU(void* srcFaces, void* dstFaces, int size, const float* rotation);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API FixupCubemapSeams(void* cubemapTex, int size, int mipCount);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API FixupCubemapSeamsCPU(void* faces, int size);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlurCubemap(void* srcCubemapTex, void* dstCubemapTex, int size, float sigma);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API BlurCubemapCPU(void* srcFaces, void* dstFaces, int size, float sigma);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ComputeCubemapLuminanceStats(void* cubemapTex, int size, float minLog2Lum, float maxLog2Lum);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetCubemapLuminanceStats(CubemapLuminanceStats* out);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ComputeCubemapLuminanceStatsCPU(void* faces, int size, int isSRGB, float minLog2Lum, float maxLog2Lum, CubemapLuminanceStats* out);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WriteKTX2Cubemap(const char* path, int size, int mipCount, int format, const void* const* levelData, const char* key);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API LoadKTX2CubemapLevels(const char* path, const char* key, void* cubemapTex, int firstLevel, int levelCount, int dstFirstLevel);
+void* UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API CreateCubemap(int size, int mipCount, int format);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API DestroyCubemap(void* cubemapTex);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API CreateCubemapFaceViews(void* cubemapTex, void** outFaceTexs);
+int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API DestroyTextureView(void* viewTex);
+}
+
+
+typedef std::chrono::steady_clock Clock;
+
+
+// --------------------------------------------------------------------------
+// Unity ̃OtBbNXC^[tF[X̑
+
+
+static IUnityGraphicsDeviceEventCallback s_DeviceEventCallback = NULL;
+
+static UnityGfxRenderer UNITY_INTERFACE_API getRenderer() { return kUnityGfxRendererOpenGLCore; }
+static void UNITY_INTERFACE_API registerDeviceEventCallback(IUnityGraphicsDeviceEventCallback callback) { s_DeviceEventCallback = callback; }
+static void UNITY_INTERFACE_API unregisterDeviceEventCallback(IUnityGraphicsDeviceEventCallback callback) { s_DeviceEventCallback = NULL; }
+static int UNITY_INTERFACE_API reserveEventIDRange(int count) { return 0; }
+
+/** ֐|C^ UnityPluginLoad ̑O initGraphicsInterface Őݒ肷 */
+static IUnityGraphics s_Graphics;
+
+static void initGraphicsInterface()
+{
+	s_Graphics.GetRenderer = getRenderer;
+	s_Graphics.RegisterDeviceEventCallback = registerDeviceEventCallback;
+	s_Graphics.UnregisterDeviceEventCallback = unregisterDeviceEventCallback;
+	s_Graphics.ReserveEventIDRange = reserveEventIDRange;
+}
+
+/** IUnityGraphics ȊÕC^[tF[X͖̂ƂāAvOCɂ͗płȂ|Ԃ */
+static IUnityInterface* UNITY_INTERFACE_API getInterface(UnityInterfaceGUID guid)
+{
+	const UnityInterfaceGUID graphicsGuid = GetUnityInterfaceGUID<IUnityGraphics>();
+	if (guid.m_GUIDHigh == graphicsGuid.m_GUIDHigh && guid.m_GUIDLow == graphicsGuid.m_GUIDLow)
+		return reinterpret_cast<IUnityInterface*>(&s_Graphics);
+	return NULL;
+}
+
+static IUnityInterfaces s_Interfaces = { getInterface, NULL, NULL, NULL };
+
+
+/** EBhE GL 3.3 Core ̃ReLXg쐬āÃ݂Xbhɐݒ肷 */
+static bool createHeadlessContext()
+{
+	EGLDisplay display = EGL_NO_DISPLAY;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	EGLint major, minor;
+	if (!eglInitialize(display, &major, &minor)) return false;
+	if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+	const EGLint configAttrs[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+	EGLConfig config = NULL;
+	EGLint configCount = 0;
+	eglChooseConfig(display, configAttrs, &config, 1, &configCount);
+
+	const EGLint contextAttrs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	EGLContext context = eglCreateContext(display, 0 < configCount ? config : NULL, EGL_NO_CONTEXT, contextAttrs);
+	if (context == EGL_NO_CONTEXT) return false;
+	return eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE;
+}
+
+
+// --------------------------------------------------------------------------
+// L^̃eNX`̍Č
+
+
+/** L^̃nhɑΉteNX` */
+struct ReplayTexture
+{
+	GLuint tex;
+	int kind;				//!< CaptureTextureKind
+	int width;
+	int height;
+	bool isOwned;			//!< ̃c[쐬̂ۂBvOC쐬̂͋L^ǂɔj
+};
+
+static std::unordered_map<uint64_t, ReplayTexture> s_Textures;
+
+/** 傫L^ĂȂꍇɎg傫 */
+static const int kDefaultTextureSize = 256;
+
+static GLenum glInternalFormat(int format)
+{
+	switch (format) {
+	case kPixelFormatRGBA8_SRGB : return GL_SRGB8_ALPHA8;
+	case kPixelFormatRGBAHalf : return GL_RGBA16F;
+	default : return GL_RGBA8;
+	}
+}
+
+static GLuint createTexture(const CaptureTexture& t, int width, int height)
+{
+	GLuint tex = 0;
+	glGenTextures(1, &tex);
+	if (t.kind == kCaptureTextureCube) {
+		// ~bvȂꍇ́A~bvg(pڕ␳Ȃ)ł悤ɑSi
+		int mipCount = t.mipCount;
+		if (mipCount == 0) while ((width >> mipCount) != 0) ++mipCount;
+		glBindTexture(GL_TEXTURE_CUBE_MAP, tex);
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, mipCount, glInternalFormat(t.format), width, width);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	} else {
+		glBindTexture(GL_TEXTURE_2D, tex);
+		glTexStorage2D(GL_TEXTURE_2D, 1, glInternalFormat(t.format), width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	return tex;
+}
+
+/**
+ * L^̃eNX`ɑΉAĐp̃lCeBueNX`ԂB
+ * m̃nhAށE傫ȂȂ̃c[̃eNX`͍蒼
+ */
+static void* resolveTexture(const CaptureTexture& t)
+{
+	if (t.handle == 0) return NULL;
+
+	auto it = s_Textures.find(t.handle);
+	if (it != s_Textures.end()) {
+		ReplayTexture& r = it->second;
+		const bool isMatched = r.kind == t.kind && (t.width == 0 || (r.width == t.width && r.height == t.height));
+		if (!r.isOwned || isMatched) return (void*)(size_t)r.tex;
+
+		glDeleteTextures(1, &r.tex);
+		s_Textures.erase(it);
+	}
+
+	const int width = t.width != 0 ? t.width : kDefaultTextureSize;
+	const int height = t.height != 0 ? t.height : width;
+	ReplayTexture r;
+	r.tex = createTexture(t, width, height);
+	r.kind = t.kind;
+	r.width = width;
+	r.height = height;
+	r.isOwned = true;
+	s_Textures[t.handle] = r;
+	return (void*)(size_t)r.tex;
+}
+
+/** vOC쐬eNX`AL^̃nhɑΉt */
+static void bindPluginTexture(uint64_t handle, void* tex, int kind, int size)
+{
+	if (handle == 0 || !tex) return;
+
+	auto it = s_Textures.find(handle);
+	if (it != s_Textures.end() && it->second.isOwned) glDeleteTextures(1, &it->second.tex);
+
+	ReplayTexture r;
+	r.tex = (GLuint)(size_t)tex;
+	r.kind = kind;
+	r.width = size;
+	r.height = size;
+	r.isOwned = false;
+	s_Textures[handle] = r;
+}
+
+/** L^̃nh̑ΉOāAΉĂeNX`ԂBm̏ꍇNULL */
+static void* unbindTexture(uint64_t handle)
+{
+	auto it = s_Textures.find(handle);
+	if (it == s_Textures.end()) return NULL;
+
+	void* tex = (void*)(size_t)it->second.tex;
+	s_Textures.erase(it);
+	return tex;
+}
+
+static void destroyOwnedTextures()
+{
+	for (auto& kv : s_Textures) {
+		if (kv.second.isOwned) glDeleteTextures(1, &kv.second.tex);
+	}
+	s_Textures.clear();
+}
+
+
+// --------------------------------------------------------------------------
+// zXgobt@Et@C̍Č
+
+
+/** CPUp̃_~[̃obt@BprƂɎg񂵁AȂȂL */
+static std::vector<unsigned char> s_HostSrc;
+static std::vector<unsigned char> s_HostDst;
+
+static unsigned char* hostBuffer(std::vector<unsigned char>* buf, size_t bytes)
+{
+	if (buf->size() < bytes) buf->resize(bytes, 0x80);
+	return buf->data();
+}
+
+static size_t cubemapBytes(int size) { return cubemapFaceBytes(size, 0, kPixelFormatRGBA8) * 6; }
+static size_t imageBytes(int width, int height) { return (size_t)(width < 0 ? 0 : width) * (height < 0 ? 0 : height) * 4; }
+
+/** ꎞt@C̃pXBIɍ폜 */
+static std::vector<std::string> s_TempFiles;
+static std::unordered_map<std::string, std::string> s_KTX2Files;
+
+static std::string tempFilePath(const char* name)
+{
+	const char* dir = getenv("TMPDIR");
+	char buf[512];
+	snprintf(buf, sizeof(buf), "%s/PluginReplay_%d_%zu_%s", dir && *dir ? dir : "/tmp", (int)getpid(), s_TempFiles.size(), name);
+	s_TempFiles.push_back(buf);
+	return buf;
+}
+
+/** WriteKTX2Cubemap ŁA_~[̓ẽt@CށB1 */
+static int writeDummyKTX2(const char* path, int size, int mipCount, int format)
+{
+	if (size <= 0 || mipCount <= 0 || 32 < mipCount || pixelFormatBytes(format) == 0) return 0;
+
+	// e͎gȂ̂ŁAS~bvōŏʂ̃obt@L
+	const unsigned char* data = hostBuffer(&s_HostSrc, cubemapFaceBytes(size, 0, format) * 6);
+	std::vector<const void*> levelData(mipCount, data);
+	return WriteKTX2Cubemap(path, size, mipCount, format, levelData.data(), NULL);
+}
+
+/** L^Ɠ傫E~bvE`KTX2t@CpӂāÃpXԂBs͋󕶎 */
+static std::string dummyKTX2File(int size, int mipCount, int format)
+{
+	char key[64];
+	snprintf(key, sizeof(key), "%d_%d_%d", size, mipCount, format);
+	auto it = s_KTX2Files.find(key);
+	if (it != s_KTX2Files.end()) return it->second;
+
+	std::string path = tempFilePath((std::string(key) + ".ktx2").c_str());
+	if (!writeDummyKTX2(path.c_str(), size, mipCount, format)) path.clear();
+	s_KTX2Files[key] = path;
+	return path;
+}
+
+static void removeTempFiles()
+{
+	for (size_t i=0; i<s_TempFiles.size(); ++i) unlink(s_TempFiles[i].c_str());
+	s_TempFiles.clear();
+	s_KTX2Files.clear();
+}
+
+
+// --------------------------------------------------------------------------
+// Đ
+
+
+static const char* const kRecordNames[kCaptureRecordTypeCount] = {
+	"(unknown)",
+	"BlitCubemap",
+	"ConvertCubemapToProjection",
+	"ConvertProjectionToCubemap",
+	"ConvertCubemapToProjectionCPU",
+	"ConvertProjectionToCubemapCPU",
+	"RotateCubemap",
+	"RotateCubemapCPU",
+	"FixupCubemapSeams",
+	"FixupCubemapSeamsCPU",
+	"BlurCubemap",
+	"BlurCubemapCPU",
+	"ComputeCubemapLuminanceStats",
+	"GetCubemapLuminanceStats",
+	"ComputeCubemapLuminanceStatsCPU",
+	"WriteKTX2Cubemap",
+	"LoadKTX2CubemapLevels",
+	"CreateCubemap",
+	"DestroyCubemap",
+	"CreateCubemapFaceViews",
+	"DestroyTextureView",
+};
+
+/** R[h̎ނƂ̏Wv */
+struct RecordStats
+{
+	uint64_t count;
+	uint64_t failureCount;		//!< ĐɎs
+	uint64_t capturedNs;		//!< L^̏vԂ̍v
+	uint64_t replayedNs;		//!< Đ̏vԂ̍v
+};
+
+/** ǂݍ񂾃R[hBpayload ̓OŜ̃obt@w */
+struct Record
+{
+	PluginCaptureRecordHeader header;
+	const unsigned char* payload;
+};
+
+/** yC[hǂݏoBL^̕Zꍇ(Â`Ȃ)͎c0Ƃ݂Ȃ */
+template<typename Payload>
+static Payload readPayload(const Record& r)
+{
+	Payload p;
+	memset(&p, 0, sizeof(p));
+	memcpy(&p, r.payload, r.header.payloadBytes < sizeof(p) ? r.header.payloadBytes : sizeof(p));
+	return p;
+}
+
+/** 1R[hĐBĂяoꍇtrue */
+static bool replayRecord(const Record& r)
+{
+	switch (r.header.type) {
+	case kCaptureRecordBlitCubemap : {
+		const CaptureBlitCubemap p = readPayload<CaptureBlitCubemap>(r);
+		void* src[6];
+		for (int i=0; i<6; ++i) src[i] = resolveTexture(p.src[i]);
+		BlitCubemap(src[0], src[1], src[2], src[3], src[4], src[5], resolveTexture(p.dst), p.size);
+		return true;
+		}
+
+	case kCaptureRecordConvertCubemapToProjection : {
+		const CaptureConvertCubemapToProjection p = readPayload<CaptureConvertCubemapToProjection>(r);
+		return ConvertCubemapToProjection(resolveTexture(p.src), resolveTexture(p.dst), p.width, p.height, p.projection) != 0;
+		}
+
+	case kCaptureRecordConvertProjectionToCubemap : {
+		const CaptureConvertProjectionToCubemap p = readPayload<CaptureConvertProjectionToCubemap>(r);
+		return ConvertProjectionToCubemap(resolveTexture(p.src), resolveTexture(p.dst), p.size, p.projection) != 0;
+		}
+
+	case kCaptureRecordConvertCubemapToProjectionCPU : {
+		const CaptureCpuOp p = readPayload<CaptureCpuOp>(r);
+		return ConvertCubemapToProjectionCPU(
+			hostBuffer(&s_HostSrc, cubemapBytes(p.size)), p.size,
+			hostBuffer(&s_HostDst, imageBytes(p.width, p.height)), p.width, p.height, p.projection
+		) != 0;
+		}
+
+	case kCaptureRecordConvertProjectionToCubemapCPU : {
+		const CaptureCpuOp p = readPayload<CaptureCpuOp>(r);
+		return ConvertProjectionToCubemapCPU(
+			hostBuffer(&s_HostSrc, imageBytes(p.width, p.height)), p.width, p.height,
+			hostBuffer(&s_HostDst, cubemapBytes(p.size)), p.size, p.projection
+		) != 0;
+		}
+
+	case kCaptureRecordRotateCubemap : {
+		const CaptureRotateCubemap p = readPayload<CaptureRotateCubemap>(r);
+		return RotateCubemap(resolveTexture(p.src), resolveTexture(p.dst), p.size, p.rotation) != 0;
+		}
+
+	case kCaptureRecordRotateCubemapCPU : {
+		const CaptureCpuOp p = readPayload<CaptureCpuOp>(r);
+		unsigned char* src = hostBuffer(&s_HostSrc, cubemapBytes(p.size));
+		unsigned char* dst = p.isInPlace ? src : hostBuffer(&s_HostDst, cubemapBytes(p.size));
+		return RotateCubemapCPU(src, dst, p.size, p.rotation) != 0;
+		}
+
+	case kCaptureRecordFixupCubemapSeams : {
+		const CaptureFixupCubemapSeams p = readPayload<CaptureFixupCubemapSeams>(r);
+		return FixupCubemapSeams(resolveTexture(p.tex), p.size, p.mipCount) != 0;
+		}
+
+	case kCaptureRecordFixupCubemapSeamsCPU : {
+		const CaptureCpuOp p = readPayload<CaptureCpuOp>(r);
+		return FixupCubemapSeamsCPU(hostBuffer(&s_HostSrc, cubemapBytes(p.size)), p.size) != 0;
+		}
+
+	case kCaptureRecordBlurCubemap : {
+		const CaptureBlurCubemap p = readPayload<CaptureBlurCubemap>(r);
+		return BlurCubemap(resolveTexture(p.src), resolveTexture(p.dst), p.size, p.sigma) != 0;
+		}
+
+	case kCaptureRecordBlurCubemapCPU : {
+		const CaptureCpuOp p = readPayload<CaptureCpuOp>(r);
+		unsigned char* src = hostBuffer(&s_HostSrc, cubemapBytes(p.size));
+		unsigned char* dst = p.isInPlace ? src : hostBuffer(&s_HostDst, cubemapBytes(p.size));
+		return BlurCubemapCPU(src, dst, p.size, p.sigma) != 0;
+		}
+
+	case kCaptureRecordComputeLuminanceStats : {
+		const CaptureComputeLuminanceStats p = readPayload<CaptureComputeLuminanceStats>(r);
+		return ComputeCubemapLuminanceStats(resolveTexture(p.tex), p.size, p.minLog2Lum, p.maxLog2Lum) != 0;
+		}
+
+	case kCaptureRecordGetLuminanceStats : {
+		CubemapLuminanceStats stats;
+		return GetCubemapLuminanceStats(&stats) != 0;
+		}
+
+	case kCaptureRecordComputeLuminanceStatsCPU : {
+		const CaptureCpuOp p = readPayload<CaptureCpuOp>(r);
+		CubemapLuminanceStats stats;
+		return ComputeCubemapLuminanceStatsCPU(hostBuffer(&s_HostSrc, cubemapBytes(p.size)), p.size, p.isSRGB, p.minLog2Lum, p.maxLog2Lum, &stats) != 0;
+		}
+
+	case kCaptureRecordWriteKTX2Cubemap : {
+		const CaptureWriteKTX2Cubemap p = readPayload<CaptureWriteKTX2Cubemap>(r);
+		static std::string s_writePath;
+		if (s_writePath.empty()) s_writePath = tempFilePath("write.ktx2");
+		return writeDummyKTX2(s_writePath.c_str(), p.size, p.mipCount, p.format) != 0;
+		}
+
+	case kCaptureRecordLoadKTX2CubemapLevels : {
+		const CaptureLoadKTX2CubemapLevels p = readPayload<CaptureLoadKTX2CubemapLevels>(r);
+		const std::string path = dummyKTX2File(p.fileSize, p.fileMipCount, p.fileFormat);
+		if (path.empty()) return false;
+		return LoadKTX2CubemapLevels(path.c_str(), NULL, resolveTexture(p.dst), p.firstLevel, p.levelCount, p.dstFirstLevel) != 0;
+		}
+
+	case kCaptureRecordCreateCubemap : {
+		const CaptureCreateCubemap p = readPayload<CaptureCreateCubemap>(r);
+		void* tex = CreateCubemap(p.size, p.mipCount, p.format);
+		bindPluginTexture(p.result, tex, kCaptureTextureCube, p.size);
+		return tex != NULL;
+		}
+
+	case kCaptureRecordDestroyCubemap : {
+		const CaptureDestroyTexture p = readPayload<CaptureDestroyTexture>(r);
+		void* tex = unbindTexture(p.handle);
+		return tex && DestroyCubemap(tex) != 0;
+		}
+
+	case kCaptureRecordCreateCubemapFaceViews : {
+		const CaptureCreateCubemapFaceViews p = readPayload<CaptureCreateCubemapFaceViews>(r);
+		void* cubemap = resolveTexture(p.cubemap);
+		void* views[6] = {};
+		if (!CreateCubemapFaceViews(cubemap, views)) return false;
+
+		const auto it = s_Textures.find(p.cubemap.handle);
+		const int size = it != s_Textures.end() ? it->second.width : 0;
+		for (int i=0; i<6; ++i) bindPluginTexture(p.results[i], views[i], kCaptureTexture2D, size);
+		return true;
+		}
+
+	case kCaptureRecordDestroyTextureView : {
+		const CaptureDestroyTexture p = readPayload<CaptureDestroyTexture>(r);
+		void* tex = unbindTexture(p.handle);
+		return tex && DestroyTextureView(tex) != 0;
+		}
+
+	default :
+		return false;
+	}
+}
+
+/** OŜǂݍŃR[hɕB`قȂꍇfalse */
+static bool loadCapture(const char* path, std::vector<unsigned char>* data, std::vector<Record>* records, PluginCaptureFileHeader* header)
+{
+	FILE* fp = fopen(path, "rb");
+	if (!fp) {
+		fprintf(stderr, "failed to open '%s'\n", path);
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	const long bytes = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	data->resize(0 < bytes ? (size_t)bytes : 0);
+	const bool isRead = !data->empty() && fread(data->data(), data->size(), 1, fp) == 1;
+	fclose(fp);
+
+	if (!isRead || data->size() < sizeof(PluginCaptureFileHeader)) {
+		fprintf(stderr, "failed to read '%s'\n", path);
+		return false;
+	}
+	memcpy(header, data->data(), sizeof(*header));
+	if (header->magic != kPluginCaptureMagic || header->version != kPluginCaptureVersion) {
+		fprintf(stderr, "'%s' is not a plugin capture (or has an unsupported version)\n", path);
+		return false;
+	}
+
+	size_t pos = sizeof(PluginCaptureFileHeader);
+	while (pos + sizeof(PluginCaptureRecordHeader) <= data->size()) {
+		Record r;
+		memcpy(&r.header, data->data() + pos, sizeof(r.header));
+		pos += sizeof(r.header);
+		// ݓrŏIÓAŌ̊SȃR[h܂łg
+		if (data->size() < pos + r.header.payloadBytes) break;
+		r.payload = data->data() + pos;
+		pos += r.header.payloadBytes;
+		records->push_back(r);
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const char* path = NULL;
+	bool isRealtime = false;
+	bool isFinishEach = false;
+	int repeatCount = 1;
+	bool isValidArgs = true;
+
+	for (int i=1; i<argc; ++i) {
+		const char* a = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (!strcmp(a, "--realtime")) isRealtime = true;
+		else if (!strcmp(a, "--finish")) isFinishEach = true;
+		else if (!strcmp(a, "--repeat") && hasValue) repeatCount = atoi(argv[++i]);
+		else if (a[0] != '-' && !path) path = a;
+		else isValidArgs = false;
+	}
+	if (!isValidArgs || !path || repeatCount <= 0) {
+		fprintf(stderr, "usage: %s [--realtime] [--finish] [--repeat count] capture.bin\n", argv[0]);
+		return 2;
+	}
+
+	std::vector<unsigned char> data;
+	std::vector<Record> records;
+	PluginCaptureFileHeader header;
+	if (!loadCapture(path, &data, &records, &header)) return 1;
+
+	if (!createHeadlessContext()) {
+		fprintf(stderr, "failed to create a headless OpenGL context\n");
+		return 1;
+	}
+	printf(
+		"replaying %zu records from '%s' (captured on renderer %u) on %s / %s\n",
+		records.size(), path, header.renderer,
+		(const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION)
+	);
+
+	// UnityPluginLoad ̒ŏCxgÃ݂ReLXgŃvOC
+	initGraphicsInterface();
+	UnityPluginLoad(&s_Interfaces);
+
+	RecordStats stats[kCaptureRecordTypeCount];
+	memset(stats, 0, sizeof(stats));
+	const Clock::time_point start = Clock::now();
+
+	for (int pass=0; pass<repeatCount; ++pass) {
+		const Clock::time_point passStart = Clock::now();
+		for (size_t i=0; i<records.size(); ++i) {
+			const Record& r = records[i];
+			// R[h͏IȂ̂ŁAJnOシ镪͑҂ɌĂ
+			if (isRealtime) std::this_thread::sleep_until(passStart + std::chrono::nanoseconds(r.header.beginNs));
+
+			const Clock::time_point t0 = Clock::now();
+			const bool isSucceeded = replayRecord(r);
+			if (isFinishEach) glFinish();
+			const uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+			RecordStats& s = stats[r.header.type < kCaptureRecordTypeCount ? r.header.type : 0];
+			++s.count;
+			if (!isSucceeded) ++s.failureCount;
+			s.capturedNs += r.header.durationNs;
+			s.replayedNs += ns;
+		}
+	}
+	glFinish();
+	const double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	printf("%-32s %8s %8s %14s %14s\n", "record", "count", "failed", "captured(ms)", "replayed(ms)");
+	for (int i=0; i<kCaptureRecordTypeCount; ++i) {
+		const RecordStats& s = stats[i];
+		if (s.count == 0) continue;
+		printf(
+			"%-32s %8llu %8llu %14.3f %14.3f\n",
+			kRecordNames[i], (unsigned long long)s.count, (unsigned long long)s.failureCount,
+			s.capturedNs / 1e6, s.replayedNs / 1e6
+		);
+	}
+	printf("wall time %.3f ms (%d pass%s, %s)\n", wallMs, repeatCount, repeatCount == 1 ? "" : "es", isRealtime ? "realtime" : "max speed");
+
+	if (s_DeviceEventCallback) s_DeviceEventCallback(kUnityGfxDeviceEventShutdown);
+	UnityPluginUnload();
+	destroyOwnedTextures();
+	removeTempFiles();
+	return 0;
+}
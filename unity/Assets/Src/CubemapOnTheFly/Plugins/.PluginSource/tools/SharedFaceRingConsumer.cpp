@@ -0,0 +1,262 @@
+//
+// SharedFaceRing ̓ǂݍݑ̊mFpvOB
+// ݑJʂARs[Ƀ}bv܂ܓǂݍŁAX[vbgƓǂݍ݂̎s\B
+//
+//   SharedFaceRingConsumer [-n O] [-t b]
+//       vOC쐬OǂݍށBO쐬܂ő҂
+//   SharedFaceRingConsumer --self-test [-n O] [-t b] [-s ʂ̑傫] [-c Xbg]
+//       vZX̕ʃXbhŏݑ𓮂Aeǂ߂邩mF
+//
+// rh : projects/GNUMake  make tools
+//
+
+#include "SharedFaceRing.h"
+#include "PixelFormat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+typedef std::chrono::steady_clock Clock;
+
+
+/** ǂݍݑ猩OBǂݍݐpŃ}bv */
+struct RingView
+{
+	const unsigned char* base;
+	size_t bytes;
+	const SharedFaceRingHeader* header;
+
+	const SharedFaceRingSlot* slot(uint64_t index) const {
+		return reinterpret_cast<const SharedFaceRingSlot*>(
+			base + header->headerBytes + header->slotBytes * (index % header->slotCount)
+		);
+	}
+};
+
+/** OtLǂݍݐpŃ}bvBĂȂꍇfalse */
+static bool openRing(const std::string& name, RingView* out)
+{
+	int fd = shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SharedFaceRingHeader)) {
+		close(fd);
+		return false;
+	}
+	void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) return false;
+
+	const SharedFaceRingHeader* h = static_cast<const SharedFaceRingHeader*>(p);
+	if (
+		h->magic.load(std::memory_order_acquire) != kSharedFaceRingMagic ||
+		h->version != kSharedFaceRingVersion ||
+		(size_t)st.st_size < h->headerBytes + h->slotBytes * h->slotCount
+	) {
+		munmap(p, (size_t)st.st_size);
+		return false;
+	}
+
+	out->base = static_cast<const unsigned char*>(p);
+	out->bytes = (size_t)st.st_size;
+	out->header = h;
+	return true;
+}
+
+/** ǂݍ݂̏Wv */
+struct ConsumerStats
+{
+	uint64_t faceCount;			//!< ǂݍ߂ʂ̐
+	uint64_t byteCount;			//!< ǂݍ߂f[^̃oCg
+	uint64_t droppedCount;		//!< ǂݍޑOɏ㏑Ď肱ڂʂ̐
+	uint64_t tornCount;			//!< Qƒɏ݂n܂ēǂݒ
+	uint64_t mismatchCount;		//!< e҂ƈقȂʂ̐(--self-test̂)
+};
+
+/** ȃeXgŏޒlBʂ̃f[^ׂ͂Ă̒l64bitŖ߂ */
+static uint64_t testPattern(uint64_t frameId, uint32_t face) { return frameId * 8 + face + 1; }
+
+/**
+ * Jς݂̖ʂɓǂݍށBf[^̓}bv܂64bitPʂōvA
+ * V[PXԍOňvꍇLƂ
+ */
+static void consume(const RingView& ring, double seconds, bool verify, ConsumerStats* stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	const SharedFaceRingHeader* h = ring.header;
+	uint64_t next = h->publishedCount.load(std::memory_order_acquire);
+
+	const Clock::time_point start = Clock::now();
+	Clock::time_point lastReport = start;
+	uint64_t lastBytes = 0;
+
+	for (;;) {
+		const Clock::time_point now = Clock::now();
+		const double elapsed = std::chrono::duration<double>(now - start).count();
+		if (seconds <= elapsed) break;
+		if (1.0 <= std::chrono::duration<double>(now - lastReport).count()) {
+			const double dt = std::chrono::duration<double>(now - lastReport).count();
+			printf(
+				"  %6.1fs : %8.1f MB/s, faces %llu, dropped %llu, torn %llu\n",
+				elapsed, (stats->byteCount - lastBytes) / dt / (1024.0 * 1024.0),
+				(unsigned long long)stats->faceCount,
+				(unsigned long long)stats->droppedCount,
+				(unsigned long long)stats->tornCount
+			);
+			lastReport = now;
+			lastBytes = stats->byteCount;
+		}
+
+		const uint64_t published = h->publishedCount.load(std::memory_order_acquire);
+		if (next == published) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		// ݑ1ǂzꂽꍇ́Aɂ܂㏑Ȃ悤ɃO̔܂Ői߂ēǂݒ
+		if (h->slotCount <= published - next) {
+			const uint64_t skipTo = published - (h->slotCount + 1) / 2;
+			stats->droppedCount += skipTo - next;
+			next = skipTo;
+		}
+
+		const SharedFaceRingSlot* slot = ring.slot(next);
+		const uint32_t seq0 = slot->sequence.load(std::memory_order_acquire);
+		if (seq0 & 1) {
+			++stats->tornCount;
+			continue;
+		}
+
+		const uint64_t index = slot->index;
+		const uint64_t frameId = slot->frameId;
+		const uint32_t face = slot->face;
+		const size_t dataBytes = (size_t)slot->dataBytes;
+		const uint64_t* words = reinterpret_cast<const uint64_t*>(
+			reinterpret_cast<const unsigned char*>(slot) + kSharedFaceRingSlotDataOffset
+		);
+		const size_t wordCount = dataBytes < h->slotBytes ? dataBytes / 8 : 0;
+		uint64_t sum = 0;
+		for (size_t i=0; i<wordCount; ++i) sum += words[i];
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot->sequence.load(std::memory_order_relaxed) != seq0 || index != next) {
+			// Qƒɏ㏑ꂽB̎Ŏ肱ڂƂĐ
+			++stats->tornCount;
+			if (index != next && next < index) next = index;
+			continue;
+		}
+
+		if (verify && sum != testPattern(frameId, face) * wordCount) ++stats->mismatchCount;
+		++stats->faceCount;
+		stats->byteCount += dataBytes;
+		++next;
+	}
+}
+
+static void printResult(const ConsumerStats& stats, double seconds)
+{
+	printf(
+		"faces %llu (%.1f/s), %.1f MB/s, dropped %llu, torn %llu, mismatch %llu\n",
+		(unsigned long long)stats.faceCount, stats.faceCount / seconds,
+		stats.byteCount / seconds / (1024.0 * 1024.0),
+		(unsigned long long)stats.droppedCount,
+		(unsigned long long)stats.tornCount,
+		(unsigned long long)stats.mismatchCount
+	);
+}
+
+/** ȃeXgBʃXbh̏ݑS͂ŌJʂǂݍ */
+static int runSelfTest(const std::string& name, double seconds, int faceSize, int slotCount)
+{
+	SharedFaceRing writer;
+	if (!writer.create(name.c_str(), slotCount, faceSize, kPixelFormatRGBA8)) {
+		fprintf(stderr, "failed to create ring '%s'\n", name.c_str());
+		return 1;
+	}
+	RingView ring;
+	if (!openRing(name[0] == '/' ? name : "/" + name, &ring)) {
+		fprintf(stderr, "failed to open ring '%s'\n", name.c_str());
+		return 1;
+	}
+
+	const size_t faceBytes = cubemapFaceBytes(faceSize, 0, kPixelFormatRGBA8);
+	std::vector<uint64_t> faces(faceBytes * 6 / 8);
+	std::atomic<bool> isRunning(true);
+	uint64_t publishedFrames = 0;
+
+	std::thread producer([&]() {
+		for (uint64_t frameId=0; isRunning.load(std::memory_order_relaxed); ++frameId) {
+			for (int f=0; f<6; ++f) {
+				uint64_t* dst = &faces[faceBytes / 8 * f];
+				std::fill(dst, dst + faceBytes / 8, testPattern(frameId, f));
+				writer.publish(f, faceSize, kPixelFormatRGBA8, frameId, dst);
+			}
+			publishedFrames = frameId + 1;
+		}
+	});
+
+	printf("self test : ring '%s', face %dx%d RGBA8, %d slots\n", name.c_str(), faceSize, faceSize, slotCount);
+	ConsumerStats stats;
+	consume(ring, seconds, true, &stats);
+	isRunning = false;
+	producer.join();
+
+	printf("published %llu cubemaps\n", (unsigned long long)publishedFrames);
+	printResult(stats, seconds);
+	munmap(const_cast<unsigned char*>(ring.base), ring.bytes);
+	writer.close();
+	return stats.mismatchCount == 0 && 0 < stats.faceCount ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+	std::string name = "/CubemapOnTheFly";
+	double seconds = 5;
+	int faceSize = 512;
+	int slotCount = 12;
+	bool isSelfTest = false;
+
+	for (int i=1; i<argc; ++i) {
+		const char* a = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (!strcmp(a, "--self-test")) isSelfTest = true;
+		else if (!strcmp(a, "-n") && hasValue) name = argv[++i];
+		else if (!strcmp(a, "-t") && hasValue) seconds = atof(argv[++i]);
+		else if (!strcmp(a, "-s") && hasValue) faceSize = atoi(argv[++i]);
+		else if (!strcmp(a, "-c") && hasValue) slotCount = atoi(argv[++i]);
+		else {
+			fprintf(stderr, "usage: %s [--self-test] [-n name] [-t seconds] [-s faceSize] [-c slotCount]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (name[0] != '/') name = "/" + name;
+	if (isSelfTest) return runSelfTest(name, seconds, faceSize, slotCount);
+
+	// vOCŃO쐬܂ő҂
+	RingView ring;
+	printf("waiting for ring '%s' ...\n", name.c_str());
+	while (!openRing(name, &ring)) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	printf(
+		"ring '%s' : writer pid %llu, %u slots, max face %u\n",
+		name.c_str(), (unsigned long long)ring.header->writerPid,
+		ring.header->slotCount, ring.header->maxFaceSize
+	);
+
+	ConsumerStats stats;
+	consume(ring, seconds, false, &stats);
+	printResult(stats, seconds);
+	munmap(const_cast<unsigned char*>(ring.base), ring.bytes);
+	return 0;
+}
@@ -1,5 +1,6 @@
 using System;
 using UnityEngine;
+using UnityEngine.Rendering;
 using System.Runtime.InteropServices;
 
 
@@ -36,9 +37,487 @@ static class CubemapBuilderPlugin {
 		);
 	}
 
+	/**
+	 * キューブマップへ各面のテクスチャをBlitする処理を、レンダースレッドで実行するコマンドとしてキューへ追加する。
+	 * 任意のスレッドから呼べる。追加したコマンドは RenderEventId.ExecuteCommands のイベントで追加順に実行される。
+	 * キューが満杯の場合と、コマンドのキューが無い古いプラグインの場合はfalseを返す。
+	 * どちらなのかは isEnqueueBlitAvailable で判断する
+	 */
+	public static bool enqueueBlitTex2Cubemap(
+		IntPtr srcTex0,
+		IntPtr srcTex1,
+		IntPtr srcTex2,
+		IntPtr srcTex3,
+		IntPtr srcTex4,
+		IntPtr srcTex5,
+		IntPtr cubemapTex,
+		int texWidth
+	) {
+		if (!s_isEnqueueBlitAvailable) return false;
+		checkInitialized();
+
+		try {
+			// コマンドを実行するイベントの関数も無い場合は、積んだコマンドが実行されないので積まない
+			GetRenderEventAndDataFunc();
+			return EnqueueBlitCubemap(
+				srcTex0,
+				srcTex1,
+				srcTex2,
+				srcTex3,
+				srcTex4,
+				srcTex5,
+				cubemapTex,
+				texWidth
+			) != 0;
+		} catch (EntryPointNotFoundException) {
+			s_isEnqueueBlitAvailable = false;
+			return false;
+		}
+	}
+
+	/** enqueueBlitTex2Cubemap が使えるか否か。falseの場合は blitTex2Cubemap でその場でBlitする */
+	public static bool isEnqueueBlitAvailable => s_isEnqueueBlitAvailable;
+
+
+	/** キューブマップを指定の投影法の2Dテクスチャへ変換する(GPU)。未対応の場合はfalseを返す */
+	public static bool convertCubemapToProjection(
+		IntPtr cubemapTex,
+		IntPtr dstTex,
+		int dstWidth,
+		int dstHeight,
+		int projection
+	) {
+		checkInitialized();
+		return ConvertCubemapToProjection(cubemapTex, dstTex, dstWidth, dstHeight, projection) != 0;
+	}
+
+	/** 指定の投影法の2Dテクスチャをキューブマップへ変換する(GPU)。未対応の場合はfalseを返す */
+	public static bool convertProjectionToCubemap(
+		IntPtr srcTex,
+		IntPtr cubemapTex,
+		int cubemapSize,
+		int projection
+	) {
+		checkInitialized();
+		return ConvertProjectionToCubemap(srcTex, cubemapTex, cubemapSize, projection) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(6面連続)を、指定の投影法の2D画像へ変換する(CPU) */
+	public static bool convertCubemapToProjectionCPU(
+		IntPtr srcFaces,
+		int srcSize,
+		IntPtr dst,
+		int dstWidth,
+		int dstHeight,
+		int projection
+	) {
+		checkInitialized();
+		return ConvertCubemapToProjectionCPU(srcFaces, srcSize, dst, dstWidth, dstHeight, projection) != 0;
+	}
+
+	/** ホスト側バッファ上の指定投影法の2D画像を、キューブマップ(6面連続)へ変換する(CPU) */
+	public static bool convertProjectionToCubemapCPU(
+		IntPtr src,
+		int srcWidth,
+		int srcHeight,
+		IntPtr dstFaces,
+		int dstSize,
+		int projection
+	) {
+		checkInitialized();
+		return ConvertProjectionToCubemapCPU(src, srcWidth, srcHeight, dstFaces, dstSize, projection) != 0;
+	}
+
+	/**
+	 * キューブマップに回転を適用して書き込む(GPU)。未対応の場合はfalseを返す。
+	 * rotationは行優先の3x3行列で、出力の方向dには入力の rotation * d の方向の色が入る
+	 */
+	public static bool rotateCubemap(
+		IntPtr srcCubemapTex,
+		IntPtr dstCubemapTex,
+		int size,
+		float[] rotation
+	) {
+		checkInitialized();
+		return RotateCubemap(srcCubemapTex, dstCubemapTex, size, rotation) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(6面連続)に回転を適用して書き込む(CPU) */
+	public static bool rotateCubemapCPU(
+		IntPtr srcFaces,
+		IntPtr dstFaces,
+		int size,
+		float[] rotation
+	) {
+		checkInitialized();
+		return RotateCubemapCPU(srcFaces, dstFaces, size, rotation) != 0;
+	}
+
+	/** キューブマップの各面の縁を隣接面と平均して継ぎ目を修正する(GPU)。先頭からmipCount段に適用する */
+	public static bool fixupCubemapSeams(
+		IntPtr cubemapTex,
+		int size,
+		int mipCount
+	) {
+		checkInitialized();
+		return FixupCubemapSeams(cubemapTex, size, mipCount) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(6面連続)の継ぎ目を修正する(CPU) */
+	public static bool fixupCubemapSeamsCPU(
+		IntPtr faces,
+		int size
+	) {
+		checkInitialized();
+		return FixupCubemapSeamsCPU(faces, size) != 0;
+	}
+
+	/** キューブマップにガウシアンぼかしをかけて書き込む(GPU)。sigmaはテクセル単位 */
+	public static bool blurCubemap(
+		IntPtr srcCubemapTex,
+		IntPtr dstCubemapTex,
+		int size,
+		float sigma
+	) {
+		checkInitialized();
+		return BlurCubemap(srcCubemapTex, dstCubemapTex, size, sigma) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(6面連続)にガウシアンぼかしをかけて書き込む(CPU) */
+	public static bool blurCubemapCPU(
+		IntPtr srcFaces,
+		IntPtr dstFaces,
+		int size,
+		float sigma
+	) {
+		checkInitialized();
+		return BlurCubemapCPU(srcFaces, dstFaces, size, sigma) != 0;
+	}
+
+	/** キューブマップの輝度統計をGPU上で集計する */
+	public static bool computeCubemapLuminanceStats(
+		IntPtr cubemapTex,
+		int size,
+		float minLog2Lum,
+		float maxLog2Lum
+	) {
+		checkInitialized();
+		return ComputeCubemapLuminanceStats(cubemapTex, size, minLog2Lum, maxLog2Lum) != 0;
+	}
+
+	/** 直近に集計した輝度統計を取得する */
+	public static bool getCubemapLuminanceStats(out LuminanceStats stats) {
+		checkInitialized();
+		return GetCubemapLuminanceStats(out stats) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(RGBA8・6面連続)の輝度統計を求める(CPU)。isSRGBの場合はRGBを線形値に変換して求める */
+	public static bool computeCubemapLuminanceStatsCPU(
+		IntPtr faces,
+		int size,
+		bool isSRGB,
+		float minLog2Lum,
+		float maxLog2Lum,
+		out LuminanceStats stats
+	) {
+		checkInitialized();
+		return ComputeCubemapLuminanceStatsCPU(faces, size, isSRGB ? 1 : 0, minLog2Lum, maxLog2Lum, out stats) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(全ミップ・各6面分)をKTX2ファイルとして書き込む */
+	public static bool writeKTX2Cubemap(
+		string path,
+		int size,
+		int mipCount,
+		PixelFormat format,
+		IntPtr[] levelData,
+		string key
+	) {
+		checkInitialized();
+		return WriteKTX2Cubemap(path, size, mipCount, (int)format, levelData, key) != 0;
+	}
+
+	/** KTX2ファイルのキューブマップの情報を取得する。keyがnullでない場合は一致するか確認する */
+	public static bool getKTX2CubemapInfo(
+		string path,
+		string key,
+		out int size,
+		out int mipCount,
+		out PixelFormat format
+	) {
+		checkInitialized();
+		int fmt;
+		var ret = GetKTX2CubemapInfo(path, key, out size, out mipCount, out fmt) != 0;
+		format = (PixelFormat)fmt;
+		return ret;
+	}
+
+	/**
+	 * KTX2ファイルをマップしてキューブマップへ直接転送する。keyがnullでない場合は一致するか確認する。
+	 * 呼び出したスレッドでグラフィックスAPIを使用するので、実行中のゲームでは
+	 * RenderEventId.LoadKTX2Levels のイベントでレンダースレッドから転送すること
+	 */
+	public static bool loadKTX2Cubemap(
+		string path,
+		string key,
+		IntPtr cubemapTex
+	) {
+		checkInitialized();
+		return LoadKTX2Cubemap(path, key, cubemapTex) != 0;
+	}
+
+	/**
+	 * KTX2ファイルの firstLevel から levelCount 段を、キューブマップの dstFirstLevel 以降へ転送する。
+	 * levelCountが負の場合は最後の段まで
+	 */
+	public static bool loadKTX2CubemapLevels(
+		string path,
+		string key,
+		IntPtr cubemapTex,
+		int firstLevel,
+		int levelCount,
+		int dstFirstLevel
+	) {
+		checkInitialized();
+		return LoadKTX2CubemapLevels(path, key, cubemapTex, firstLevel, levelCount, dstFirstLevel) != 0;
+	}
+
+	/**
+	 * 変更不可なストレージを持つキューブマップをプラグインで作成する。
+	 * 戻り値は Cubemap.CreateExternalTexture に渡せるネイティブテクスチャ。未対応・失敗時はIntPtr.Zero
+	 */
+	public static IntPtr createCubemap(int size, int mipCount, PixelFormat format) {
+		checkInitialized();
+		return CreateCubemap(size, mipCount, (int)format);
+	}
+
+	/** createCubemap で作成したキューブマップを破棄する */
+	public static bool destroyCubemap(IntPtr cubemapTex) {
+		checkInitialized();
+		return DestroyCubemap(cubemapTex) != 0;
+	}
+
+	/**
+	 * キューブマップの各面を2Dテクスチャとして参照するビューを作成する。
+	 * 元のキューブマップは変更不可なストレージを持つこと。outFaceTexsには面の順に6つ入る
+	 */
+	public static bool createCubemapFaceViews(IntPtr cubemapTex, IntPtr[] outFaceTexs) {
+		checkInitialized();
+		if (outFaceTexs == null || outFaceTexs.Length < 6) throw new ArgumentException("outFaceTexs");
+		return CreateCubemapFaceViews(cubemapTex, outFaceTexs) != 0;
+	}
+
+	/** createCubemapFaceViews で作成したビューを破棄する */
+	public static bool destroyTextureView(IntPtr viewTex) {
+		checkInitialized();
+		return DestroyTextureView(viewTex) != 0;
+	}
+
+	/** CommandBuffer.IssuePluginEventAndData に渡す、レンダースレッドで処理を行う関数 */
+	public static IntPtr getRenderEventAndDataFunc() {
+		checkInitialized();
+		return GetRenderEventAndDataFunc();
+	}
+
+	/** getRenderEventAndDataFunc で処理を行う際のイベントID。Native側の RenderEventId と同じ値 */
+	public enum RenderEventId {
+		CreateCubemap = 1,		//!< dataは作成要求(ExternalCubemap.RequestData)へのポインタ
+		DestroyCubemap,			//!< dataは破棄するネイティブテクスチャ
+		DestroyTextureView,		//!< dataは破棄するビューのネイティブテクスチャ
+		LoadKTX2Levels,			//!< dataはKTX2ファイルからのミップ転送要求(CubemapDiskCache.LoadRequest)へのポインタ
+		ExecuteCommands,		//!< enqueueBlitTex2Cubemap などで追加したコマンドをすべて実行する。dataは使用しない
+		PollAsync,				//!< ワーカースレッドで完了した処理(LoadKTX2Levels など)とビルドのフェンスを取り込む。dataは使用しない
+		InsertBuildFence,		//!< dataは createBuildFence で確保したID
+	}
+
+	/**
+	 * バックグラウンドで完了した処理やフェンスを、レンダースレッドで取り込ませる。
+	 * プラグインを使用しないモードからも毎フレーム呼ばれるので、プラグインが存在しないプラットフォームでは何もしない
+	 */
+	public static void issuePollAsync() {
+		if (!s_isPollAsyncAvailable) return;
+		IntPtr func;
+		try {
+			func = getRenderEventAndDataFunc();
+		} catch (Exception e) when (e is DllNotFoundException || e is EntryPointNotFoundException) {
+			s_isPollAsyncAvailable = false;
+			return;
+		}
+
+		var cmd = new CommandBuffer{ name = "CubemapOnTheFly.PollAsync" };
+		cmd.IssuePluginEventAndData(
+			func, (int)RenderEventId.PollAsync, IntPtr.Zero
+		);
+		Graphics.ExecuteCommandBuffer(cmd);
+		cmd.Release();
+	}
+
+	/**
+	 * ビルドのGPU上での完了判定用のIDを確保する。
+	 * IDを RenderEventId.InsertBuildFence のデータとして発行すると、その時点までのGPUコマンドの後にフェンスが挿入される。
+	 * プラグインが存在しないプラットフォームでは0を返す。その場合の queryBuildComplete は2(判定できない)を返す
+	 */
+	public static uint createBuildFence() {
+		if (!s_isBuildFenceAvailable) return 0;
+		checkInitialized();
+		try {
+			return CreateBuildFence();
+		} catch (Exception e) when (e is DllNotFoundException || e is EntryPointNotFoundException) {
+			s_isBuildFenceAvailable = false;
+			return 0;
+		}
+	}
+
+	/**
+	 * ビルドのGPU上での処理が完了したかを、待たずに返す。
+	 * 1:完了 0:未完了 -1:デバイスの破棄などで判定できなくなった
+	 * 2:フェンスに未対応またはプラグインが無いので判定できない。その場合はフレーム数などから判断すること。
+	 * フェンスの確認は PollAsync のイベントで行われる
+	 */
+	public static int queryBuildComplete(uint id) {
+		if (id == 0) return 2;
+		checkInitialized();
+		return QueryBuildComplete(id);
+	}
+
+	/** createBuildFence で確保したIDを解放する */
+	public static void releaseBuildFence(uint id) {
+		if (id == 0) return;
+		checkInitialized();
+		ReleaseBuildFence(id);
+	}
+
+	/**
+	 * CPU処理用の一時バッファを巻き戻す。フレーム境界で呼ぶこと。
+	 * プラグインが存在しないプラットフォームでは何もしない
+	 */
+	public static void resetFrameArena() {
+		if (!s_isFrameArenaAvailable) return;
+		checkInitialized();
+		try {
+			ResetFrameArena();
+		} catch (Exception e) when (e is DllNotFoundException || e is EntryPointNotFoundException) {
+			s_isFrameArenaAvailable = false;
+		}
+	}
+
+	/** CPU処理用の一時バッファの使用状況を取得する */
+	public static bool getFrameArenaStats(out FrameArenaStats stats) {
+		checkInitialized();
+		return GetFrameArenaStats(out stats) != 0;
+	}
+
+	/**
+	 * プラグインの各処理の計測結果(GPU時間・呼び出し回数・CPU時間など)を取得する。
+	 * プラグインが存在しないプラットフォームではfalseを返す
+	 */
+	public static bool getPluginStats(out PluginStats stats) {
+		stats = new PluginStats{
+			structSize = Marshal.SizeOf<PluginStats>(),
+			gpuTime = new PluginGpuTimeStats[PluginStats.OpCount * PluginStats.SizeBucketCount],
+			calls = new PluginCallStats[PluginStats.CallCount],
+		};
+		if (!s_isPluginStatsAvailable) return false;
+		checkInitialized();
+		try {
+			return GetPluginStats(ref stats) != 0;
+		} catch (Exception e) when (e is DllNotFoundException || e is EntryPointNotFoundException) {
+			s_isPluginStatsAvailable = false;
+			return false;
+		}
+	}
+
+	/**
+	 * プラグインの処理のタイムラインの記録を開始する。
+	 * eventCapacityPerThread はスレッドごとに記録できる処理数で、0以下の場合は既定値。既に記録中の場合はfalse
+	 */
+	public static bool startTrace(int eventCapacityPerThread = 0) {
+		checkInitialized();
+		return StartPluginTrace(eventCapacityPerThread) != 0;
+	}
+
+	/**
+	 * タイムラインの記録を停止し、Chrome の trace_event 形式のJSONファイルへ書き出す。
+	 * Perfetto(ui.perfetto.dev) や chrome://tracing で開ける。pathがnullの場合は書き出さずに捨てる
+	 */
+	public static bool stopTrace(string path) {
+		checkInitialized();
+		return StopPluginTrace(path) != 0;
+	}
+
+	/**
+	 * プラグインの呼び出し(引数・テクスチャの情報・時刻)をバイナリのログへ記録し始める。
+	 * 記録したログは .PluginSource/tools の PluginReplay で再生できる。既に記録中の場合やファイルを作成できない場合はfalse
+	 */
+	public static bool startCapture(string path) {
+		checkInitialized();
+		return StartPluginCapture(path) != 0;
+	}
+
+	/** 呼び出しの記録を停止してファイルを閉じる */
+	public static bool stopCapture() {
+		checkInitialized();
+		return StopPluginCapture() != 0;
+	}
+
+	/** プラグインの各処理の計測結果をすべて0に戻す */
+	public static void resetPluginStats() {
+		if (!s_isPluginStatsAvailable) return;
+		checkInitialized();
+		ResetPluginStats();
+	}
+
+	/**
+	 * CPU処理に使用するワーカースレッド数と、各ワーカーを論理コアへ固定するか否かを設定する。
+	 * workerCountが0以下の場合は 論理コア数 - 1。CPU処理の実行中の場合は何も変更せずにfalseを返す
+	 */
+	public static bool configureThreadPool(int workerCount, bool pinThreads) {
+		checkInitialized();
+		return ConfigureThreadPool(workerCount, pinThreads ? 1 : 0) != 0;
+	}
+
+	/** CPU処理を並列に実行できるスレッド数(ワーカー数 + 呼び出し元スレッド) */
+	public static int getThreadPoolThreadCount() {
+		checkInitialized();
+		return GetThreadPoolThreadCount();
+	}
+
+	/**
+	 * 名前付き共有メモリのリングを作成する。未対応の環境や失敗時は IntPtr.Zero を返す。
+	 * 戻り値は destroySharedFaceRing で破棄すること
+	 */
+	public static IntPtr createSharedFaceRing(string name, int slotCount, int maxFaceSize, PixelFormat format) {
+		checkInitialized();
+		return CreateSharedFaceRing(name, slotCount, maxFaceSize, (int)format);
+	}
+
+	/** createSharedFaceRing で作成したリングを破棄して、共有メモリを削除する */
+	public static bool destroySharedFaceRing(IntPtr ring) {
+		checkInitialized();
+		return DestroySharedFaceRing(ring) != 0;
+	}
+
+	/** ホスト側バッファ上のキューブマップ(6面連続)を、面ごとにリングへ書き込んで公開する */
+	public static bool publishCubemapFacesToSharedRing(
+		IntPtr ring,
+		IntPtr faces,
+		int size,
+		PixelFormat format,
+		ulong frameId
+	) {
+		checkInitialized();
+		return PublishCubemapFacesToSharedRing(ring, faces, size, (int)format, frameId) != 0;
+	}
+
 
 	// --------------------------------- private / protected メンバ -------------------------------
 
+	static bool s_isEnqueueBlitAvailable = true;
+	static bool s_isFrameArenaAvailable = true;
+	static bool s_isBuildFenceAvailable = true;
+	static bool s_isPollAsyncAvailable = true;
+	static bool s_isPluginStatsAvailable = true;
+
 	// プラグインの生関数定義
 #if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
 	[DllImport("__Internal")]
@@ -56,6 +535,351 @@ static class CubemapBuilderPlugin {
 		int texWidth
 	);
 
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int EnqueueBlitCubemap(
+		IntPtr srcTex0,
+		IntPtr srcTex1,
+		IntPtr srcTex2,
+		IntPtr srcTex3,
+		IntPtr srcTex4,
+		IntPtr srcTex5,
+		IntPtr cubemapTex,
+		int texWidth
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ConvertCubemapToProjection(
+		IntPtr cubemapTex, IntPtr dstTex, int dstWidth, int dstHeight, int projection
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ConvertProjectionToCubemap(
+		IntPtr srcTex, IntPtr cubemapTex, int cubemapSize, int projection
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ConvertCubemapToProjectionCPU(
+		IntPtr srcFaces, int srcSize, IntPtr dst, int dstWidth, int dstHeight, int projection
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ConvertProjectionToCubemapCPU(
+		IntPtr src, int srcWidth, int srcHeight, IntPtr dstFaces, int dstSize, int projection
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int RotateCubemap(
+		IntPtr srcCubemapTex, IntPtr dstCubemapTex, int size, float[] rotation
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int RotateCubemapCPU(
+		IntPtr srcFaces, IntPtr dstFaces, int size, float[] rotation
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int FixupCubemapSeams(
+		IntPtr cubemapTex, int size, int mipCount
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int FixupCubemapSeamsCPU(
+		IntPtr faces, int size
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int BlurCubemap(
+		IntPtr srcCubemapTex, IntPtr dstCubemapTex, int size, float sigma
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int BlurCubemapCPU(
+		IntPtr srcFaces, IntPtr dstFaces, int size, float sigma
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ComputeCubemapLuminanceStats(
+		IntPtr cubemapTex, int size, float minLog2Lum, float maxLog2Lum
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int GetCubemapLuminanceStats(
+		out LuminanceStats stats
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ComputeCubemapLuminanceStatsCPU(
+		IntPtr faces, int size, int isSRGB, float minLog2Lum, float maxLog2Lum, out LuminanceStats stats
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int WriteKTX2Cubemap(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string path,
+		int size, int mipCount, int format, IntPtr[] levelData,
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string key
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int GetKTX2CubemapInfo(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string path,
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+		out int size, out int mipCount, out int format
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int LoadKTX2Cubemap(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string path,
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+		IntPtr cubemapTex
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int LoadKTX2CubemapLevels(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string path,
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+		IntPtr cubemapTex,
+		int firstLevel, int levelCount, int dstFirstLevel
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern void ResetFrameArena();
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern IntPtr CreateCubemap(int size, int mipCount, int format);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int DestroyCubemap(IntPtr cubemapTex);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern IntPtr GetRenderEventAndDataFunc();
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern uint CreateBuildFence();
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int QueryBuildComplete(uint id);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern void ReleaseBuildFence(uint id);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int CreateCubemapFaceViews(
+		IntPtr cubemapTex,
+		[Out] IntPtr[] outFaceTexs
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int DestroyTextureView(IntPtr viewTex);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int GetFrameArenaStats(
+		out FrameArenaStats stats
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int GetPluginStats(
+		ref PluginStats stats
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern void ResetPluginStats();
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int StartPluginTrace(int eventCapacityPerThread);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int StopPluginTrace(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string path
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int StartPluginCapture(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string path
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int StopPluginCapture();
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int ConfigureThreadPool(
+		int workerCount, int pinThreads
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int GetThreadPoolThreadCount();
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern IntPtr CreateSharedFaceRing(
+		[MarshalAs(UnmanagedType.LPUTF8Str)] string name,
+		int slotCount, int maxFaceSize, int format
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int DestroySharedFaceRing(
+		IntPtr ring
+	);
+
+#if (UNITY_IOS || UNITY_TVOS || UNITY_WEBGL) && !UNITY_EDITOR
+	[DllImport("__Internal")]
+#else
+	[DllImport("CubemapBuilderPlugin")]
+#endif
+	static extern int PublishCubemapFacesToSharedRing(
+		IntPtr ring, IntPtr faces, int size, int format, ulong frameId
+	);
+
 
 	// 初期化チェック。WebGLの場合は初期化が必要なので、これを呼ぶ必要がある
 #if UNITY_WEBGL && !UNITY_EDITOR
@@ -0,0 +1,64 @@
+using System;
+using UnityEngine;
+using UnityEngine.Experimental.Rendering;
+
+
+namespace CubemapOnTheFly.Plugin {
+
+/**
+ * Native側で扱うテクスチャのピクセル形式。Native側の PixelFormat と同じ値
+ */
+enum PixelFormat {
+	Unsupported = -1,
+
+	RGBA8 = 0,		//!< RGBA 各8bit UNORM
+	RGBA8_SRGB,		//!< RGBA 各8bit UNORM、RGBはsRGB
+	RGBAHalf,		//!< RGBA 各16bit float
+}
+
+/**
+ * PixelFormat とUnity側の形式の相互変換
+ */
+static class PixelFormatUtil {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** GraphicsFormatから変換する。対応していない形式の場合は Unsupported を返す */
+	public static PixelFormat fromGraphicsFormat(GraphicsFormat format) {
+		switch (format) {
+		case GraphicsFormat.R8G8B8A8_UNorm : return PixelFormat.RGBA8;
+		case GraphicsFormat.R8G8B8A8_SRGB : return PixelFormat.RGBA8_SRGB;
+		case GraphicsFormat.R16G16B16A16_SFloat : return PixelFormat.RGBAHalf;
+		default : return PixelFormat.Unsupported;
+		}
+	}
+
+	/** GraphicsFormatへ変換する */
+	public static GraphicsFormat toGraphicsFormat(this PixelFormat format) {
+		switch (format) {
+		case PixelFormat.RGBA8 : return GraphicsFormat.R8G8B8A8_UNorm;
+		case PixelFormat.RGBA8_SRGB : return GraphicsFormat.R8G8B8A8_SRGB;
+		case PixelFormat.RGBAHalf : return GraphicsFormat.R16G16B16A16_SFloat;
+		default : throw new ArgumentException("format:" + format);
+		}
+	}
+
+	/** ピクセルデータを読み戻す際の、メモリ上の並びが一致するTextureFormatへ変換する */
+	public static TextureFormat toTextureFormat(this PixelFormat format) {
+		switch (format) {
+		case PixelFormat.RGBA8 :
+		case PixelFormat.RGBA8_SRGB : return TextureFormat.RGBA32;
+		case PixelFormat.RGBAHalf : return TextureFormat.RGBAHalf;
+		default : throw new ArgumentException("format:" + format);
+		}
+	}
+
+	/** 1ピクセルあたりのバイト数 */
+	public static int bytesPerPixel(this PixelFormat format) {
+		return format == PixelFormat.RGBAHalf ? 8 : 4;
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
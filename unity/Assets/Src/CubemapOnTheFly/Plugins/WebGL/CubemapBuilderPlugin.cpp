@@ -2,3 +2,19 @@
 #include "../.PluginSource/source/CubemapBuilderPlugin.cpp"
 #include "../.PluginSource/source/RenderAPI.cpp"
 #include "../.PluginSource/source/RenderAPI_OpenGLCoreES.cpp"
+#include "../.PluginSource/source/CubemapImage.cpp"
+#include "../.PluginSource/source/ProjectionConverter.cpp"
+#include "../.PluginSource/source/OpenGLCommon.cpp"
+#include "../.PluginSource/source/CubemapRotator.cpp"
+#include "../.PluginSource/source/SeamFixup.cpp"
+#include "../.PluginSource/source/Parallel.cpp"
+#include "../.PluginSource/source/CubemapBlur.cpp"
+#include "../.PluginSource/source/LuminanceStats.cpp"
+#include "../.PluginSource/source/FileIO.cpp"
+#include "../.PluginSource/source/KTX2.cpp"
+#include "../.PluginSource/source/FrameArena.cpp"
+#include "../.PluginSource/source/SharedFaceRing.cpp"
+#include "../.PluginSource/source/PluginStats.cpp"
+#include "../.PluginSource/source/Tracer.cpp"
+#include "../.PluginSource/source/ProfilerMarkers.cpp"
+#include "../.PluginSource/source/PluginCapture.cpp"
@@ -21,17 +21,21 @@ sealed class BuilderPlan : IDisposable {
 		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onBeginRender,
 		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onEndRender,
 		Shader blitShader,
-		RenderingMode renderingMode
+		RenderingMode renderingMode,
+		Texture destination = null,
+		int destinationSlice = 0,
+		CubemapDiskCache diskCache = null,
+		CubemapDiskCache.Key cacheKey = default
 	) {
 		switch (renderingMode) {
 		case RenderingMode.BlitNoUsePlugin :
-			_renderer = new Builder_BlitNoUsePlugin(camera, texSize, pos);
+			_renderer = new Builder_BlitNoUsePlugin(camera, texSize, pos, destination, destinationSlice);
 			break;
 		case RenderingMode.BlitUsePlugin :
-			_renderer = new Builder_BlitUsePlugin(camera, texSize, pos);
+			_renderer = new Builder_BlitUsePlugin(camera, texSize, pos, destination, destinationSlice);
 			break;
 		case RenderingMode.DirectRT :
-			_renderer = new Builder_DirectRT(camera, texSize, pos, blitShader);
+			_renderer = new Builder_DirectRT(camera, texSize, pos, blitShader, destination, destinationSlice);
 			break;
 		default : throw new ArgumentException();
 		}
@@ -39,12 +43,24 @@ sealed class BuilderPlan : IDisposable {
 		_onComplete = onComplete;
 		_onBeginRender = onBeginRender;
 		_onEndRender = onEndRender;
+		_diskCache = diskCache;
+		_cacheKey = cacheKey;
+		_destination = destination;
+		TexSize = texSize;
+		RenderingMode = renderingMode;
 	}
 
+	public int TexSize {get;}
+	public RenderingMode RenderingMode {get;}
+
+	/** レンダリングを発行し終えて、GPU上での完了待ちの状態か否か */
+	public bool IsWaitingGPU => _renderer == null && _result != null;
+
 	/**
 	 * 処理を進める。
 	 * 呼び出し時に残りレンダリング可能数を指定して、使用結果の値で更新する。
-	 * 処理が全完了した場合はtrueを返す。
+	 * レンダリングをすべて発行し終えた場合はtrueを返す。
+	 * この時点ではまだGPU上で処理中の可能性があるので、以降は pollGPUComplete で完了を確認すること
 	 */
 	public bool proceed(
 		Camera camera,
@@ -62,19 +78,65 @@ sealed class BuilderPlan : IDisposable {
 
 		// レンダリング処理全完了チェック
 		if (_renderer.IsComplete) {
-			_onComplete?.Invoke(_renderer.Result);
-			_onComplete = null;
+			_result = _renderer.Result;
 
+			// 作業用のRTはここで返してしまってよい。次に使う処理はGPU上でこれより後に実行される
 			_renderer.Dispose();
 			_renderer = null;
 
+			// ここまでに発行したGPUコマンドの後にフェンスを挿入しておき、コールバックはその完了後に呼ぶ
+			_issuedFrame = Time.frameCount;
+			_fenceId = Plugin.CubemapBuilderPlugin.createBuildFence();
+			if (_fenceId != 0) {
+				var cmd = new UnityEngine.Rendering.CommandBuffer{ name = "CubemapOnTheFly.BuildFence" };
+				cmd.IssuePluginEventAndData(
+					Plugin.CubemapBuilderPlugin.getRenderEventAndDataFunc(),
+					(int)Plugin.CubemapBuilderPlugin.RenderEventId.InsertBuildFence,
+					new IntPtr(_fenceId)
+				);
+				Graphics.ExecuteCommandBuffer(cmd);
+				cmd.Release();
+			}
+
 			return true;
 		}
 
 		return false;
 	}
 
+	/**
+	 * GPU上での処理の完了を、待たずに確認する。
+	 * 完了していればディスクキャッシュへの保存と完了コールバックの呼び出しを行い、trueを返す。
+	 * フェンスはPollAsyncのイベントで更新されるので、完了待ちの間は毎フレームそれも発行すること
+	 */
+	public bool pollGPUComplete() {
+		if (!IsWaitingGPU) return false;
+
+		// デバイスの破棄などで判定できなくなった場合(-1)も、それ以上待たずに完了とする。
+		// フェンスで判定できない場合(2)は、GPUがCPUから遅れうる最大のフレーム数が経過するまで待つ
+		var state = Plugin.CubemapBuilderPlugin.queryBuildComplete(_fenceId);
+		if (state == 0) return false;
+		if (state == 2 && Time.frameCount - _issuedFrame < UnfencedLatencyFrames) return false;
+		releaseFence();
+
+		// ディスクキャッシュが指定されている場合は、完了時の内容を保存しておく
+		_diskCache?.store(_cacheKey, _result);
+
+		var result = _result;
+		_result = null;
+		_onComplete?.Invoke(result);
+		_onComplete = null;
+
+		return true;
+	}
+
 	public void Dispose() {
+		// GPU上での完了待ちの間にキャンセルされた場合は、生成した結果を自前で片付ける
+		releaseFence();
+		if (_result != null && _result != _destination)
+			RenderTexturePool.giveBackOrDestroy(_result);
+		_result = null;
+
 		_onComplete?.Invoke(null); _onComplete = null;
 		_renderer?.Dispose(); _renderer = null;
 	}
@@ -86,10 +148,29 @@ sealed class BuilderPlan : IDisposable {
 	readonly Action<Camera, UnityEngine.Rendering.ScriptableRenderContext>
 		_onBeginRender, _onEndRender;
 	Action<Texture> _onComplete;
+	readonly CubemapDiskCache _diskCache;
+	readonly CubemapDiskCache.Key _cacheKey;
+	readonly Texture _destination;
+
+	/** レンダリングを発行し終えた結果。GPU上での完了待ちの間だけ保持する */
+	Texture _result;
+
+	/** GPU上での完了判定用のフェンスのID。プラグインが無い場合は0 */
+	uint _fenceId;
+	/** レンダリングを発行し終えたフレーム */
+	int _issuedFrame;
+
+	/** フェンスが使えない場合に、GPU上で完了したとみなすまでに待つフレーム数 */
+	static int UnfencedLatencyFrames => Math.Max(2, QualitySettings.maxQueuedFrames) + 1;
+
+	void releaseFence() {
+		Plugin.CubemapBuilderPlugin.releaseBuildFence(_fenceId);
+		_fenceId = 0;
+	}
 
 
 	~BuilderPlan() {
-		if (_renderer != null) throw new InvalidProgramException();
+		if (_renderer != null || _result != null) throw new InvalidProgramException();
 	}
 
 
@@ -20,15 +20,25 @@ abstract class Builder_Base : IDisposable {
 	/** 作成が完了したか否か */
 	public bool IsComplete {get; private set;}
 
-	/** 作成結果のキューブマップ。これは不要になったら使用する側で開放すること */
+	/**
+	 * 作成結果のキューブマップ。これは不要になったら使用する側で開放すること。
+	 * 出力先が指定されている場合は、出力先のテクスチャそのもの
+	 */
 	public Texture Result {get; private set;}
 
 
-	/** 使用するカメラ、パラメータを指定してレンダリングを開始する準備をする */
-	public Builder_Base(Camera camera, int texSize, float3 pos) {
+	/**
+	 * 使用するカメラ、パラメータを指定してレンダリングを開始する準備をする。
+	 * dstを指定した場合は、新規に確保せずにそこへ書き込む。
+	 * dstはキューブマップ・キューブのRT・キューブマップ配列のいずれかで、
+	 * キューブマップ配列の場合はdstSliceで書き込むキューブマップを指定する
+	 */
+	public Builder_Base(Camera camera, int texSize, float3 pos, Texture dst, int dstSlice) {
 		_camera = camera;
 		_texSize = texSize;
 		_pos = pos;
+		_dst = dst;
+		_dstSlice = dstSlice;
 
 		_camera.enabled = false;
 		_camera.fieldOfView = 90;
@@ -82,6 +92,17 @@ abstract class Builder_Base : IDisposable {
 	protected int _texSize;
 	float3 _pos;
 
+	/** 出力先として指定されたテクスチャ。nullの場合は新規に確保する */
+	protected readonly Texture _dst;
+	/** 出力先がキューブマップ配列の場合の、書き込むキューブマップのインデックス */
+	protected readonly int _dstSlice;
+
+	/** 出力先の、指定の面に対応する要素番号。Graphics.CopyTextureなどで使用する */
+	protected int dstElement(CubemapFace face) {
+		var baseIdx = _dst.dimension == UnityEngine.Rendering.TextureDimension.CubeArray ? _dstSlice * 6 : 0;
+		return baseIdx + (int)face;
+	}
+
 
 	/** 指定の方向の面をレンダリングする処理 */
 	abstract protected void renderFace(
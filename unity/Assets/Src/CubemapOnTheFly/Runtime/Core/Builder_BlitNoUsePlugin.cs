@@ -18,8 +18,8 @@ sealed class Builder_BlitNoUsePlugin : Builder_Base {
 	// ------------------------------------- public メンバ ----------------------------------------
 
 	/** 使用するカメラ、パラメータを指定してレンダリングを開始する準備をする */
-	public Builder_BlitNoUsePlugin(Camera camera, int texSize, float3 pos)
-		: base(camera, texSize, pos) {}
+	public Builder_BlitNoUsePlugin(Camera camera, int texSize, float3 pos, Texture dst, int dstSlice)
+		: base(camera, texSize, pos, dst, dstSlice) {}
 
 
 	// --------------------------------- private / protected メンバ -------------------------------
@@ -39,7 +39,7 @@ sealed class Builder_BlitNoUsePlugin : Builder_Base {
 		// レンダリング先のRTを確保
 		var desc = new RenderTextureDescriptor(_texSize, _texSize, RenderTextureFormat.ARGB32);
 		desc.sRGB = false;
-		var rt = RenderTexture.GetTemporary(desc);
+		var rt = RenderTexturePool.rent(desc);
 
 		// RTにレンダリング
 		renderFace(rt, context, faceIndex);
@@ -57,15 +57,38 @@ sealed class Builder_BlitNoUsePlugin : Builder_Base {
 		_pixels[(int)faceIndex] = pd;
 
 
-		RenderTexture.ReleaseTemporary(rt);
+		RenderTexturePool.giveBack(rt);
 	}
 
 	/** 各面をレンダリングした結果からキューブマップを生成する */
 	override protected Texture compileCubemap(UnityEngine.Rendering.ScriptableRenderContext context) {
-		var ret = new Cubemap(_texSize, TextureFormat.ARGB32, 1);
-		for (int i=0; i<6; ++i)
-			_pixels[i].writeToCubemap( ret, (CubemapFace)i );
-		ret.Apply(false, true);
+		Texture ret;
+		if (_dst is Cubemap dstCubemap) {
+			// 出力先のキューブマップへ直接書き込む。次回も書き込めるように、読み込み可能なままにしておく
+			for (int i=0; i<6; ++i)
+				_pixels[i].writeToCubemap( dstCubemap, (CubemapFace)i );
+			dstCubemap.Apply(false, false);
+			ret = dstCubemap;
+		} else if (_dst is CubemapArray dstArray) {
+			for (int i=0; i<6; ++i)
+				_pixels[i].writeToCubemapArray( dstArray, (CubemapFace)i, _dstSlice );
+			dstArray.Apply(false, false);
+			ret = dstArray;
+		} else {
+			var cubemap = new Cubemap(_texSize, TextureFormat.ARGB32, 1);
+			for (int i=0; i<6; ++i)
+				_pixels[i].writeToCubemap( cubemap, (CubemapFace)i );
+			cubemap.Apply(false, _dst == null);
+			ret = cubemap;
+
+			// RTの出力先へはGPU上でコピーする。この場合のみ一時的なキューブマップを確保する
+			if (_dst != null) {
+				for (int i=0; i<6; ++i)
+					Graphics.CopyTexture( cubemap, i, 0, _dst, dstElement((CubemapFace)i), 0 );
+				UnityEngine.Object.DestroyImmediate(cubemap);
+				ret = _dst;
+			}
+		}
 
 		foreach (var i in _pixels) i.Dispose();
 		UnityEngine.Object.DestroyImmediate(_tmpTex2D);
@@ -1,5 +1,6 @@
 using System;
 using UnityEngine;
+using UnityEngine.Rendering;
 
 using Unity.Mathematics;
 using static Unity.Mathematics.math;
@@ -18,8 +19,8 @@ sealed class Builder_BlitUsePlugin : Builder_Base {
 	// ------------------------------------- public メンバ ----------------------------------------
 
 	/** 使用するカメラ、パラメータを指定してレンダリングを開始する準備をする */
-	public Builder_BlitUsePlugin(Camera camera, int texSize, float3 pos)
-		: base(camera, texSize, pos) {}
+	public Builder_BlitUsePlugin(Camera camera, int texSize, float3 pos, Texture dst, int dstSlice)
+		: base(camera, texSize, pos, dst, dstSlice) {}
 
 
 	// --------------------------------- private / protected メンバ -------------------------------
@@ -34,12 +35,12 @@ sealed class Builder_BlitUsePlugin : Builder_Base {
 		if (_rt[ (int)faceIndex ] != null)
 			throw new InvalidProgramException();
 
-		// レンダリング先のRTを確保
+		// レンダリング先のRTをプールから確保
 		var desc = new RenderTextureDescriptor(
 			_texSize, _texSize, RenderTextureFormat.ARGB32, 16
 		);
 //		desc.sRGB = false;
-		var rt = new RenderTexture(desc);
+		var rt = RenderTexturePool.rent(desc);
 		_rt[ (int)faceIndex ] = rt;
 
 		// RTにレンダリング
@@ -48,19 +49,47 @@ sealed class Builder_BlitUsePlugin : Builder_Base {
 
 	/** 各面をレンダリングした結果からキューブマップを生成する */
 	override protected Texture compileCubemap(UnityEngine.Rendering.ScriptableRenderContext context) {
-		var ret = new Cubemap(_texSize, TextureFormat.ARGB32, 1);
-
-		// プラグインでキューブマップへBlitする
-		Plugin.CubemapBuilderPlugin.blitTex2Cubemap(
-			_rt[0].GetNativeTexturePtr(),
-			_rt[1].GetNativeTexturePtr(),
-			_rt[2].GetNativeTexturePtr(),
-			_rt[3].GetNativeTexturePtr(),
-			_rt[4].GetNativeTexturePtr(),
-			_rt[5].GetNativeTexturePtr(),
-			ret.GetNativeTexturePtr(),
-			_texSize
-		);
+		// プラグインで書き込めない出力先(キューブのRT・キューブマップ配列)の場合は、各面をコピーする
+		if (_dst != null && !(_dst is Cubemap)) {
+			for (int i=0; i<6; ++i)
+				Graphics.CopyTexture( _rt[i], 0, 0, _dst, dstElement((CubemapFace)i), 0 );
+			return _dst;
+		}
+
+		var ret = _dst ?? new Cubemap(_texSize, TextureFormat.ARGB32, 1);
+
+		// プラグインでキューブマップへBlitする。
+		// コマンドをキューに積み、レンダースレッド上で実行させる
+		var srcTex0 = _rt[0].GetNativeTexturePtr();
+		var srcTex1 = _rt[1].GetNativeTexturePtr();
+		var srcTex2 = _rt[2].GetNativeTexturePtr();
+		var srcTex3 = _rt[3].GetNativeTexturePtr();
+		var srcTex4 = _rt[4].GetNativeTexturePtr();
+		var srcTex5 = _rt[5].GetNativeTexturePtr();
+		var dstTex = ret.GetNativeTexturePtr();
+		if (Plugin.CubemapBuilderPlugin.enqueueBlitTex2Cubemap(
+			srcTex0, srcTex1, srcTex2, srcTex3, srcTex4, srcTex5, dstTex, _texSize
+		)) {
+			var cmd = new CommandBuffer{ name = "CubemapOnTheFly.Builder_BlitUsePlugin" };
+			cmd.IssuePluginEventAndData(
+				Plugin.CubemapBuilderPlugin.getRenderEventAndDataFunc(),
+				(int)Plugin.CubemapBuilderPlugin.RenderEventId.ExecuteCommands,
+				IntPtr.Zero
+			);
+			Graphics.ExecuteCommandBuffer(cmd);
+			cmd.Release();
+		} else if (!Plugin.CubemapBuilderPlugin.isEnqueueBlitAvailable) {
+			// コマンドのキューが無い古いプラグインの場合は、従来通りその場でBlitする。
+			// キューが無いので、積まれているコマンドを追い越すことはない
+			Plugin.CubemapBuilderPlugin.blitTex2Cubemap(
+				srcTex0, srcTex1, srcTex2, srcTex3, srcTex4, srcTex5, dstTex, _texSize
+			);
+		} else {
+			// キューが満杯の場合、その場でBlitすると積まれているコマンドや面のレンダリングより先に実行されてしまう。
+			// 発行順に実行されるように、Unityのコピーとして発行する
+			for (int i=0; i<6; ++i)
+				Graphics.CopyTexture( _rt[i], 0, 0, ret, i, 0 );
+		}
 
 		return ret;
 	}
@@ -69,7 +98,7 @@ sealed class Builder_BlitUsePlugin : Builder_Base {
 	override protected void disposeCore() {
 
 		if (_rt != null)
-			foreach (var i in _rt) i?.Release();
+			foreach (var i in _rt) RenderTexturePool.giveBack(i);
 		_rt = null;
 	}
 
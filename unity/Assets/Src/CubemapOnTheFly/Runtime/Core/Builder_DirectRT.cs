@@ -17,8 +17,10 @@ sealed class Builder_DirectRT : Builder_Base {
 	// ------------------------------------- public メンバ ----------------------------------------
 
 	/** 使用するカメラ、パラメータを指定してレンダリングを開始する準備をする */
-	public Builder_DirectRT(Camera camera, int texSize, float3 pos, Shader blitShader)
-		: base(camera, texSize, pos)
+	public Builder_DirectRT(
+		Camera camera, int texSize, float3 pos, Shader blitShader,
+		Texture dst, int dstSlice
+	) : base(camera, texSize, pos, dst, dstSlice)
 	{
 		if (s_blitMtl == null)
 			s_blitMtl = new Material(blitShader);
@@ -29,15 +31,24 @@ sealed class Builder_DirectRT : Builder_Base {
 
 	static Material s_blitMtl;
 	RenderTexture _cubemapRT;
+	bool _isCubemapRTPooled;		//!< _cubemapRTがプールから借りたものか否か
 
 	/** 指定の方向の面をレンダリングする処理 */
 	override protected void renderFace(
 		UnityEngine.Rendering.ScriptableRenderContext context,
 		CubemapFace faceIndex
 	) {
-		// キューブマップ本体のRTを確保
+		// キューブマップ本体のRTを確保。
+		// 出力先にキューブのRTが指定されている場合はそれに直接描画し、それ以外の場合はプールから借りる
+		var dstRT = _dst as RenderTexture;
+		if (_cubemapRT == null && dstRT != null && dstRT.dimension == UnityEngine.Rendering.TextureDimension.Cube) {
+			if (!dstRT.IsCreated()) dstRT.Create();
+			_cubemapRT = dstRT;
+			_isCubemapRTPooled = false;
+		}
 		if (_cubemapRT == null) {
-			_cubemapRT = new RenderTexture(
+			_isCubemapRTPooled = true;
+			_cubemapRT = RenderTexturePool.rent(
 				new RenderTextureDescriptor(
 					_texSize, _texSize,
 					RenderTextureFormat.ARGB32
@@ -51,7 +62,7 @@ sealed class Builder_DirectRT : Builder_Base {
 		var desc = new RenderTextureDescriptor(
 			_texSize, _texSize, RenderTextureFormat.ARGB32, 16
 		);
-		var rt = RenderTexture.GetTemporary(desc);
+		var rt = RenderTexturePool.rent(desc);
 
 		// RTにレンダリング
 		renderFace(rt, context, faceIndex);
@@ -60,21 +71,28 @@ sealed class Builder_DirectRT : Builder_Base {
 		Graphics.SetRenderTarget( _cubemapRT, 0, faceIndex );
 		Graphics.Blit( rt, s_blitMtl );
 		RenderTexture.active = null;
-		RenderTexture.ReleaseTemporary( rt );
+		RenderTexturePool.giveBack( rt );
 	}
 
 	/** 各面をレンダリングした結果からキューブマップを生成する */
 	override protected Texture compileCubemap(UnityEngine.Rendering.ScriptableRenderContext context) {
-		// キューブマップを直接RTとしてレンダリングしているので、ここは返すだけでいい
+		// キューブマップを直接RTとしてレンダリングしているので、ここは返すだけでいい。
+		// 返したRTはプールから借りたままになるので、不要になったら Manager.recycle で返してもらう
 		var ret = _cubemapRT;
 		_cubemapRT = null;
-		return ret;
+		if (_dst == null || ret == _dst) return ret;
+
+		// 直接描画できない出力先の場合は、各面をコピーする
+		for (int i=0; i<6; ++i)
+			Graphics.CopyTexture( ret, i, 0, _dst, dstElement((CubemapFace)i), 0 );
+		RenderTexturePool.giveBack(ret);
+		return _dst;
 	}
 
 	/** 破棄処理本体 */
 	override protected void disposeCore() {
 
-		if (_cubemapRT != null) _cubemapRT.Release();
+		if (_cubemapRT != null && _isCubemapRTPooled) RenderTexturePool.giveBack(_cubemapRT);
 		_cubemapRT = null;
 	}
 
@@ -0,0 +1,135 @@
+using System;
+using UnityEngine;
+
+using Unity.Mathematics;
+using static Unity.Mathematics.math;
+using System.Collections.Generic;
+
+
+namespace CubemapOnTheFly.Core {
+
+/**
+ * 生成済みキューブマップの空間インデックス。
+ * 位置を一様グリッドでハッシュして、指定距離以内の近傍を周囲3x3x3セルの探索だけで見つける。
+ *
+ * キューブマップは所有しない。破棄されたものや古くなったものは、探索・追加時についでに取り除く。
+ */
+sealed class CaptureIndex {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** セルの一辺の長さを指定して初期化する。探索距離以上にすること */
+	public CaptureIndex(float cellSize) {
+		_cellSize = max(cellSize, 1e-4f);
+	}
+
+	/** セルの一辺の長さ */
+	public float CellSize => _cellSize;
+
+	/** 格納している数 */
+	public int Count {get; private set;}
+
+	/**
+	 * 条件に合う中で最も近いものを探す。
+	 * maxDistance はセルの一辺以下であること。maxAge が0以下の場合は経過時間を問わない
+	 */
+	public bool tryFind(
+		float3 pos, int texSize, int layerMask,
+		float maxDistance, float maxAge, float now,
+		out Texture result
+	) {
+		result = null;
+		var bestDistSq = maxDistance * maxDistance;
+		var c = toCell(pos);
+
+		for (int z=-1; z<=1; ++z)
+		for (int y=-1; y<=1; ++y)
+		for (int x=-1; x<=1; ++x) {
+			if (!_cells.TryGetValue(c + int3(x,y,z), out var list)) continue;
+			purge(list, maxAge, now);
+			foreach (var i in list) {
+				if (i.texSize != texSize || i.layerMask != layerMask) continue;
+				var distSq = distancesq(i.pos, pos);
+				if (bestDistSq < distSq) continue;
+				bestDistSq = distSq;
+				result = i.texture;
+			}
+		}
+
+		return result != null;
+	}
+
+	/** 生成済みキューブマップを登録する */
+	public void add(float3 pos, int texSize, int layerMask, float now, Texture texture, float maxAge) {
+		var c = toCell(pos);
+		if (!_cells.TryGetValue(c, out var list)) {
+			list = new List<Item>();
+			_cells.Add(c, list);
+		}
+		purge(list, maxAge, now);
+		list.Add( new Item{ pos = pos, texSize = texSize, layerMask = layerMask, time = now, texture = texture } );
+		++Count;
+	}
+
+	/**
+	 * 指定のキューブマップを取り除く。プールへ返すなどして内容が変わるものを、再利用されないようにするために使用する。
+	 * 頻繁には呼ばれないので、全セルを走査する
+	 */
+	public bool remove(Texture texture) {
+		if (texture is null) return false;
+		int removeCnt = 0;
+		foreach (var list in _cells.Values)
+			removeCnt += list.RemoveAll( i => ReferenceEquals(i.texture, texture) );
+		Count -= removeCnt;
+		return 0 < removeCnt;
+	}
+
+	/** セルの一辺の長さを変更して、格納しているものを再配置する */
+	public void rebuild(float cellSize) {
+		var items = new List<Item>();
+		foreach (var i in _cells.Values) items.AddRange(i);
+
+		_cellSize = max(cellSize, 1e-4f);
+		_cells.Clear();
+		foreach (var i in items) {
+			var c = toCell(i.pos);
+			if (!_cells.TryGetValue(c, out var list)) {
+				list = new List<Item>();
+				_cells.Add(c, list);
+			}
+			list.Add(i);
+		}
+	}
+
+	/** すべて取り除く */
+	public void clear() {
+		_cells.Clear();
+		Count = 0;
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	/** 登録した生成済みキューブマップ1つ分の情報 */
+	struct Item {
+		public float3 pos;
+		public int texSize;
+		public int layerMask;
+		public float time;			//!< 登録時刻
+		public Texture texture;
+	}
+
+	float _cellSize;
+	Dictionary<int3, List<Item>> _cells = new Dictionary<int3, List<Item>>();
+
+	int3 toCell(float3 pos) => (int3)floor(pos / _cellSize);
+
+	/** 破棄されたものと、経過時間を超えたものを取り除く */
+	void purge(List<Item> list, float maxAge, float now) {
+		Count -= list.RemoveAll( i => i.texture == null || (0 < maxAge && maxAge < now - i.time) );
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -107,6 +107,16 @@ sealed class PixelDataCache : IDisposable {
 		}
 	}
 
+	/** キャッシュされているデータを、指定のキューブマップ配列の指定要素に適応する */
+	public void writeToCubemapArray(CubemapArray cubemapArray, CubemapFace face, int element) {
+
+		if (_useRawTexData) {
+			cubemapArray.SetPixelData( _pixelsRaw, 0, face, element );
+		} else {
+			cubemapArray.SetPixels( _pixelsMng, face, element, 0 );
+		}
+	}
+
 	public void Dispose() {
 		if (_isDisposed) return;
 		_isDisposed = true;
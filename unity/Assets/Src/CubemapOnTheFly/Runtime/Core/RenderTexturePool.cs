@@ -0,0 +1,205 @@
+using System;
+using UnityEngine;
+using UnityEngine.Experimental.Rendering;
+
+using System.Collections.Generic;
+
+
+namespace CubemapOnTheFly.Core {
+
+/**
+ * 各Builderで共有するRenderTextureのプール。
+ * サイズ・形式などが同じものを使いまわして、ビルドごとの確保・解放をなくす。
+ *
+ * 使われずに一定フレーム経過したものと、同じ種類で一定数を超えて余っているものは trim で解放する。
+ */
+static class RenderTexturePool {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** 使われずにこのフレーム数が経過したものは解放する */
+	public static int maxIdleFrames = 300;
+	/** 同じ種類で使われていないものをこの数までは保持する */
+	public static int maxIdleCountPerKey = 8;
+
+	/** これまでに新規確保した数 */
+	public static int AllocatedCount {get; private set;}
+	/** 貸し出し中の数 */
+	public static int RentedCount => s_rented.Count;
+	/** 使われずに保持している数 */
+	public static int IdleCount {get; private set;}
+
+	/** 指定の設定のRenderTextureを借りる。使い終わったら giveBack で返すこと */
+	public static RenderTexture rent(in RenderTextureDescriptor desc) {
+		var key = new Key(desc);
+		RenderTexture ret = null;
+		if (s_idle.TryGetValue(key, out var list)) {
+			// 外部で破棄されたものは飛ばす
+			while (ret == null && 0 < list.Count) {
+				ret = list[list.Count - 1].rt;
+				list.RemoveAt(list.Count - 1);
+				--IdleCount;
+			}
+		}
+
+		if (ret == null) {
+			ret = new RenderTexture(desc);
+			++AllocatedCount;
+		}
+		s_rented.Add(ret, key);
+		return ret;
+	}
+
+	/** 借りたRenderTextureを返す。返す前に破棄されていた場合は、貸し出し中の記録だけ消す */
+	public static void giveBack(RenderTexture rt) {
+		if (rt is null) return;
+		if (!s_rented.TryGetValue(rt, out var key)) {
+			if (rt == null) return;
+			throw new ArgumentException("not rented from pool");
+		}
+		s_rented.Remove(rt);
+		if (rt == null) return;
+
+		if (!s_idle.TryGetValue(key, out var list)) {
+			list = new List<Idle>();
+			s_idle.Add(key, list);
+		}
+		list.Add( new Idle{ rt = rt, lastUsedFrame = Time.frameCount } );
+		++IdleCount;
+	}
+
+	/** プールから借りたものか否か */
+	public static bool isRented(Texture tex) {
+		var rt = tex as RenderTexture;
+		return rt != null && s_rented.ContainsKey(rt);
+	}
+
+	/**
+	 * プールから借りたものであれば返し、そうでなければ破棄する。
+	 * ExternalCubemap で作成したものはネイティブ側のテクスチャも解放する
+	 */
+	public static void giveBackOrDestroy(Texture tex) {
+		// 以前の「結果は破棄する」使い方で既に破棄されていた場合も、貸し出し中の記録は消しておく
+		if (tex is RenderTexture destroyed && destroyed == null) {
+			s_rented.Remove(destroyed);
+			return;
+		}
+		if (tex == null) return;
+		if (isRented(tex)) {
+			giveBack((RenderTexture)tex);
+			return;
+		}
+		if (ExternalCubemap.isExternal(tex)) {
+			ExternalCubemap.destroy((Cubemap)tex);
+			return;
+		}
+
+		var rt = tex as RenderTexture;
+		if (rt != null) rt.Release();
+		destroy(tex);
+	}
+
+	/** 解放条件に当てはまるものを解放する。毎フレーム呼ぶ */
+	public static void trim() {
+		forgetDestroyedRented();
+
+		var now = Time.frameCount;
+		foreach (var list in s_idle.Values) {
+			// 古いものほど先頭にあるので、先頭から解放する
+			int removeCnt = Math.Max(0, list.Count - maxIdleCountPerKey);
+			while (removeCnt < list.Count && maxIdleFrames < now - list[removeCnt].lastUsedFrame) ++removeCnt;
+			if (removeCnt == 0) continue;
+
+			for (int i=0; i<removeCnt; ++i) release(list[i].rt);
+			list.RemoveRange(0, removeCnt);
+			IdleCount -= removeCnt;
+		}
+	}
+
+	/** 使われていないものをすべて解放する */
+	public static void clear() {
+		foreach (var list in s_idle.Values)
+			foreach (var i in list) release(i.rt);
+		s_idle.Clear();
+		IdleCount = 0;
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	/** プール内の種類を区別するキー */
+	readonly struct Key : IEquatable<Key> {
+		public Key(in RenderTextureDescriptor desc) {
+			width = desc.width;
+			height = desc.height;
+			volumeDepth = desc.volumeDepth;
+			format = desc.graphicsFormat;
+			depthBits = desc.depthBufferBits;
+			dimension = desc.dimension;
+			msaaSamples = desc.msaaSamples;
+			mipCount = desc.useMipMap ? desc.mipCount : 1;
+			flags = (desc.autoGenerateMips ? 1 : 0) | (desc.enableRandomWrite ? 2 : 0);
+		}
+
+		readonly int width, height, volumeDepth, depthBits, msaaSamples, mipCount, flags;
+		readonly GraphicsFormat format;
+		readonly UnityEngine.Rendering.TextureDimension dimension;
+
+		public bool Equals(Key o) =>
+			width == o.width && height == o.height && volumeDepth == o.volumeDepth &&
+			format == o.format && depthBits == o.depthBits && dimension == o.dimension &&
+			msaaSamples == o.msaaSamples && mipCount == o.mipCount && flags == o.flags;
+		public override bool Equals(object obj) => obj is Key o && Equals(o);
+		public override int GetHashCode() {
+			int h = width;
+			h = h * 31 + height;
+			h = h * 31 + volumeDepth;
+			h = h * 31 + (int)format;
+			h = h * 31 + depthBits;
+			h = h * 31 + (int)dimension;
+			h = h * 31 + msaaSamples;
+			h = h * 31 + mipCount;
+			return h * 31 + flags;
+		}
+	}
+
+	/** 使われずに保持している1つ分の情報 */
+	struct Idle {
+		public RenderTexture rt;
+		public int lastUsedFrame;
+	}
+
+	static Dictionary<Key, List<Idle>> s_idle = new Dictionary<Key, List<Idle>>();
+	static Dictionary<RenderTexture, Key> s_rented = new Dictionary<RenderTexture, Key>();
+
+	/** 破棄された貸し出し中のものの一時リスト */
+	static List<RenderTexture> s_destroyedRented = new List<RenderTexture>();
+
+	/**
+	 * 返されずに外部で破棄された貸し出し中のものを、記録から消す。
+	 * 生成結果を Destroy する使い方をされても、貸し出し中の記録が残り続けないようにする
+	 */
+	static void forgetDestroyedRented() {
+		foreach (var rt in s_rented.Keys)
+			if (rt == null) s_destroyedRented.Add(rt);
+		if (s_destroyedRented.Count == 0) return;
+
+		foreach (var rt in s_destroyedRented) s_rented.Remove(rt);
+		s_destroyedRented.Clear();
+	}
+
+	static void release(RenderTexture rt) {
+		if (rt == null) return;
+		rt.Release();
+		destroy(rt);
+	}
+
+	static void destroy(UnityEngine.Object obj) {
+		if (Application.isPlaying) UnityEngine.Object.Destroy(obj);
+		else UnityEngine.Object.DestroyImmediate(obj);
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -0,0 +1,70 @@
+using System;
+using UnityEngine;
+
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * キューブマップにガウシアンぼかしをかけるモジュール。
+ * すりガラス風のUIや粗い材質向けのぼけた環境マップを、低解像度で撮り直さずに作るために使用する。
+ * 面の縁をまたぐフェッチは隣接面の向きに合わせて行うので、継ぎ目は出ない。
+ */
+public static class CubemapBlur {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** ぼかしの最大半径(テクセル数)。sigmaの3倍がこれを超える場合は切り詰められる */
+	public const int MaxRadius = 64;
+
+	/**
+	 * キューブマップにガウシアンぼかしをかけたものを、dstCubemapに書き込む。
+	 * sigmaはテクセル単位。srcとdstに同じテクスチャを指定した場合はその場で更新する。
+	 * 双方ARGB32・同サイズのキューブマップであること。未対応の環境の場合はfalseを返す
+	 */
+	public static bool blur(Texture srcCubemap, Texture dstCubemap, float sigma) {
+		if (srcCubemap == null || dstCubemap == null) throw new ArgumentNullException();
+		if (
+			srcCubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube ||
+			dstCubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube
+		) throw new ArgumentException("texture is not cube texture");
+		if (srcCubemap.width != dstCubemap.width) throw new ArgumentException("size mismatch");
+		if (sigma < 0) throw new ArgumentOutOfRangeException(nameof(sigma));
+
+		var dstRT = dstCubemap as RenderTexture;
+		if (dstRT != null && !dstRT.IsCreated()) dstRT.Create();
+		return Plugin.CubemapBuilderPlugin.blurCubemap(
+			srcCubemap.GetNativeTexturePtr(),
+			dstCubemap.GetNativeTexturePtr(),
+			srcCubemap.width,
+			sigma
+		);
+	}
+
+	/**
+	 * ホスト側のキューブマップのピクセル配列(6面連続)にガウシアンぼかしをかける。
+	 * 複数スレッドで処理する。srcとdstに同じ配列を指定した場合はその場で更新する
+	 */
+	public static unsafe void blur(
+		NativeArray<Color32> srcFaces, NativeArray<Color32> dstFaces, int size,
+		float sigma
+	) {
+		if (srcFaces.Length < size*size*6 || dstFaces.Length < size*size*6)
+			throw new ArgumentException("buffer is too short");
+		if (sigma < 0) throw new ArgumentOutOfRangeException(nameof(sigma));
+
+		var isSucceeded = Plugin.CubemapBuilderPlugin.blurCubemapCPU(
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(srcFaces),
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafePtr(dstFaces),
+			size,
+			sigma
+		);
+		if (!isSucceeded) throw new ArgumentException();
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -0,0 +1,277 @@
+using System;
+using UnityEngine;
+using UnityEngine.Experimental.Rendering;
+
+using Unity.Mathematics;
+using static Unity.Mathematics.math;
+using System.Collections.Generic;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * 生成したキューブマップを所有して、VRAM使用量を予算内に保つキャッシュ。
+ * Managerと同じオブジェクトなどに配置し、Managerの代わりにこれの beginRender を呼んで使用する。
+ *
+ * 格納したキューブマップはこのキャッシュが所有するので、使用する側で破棄してはいけない。
+ * 使用量が予算を超えた場合は、最後に参照(tryGet / markSampled)されてから最も時間が経ったものから破棄する。
+ * Managerの再利用により同じテクスチャが複数のキーに格納される場合があり、その場合は最後のキーが外れた時点で破棄する。
+ */
+[ExecuteAlways]
+[AddComponentMenu("CubemapOnTheFly/CubemapOnTheFly_Cache")]
+public sealed class CubemapCache : MonoBehaviour {
+	// --------------------------- インスペクタに公開しているフィールド -----------------------------
+
+	/** 生成に使用するManager */
+	[SerializeField] Manager _manager = null;
+
+	/** VRAM使用量の予算(MB) */
+	[SerializeField][Min(1)] int _budgetMB = 256;
+
+
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** キャッシュのキー */
+	public struct Key : IEquatable<Key> {
+		public float3 position;		//!< レンダリング位置
+		public int size;			//!< 1面の一辺のピクセル数
+
+		public Key(float3 position, int size) {
+			this.position = position;
+			this.size = size;
+		}
+
+		public bool Equals(Key other) => all(position == other.position) && size == other.size;
+		public override bool Equals(object obj) => obj is Key other && Equals(other);
+		public override int GetHashCode() => (int)math.hash(position) ^ size.GetHashCode();
+	}
+
+	/** VRAM使用量の予算(byte) */
+	public long BudgetBytes {
+		get => (long)_budgetMB * 1024 * 1024;
+		set { _budgetMB = (int)Math.Max(1, value / (1024 * 1024)); evictToBudget(null); }
+	}
+
+	/** 格納しているキューブマップの合計VRAM使用量(byte) */
+	public long UsedBytes {get; private set;}
+	/** 格納しているキューブマップの数 */
+	public int Count => _entries.Count;
+
+	/** tryGet / beginRender でキャッシュにあった回数 */
+	public long HitCount {get; private set;}
+	/** tryGet / beginRender でキャッシュに無かった回数 */
+	public long MissCount {get; private set;}
+	/** 予算超過で破棄した回数 */
+	public long EvictionCount {get; private set;}
+
+	/** 予算超過で破棄される直前に呼ばれる。破棄されたテクスチャへの参照を外すために使用する */
+	public event Action<Key, Texture> onEvicted;
+
+
+	/**
+	 * 指定のパラメータのキューブマップを取得する。無い場合は生成を開始する。
+	 * 生成したものはキャッシュに格納してから onComplete に渡す。
+	 * キャッシュにあった場合は、この呼び出し中に onComplete が呼ばれる
+	 */
+	public IDisposable beginRender(
+		int texSize, float3 pos,
+		Action<Texture> onComplete,
+		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onBeginRenderPerFrame = null,
+		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onEndRenderPerFrame = null
+	) {
+		var key = new Key(pos, texSize);
+		if (tryGet(key, out var cached)) {
+			onComplete?.Invoke(cached);
+			return s_completedHandle;
+		}
+
+		return _manager.beginRender(
+			texSize, pos,
+			cubemap => {
+				if (cubemap != null) add(key, cubemap);
+				onComplete?.Invoke(cubemap);
+			},
+			onBeginRenderPerFrame,
+			onEndRenderPerFrame
+		);
+	}
+
+	/** キャッシュからキューブマップを取得する。取得したものは最近参照されたものとして扱う */
+	public bool tryGet(in Key key, out Texture cubemap) {
+		if (_entries.TryGetValue(key, out var node)) {
+			++HitCount;
+			touch(node);
+			cubemap = node.Value.texture;
+			return true;
+		}
+
+		++MissCount;
+		cubemap = null;
+		return false;
+	}
+
+	/** 指定のキューブマップが参照されたことを記録する。描画に使用したフレームごとに呼ぶと良い */
+	public void markSampled(Texture cubemap) {
+		if (cubemap == null || !_nodesByTex.TryGetValue(cubemap, out var nodes)) return;
+		foreach (var i in nodes) touch(i);
+	}
+
+	/**
+	 * キューブマップを格納して所有する。同じキーのものがある場合は置き換えて、古いものは破棄する。
+	 * 既に別のキーで格納しているテクスチャの場合は、それと共有する(使用量も1つ分として数える)。
+	 * 格納後に予算を超えている場合は、これ以外の古いものから破棄する
+	 */
+	public void add(in Key key, Texture cubemap) {
+		if (cubemap == null) throw new ArgumentNullException();
+		if (_entries.TryGetValue(key, out var old) && old.Value.texture == cubemap) {
+			touch(old);
+			return;
+		}
+		remove(key);
+
+		var bytes = estimateBytes(cubemap);
+		var node = _lru.AddFirst( new Entry{ key = key, texture = cubemap, bytes = bytes } );
+		_entries.Add(key, node);
+		if (!_nodesByTex.TryGetValue(cubemap, out var nodes)) {
+			nodes = new List<LinkedListNode<Entry>>();
+			_nodesByTex.Add(cubemap, nodes);
+			UsedBytes += bytes;
+		}
+		nodes.Add(node);
+
+		evictToBudget(node);
+	}
+
+	/** 指定のキーのキューブマップを破棄する */
+	public bool remove(in Key key) {
+		if (!_entries.TryGetValue(key, out var node)) return false;
+		removeNode(node);
+		return true;
+	}
+
+	/** すべてのキューブマップを破棄する */
+	public void clear() {
+		while (_lru.Last != null) removeNode(_lru.Last);
+	}
+
+	/** 統計カウンタをリセットする */
+	public void resetCounters() {
+		HitCount = MissCount = EvictionCount = 0;
+	}
+
+	/** テクスチャのVRAM使用量(byte)を見積もる。全ミップ・全面分と、RTの場合は深度バッファを含む */
+	public static long estimateBytes(Texture tex) {
+		var format = tex.graphicsFormat;
+		long blockBytes = GraphicsFormatUtility.GetBlockSize(format);
+		long blockW = GraphicsFormatUtility.GetBlockWidth(format);
+		long blockH = GraphicsFormatUtility.GetBlockHeight(format);
+
+		long bytes = 0;
+		for (int i=0; i<tex.mipmapCount; ++i) {
+			long w = Math.Max(1, tex.width >> i), h = Math.Max(1, tex.height >> i);
+			bytes += ((w + blockW - 1) / blockW) * ((h + blockH - 1) / blockH) * blockBytes;
+		}
+
+		int sliceCnt = 1;
+		switch (tex.dimension) {
+		case UnityEngine.Rendering.TextureDimension.Cube : sliceCnt = 6; break;
+		case UnityEngine.Rendering.TextureDimension.CubeArray :
+			sliceCnt = 6 * (tex is CubemapArray ca ? ca.cubemapCount : 1); break;
+		}
+		bytes *= sliceCnt;
+
+		var rt = tex as RenderTexture;
+		if (rt != null && 0 < rt.depth) bytes += (long)rt.width * rt.height * (rt.depth / 8) * sliceCnt;
+		return bytes;
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	/** キャッシュにあって即完了した場合に返す、何もしないハンドル */
+	sealed class CompletedHandle : IDisposable {
+		public void Dispose() {}
+	}
+	static readonly CompletedHandle s_completedHandle = new CompletedHandle();
+
+	/** 格納しているキューブマップ1つ分の情報 */
+	struct Entry {
+		public Key key;
+		public Texture texture;
+		public long bytes;
+	}
+
+	/** 最近参照されたものほど先頭にあるリスト */
+	LinkedList<Entry> _lru = new LinkedList<Entry>();
+	Dictionary<Key, LinkedListNode<Entry>> _entries = new Dictionary<Key, LinkedListNode<Entry>>();
+	/** テクスチャごとの、それを格納しているもの。すべて外れたときに破棄する */
+	Dictionary<Texture, List<LinkedListNode<Entry>>> _nodesByTex = new Dictionary<Texture, List<LinkedListNode<Entry>>>();
+
+	void touch(LinkedListNode<Entry> node) {
+		if (_lru.First == node) return;
+		_lru.Remove(node);
+		_lru.AddFirst(node);
+	}
+
+	/** 予算内に収まるまで、古いものから破棄する。keepで指定したものは破棄しない */
+	void evictToBudget(LinkedListNode<Entry> keep) {
+		while (BudgetBytes < UsedBytes) {
+			var victim = _lru.Last;
+			if (victim == keep) victim = victim.Previous;
+			if (victim == null) break;
+
+			++EvictionCount;
+			onEvicted?.Invoke(victim.Value.key, victim.Value.texture);
+			removeNode(victim);
+		}
+	}
+
+	/** 格納しているものを取り除く。isDestroy の場合は、他のキーで共有していなければキューブマップも破棄する */
+	void removeNode(LinkedListNode<Entry> node, bool isDestroy = true) {
+		var entry = node.Value;
+		_lru.Remove(node);
+		_entries.Remove(entry.key);
+
+		var nodes = _nodesByTex[entry.texture];
+		nodes.Remove(node);
+		if (nodes.Count != 0) return;
+
+		_nodesByTex.Remove(entry.texture);
+		UsedBytes -= entry.bytes;
+		if (isDestroy) destroyTexture(entry.texture);
+	}
+
+	/** プールから借りたものはManagerの再利用の対象からも外す必要があるので、Managerを通して返す */
+	void destroyTexture(Texture tex) {
+		if (_manager != null) _manager.recycle(tex);
+		else Core.RenderTexturePool.giveBackOrDestroy(tex);
+	}
+
+	/** Managerで直接 recycle されたものは、破棄済みとしてすべてのキーをキャッシュから外す */
+	void onManagerRecycling(Texture tex) {
+		if (!_nodesByTex.TryGetValue(tex, out var nodes)) return;
+		while (nodes.Count != 0) removeNode(nodes[nodes.Count - 1], false);
+	}
+
+	void OnEnable() {
+		if (_manager != null) _manager.onRecycling += onManagerRecycling;
+	}
+
+	void OnDisable() {
+		if (_manager != null) _manager.onRecycling -= onManagerRecycling;
+	}
+
+	void OnDestroy() {
+		clear();
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+#if UNITY_EDITOR
+	void OnValidate() {
+		if (_manager == null) _manager = GetComponent<Manager>();
+	}
+#endif
+}
+
+}
@@ -0,0 +1,325 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading;
+using UnityEngine;
+using UnityEngine.Rendering;
+using UnityEngine.Experimental.Rendering;
+
+using Unity.Mathematics;
+using static Unity.Mathematics.math;
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * 生成済みキューブマップのディスクキャッシュ。
+ * 静的なプローブをロードのたびに撮り直さないように、(位置, サイズ, 形式, シーンのハッシュ) をキーとして
+ * 全ミップ・全面をKTX2ファイルに保存する。
+ * 読み込み時はレンダースレッドでNative側がファイルをメモリにマップして直接テクスチャへ転送するので、
+ * マネージド側へのコピーは発生せず、メインスレッドも止めない。
+ */
+public sealed class CubemapDiskCache {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** キャッシュのキー */
+	public struct Key : IEquatable<Key> {
+		public float3 position;			//!< レンダリング位置
+		public int size;				//!< 1面の一辺のピクセル数
+		public GraphicsFormat format;	//!< キューブマップの形式
+		public Hash128 sceneHash;		//!< シーン内容のハッシュ。内容が変わったら変えること
+
+		public Key(float3 position, int size, GraphicsFormat format, Hash128 sceneHash) {
+			this.position = position;
+			this.size = size;
+			this.format = format;
+			this.sceneHash = sceneHash;
+		}
+
+		public bool Equals(Key other) =>
+			all(asuint(position) == asuint(other.position)) &&
+			size == other.size && format == other.format && sceneHash == other.sceneHash;
+		public override bool Equals(object obj) => obj is Key other && Equals(other);
+		public override int GetHashCode() =>
+			(int)math.hash(asuint(position)) ^ size.GetHashCode() ^ ((int)format << 16) ^ sceneHash.GetHashCode();
+
+		/** ファイルに格納して照合する文字列。位置は誤差を含めないようにビット列で表す */
+		public override string ToString() {
+			var p = asuint(position);
+			return $"pos={p.x:x8},{p.y:x8},{p.z:x8};size={size};format={(int)format};scene={sceneHash}";
+		}
+	}
+
+	/** キャッシュファイルを置くディレクトリ */
+	public string DirectoryPath {get; private set;}
+
+	/** ディレクトリを指定して初期化する。nullの場合は persistentDataPath 以下を使用する */
+	public CubemapDiskCache(string directoryPath = null) {
+		DirectoryPath = directoryPath ?? Path.Combine(Application.persistentDataPath, "CubemapOnTheFly");
+	}
+
+	/** キーに対応するキャッシュファイルのパス */
+	public string getPath(in Key key) {
+		return Path.Combine( DirectoryPath, Hash128.Compute(key.ToString()).ToString() + ".ktx2" );
+	}
+
+	/** beginLoad で開始した、キャッシュからの読み込み */
+	public sealed class PendingLoad {
+
+		/** 読み込み先のキューブマップ。読み込みが成功するまでは内容は不定。失敗・中止した場合はnull */
+		public Cubemap Texture {get; private set;}
+
+		internal PendingLoad(string path, string key, Cubemap texture) {
+			Texture = texture;
+			_nativePath = allocUtf8(path);
+			_nativeKey = allocUtf8(key);
+			_request = issueLoadRequest(_nativePath, _nativeKey, texture, 0, -1, "CubemapOnTheFly.CubemapDiskCache");
+		}
+
+		/**
+		 * 読み込みが終わったかを、待たずに確認する。0:未完了 1:成功 -1:失敗。
+		 * 失敗した場合は Texture を破棄する。完了後に呼んだ場合は同じ結果を返す
+		 */
+		public int poll() {
+			if (_state != 0) return _state;
+			_state = pollLoadRequest(ref _request);
+			if (_state == 0) return 0;
+
+			freeNativeStrings();
+			if (_state < 0) destroyTexture();
+			return _state;
+		}
+
+		/** 読み込みを中止して、Texture を破棄する。レンダースレッドでの処理が終わっていない場合は、終わってから破棄する */
+		public void cancel() {
+			if (poll() == 0) {
+				s_cancelled.Add(this);
+				return;
+			}
+			destroyTexture();
+		}
+
+		internal void destroyTexture() {
+			if (Texture == null) return;
+			if (Application.isPlaying) UnityEngine.Object.Destroy(Texture);
+			else UnityEngine.Object.DestroyImmediate(Texture);
+			Texture = null;
+		}
+
+		IntPtr _nativePath, _nativeKey;		//!< レンダースレッドへ渡すUTF-8文字列
+		IntPtr _request;
+		int _state;
+
+		void freeNativeStrings() {
+			Marshal.FreeHGlobal(_nativePath);
+			Marshal.FreeHGlobal(_nativeKey);
+			_nativePath = _nativeKey = IntPtr.Zero;
+		}
+	}
+
+	/**
+	 * キャッシュからキューブマップの読み込みを開始する。無い場合や内容が一致しない場合はnullを返す。
+	 * 転送はレンダースレッド(対応している環境ではプラグインのワーカースレッド)で行うので、
+	 * 完了は PendingLoad.poll で毎フレーム確認すること。ワーカースレッドで転送した場合は
+	 * CubemapBuilderPlugin.issuePollAsync で完了を取り込ませる必要がある。
+	 * 読み込んだキューブマップは、使用する側で不要になったら破棄すること
+	 */
+	public PendingLoad beginLoad(in Key key) {
+		collectCancelled();
+
+		var path = getPath(key);
+		if (!File.Exists(path)) return null;
+
+		var keyStr = key.ToString();
+		if (
+			!Plugin.CubemapBuilderPlugin.getKTX2CubemapInfo(
+				path, keyStr, out var size, out var mipCount, out var format
+			) ||
+			size != key.size ||
+			format != Plugin.PixelFormatUtil.fromGraphicsFormat(key.format)
+		) return null;
+
+		var tex = new Cubemap(
+			size, key.format,
+			1 < mipCount ? TextureCreationFlags.MipChain : TextureCreationFlags.None,
+			mipCount
+		) { name = "CubemapOnTheFly.CubemapDiskCache" };
+		return new PendingLoad(path, keyStr, tex);
+	}
+
+	/**
+	 * キューブマップの全ミップ・全面をキャッシュへ保存する。
+	 * GPUからの読み戻しは非同期で行い、完了後にファイルへ書き込む。
+	 * 読み戻しはこの呼び出し時点の内容で行われるので、呼び出し後にcubemapを破棄しても問題ない。
+	 * 保存を開始できなかった場合はfalseを返す
+	 */
+	public bool store(in Key key, Texture cubemap) {
+		if (cubemap == null) throw new ArgumentNullException();
+		if (cubemap.dimension != TextureDimension.Cube) throw new ArgumentException("texture is not cube texture");
+		if (cubemap.width != key.size) throw new ArgumentException("size mismatch");
+
+		var format = Plugin.PixelFormatUtil.fromGraphicsFormat(key.format);
+		if (format == Plugin.PixelFormat.Unsupported || !SystemInfo.supportsAsyncGPUReadback) return false;
+
+		Directory.CreateDirectory(DirectoryPath);
+		new PendingStore(getPath(key), key.ToString(), cubemap, format);
+		return true;
+	}
+
+	/** キーに対応するキャッシュを削除する */
+	public void remove(in Key key) {
+		var path = getPath(key);
+		if (File.Exists(path)) File.Delete(path);
+	}
+
+	/** すべてのキャッシュを削除する */
+	public void clear() {
+		if (!Directory.Exists(DirectoryPath)) return;
+		foreach (var i in Directory.GetFiles(DirectoryPath, "*.ktx2")) File.Delete(i);
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	/** レンダースレッドへのミップ転送要求。Native側の KTX2LevelLoadRequest と同じレイアウト */
+	[StructLayout(LayoutKind.Sequential)]
+	struct LoadRequest {
+		public IntPtr path;
+		public IntPtr key;
+		public IntPtr cubemapTex;
+		public int firstLevel;
+		public int levelCount;
+		public int dstFirstLevel;
+		public int state;			//!< 0:未処理 1:成功 -1:失敗
+	}
+	static readonly int s_stateOffset = (int)Marshal.OffsetOf<LoadRequest>("state");
+
+	/** 中止したが、レンダースレッドでの処理が終わっていない読み込み。終わってからテクスチャを破棄する */
+	static List<PendingLoad> s_cancelled = new List<PendingLoad>();
+
+	/**
+	 * ファイルのfirstLevel段からlevelCount段(負の場合は最後の段まで)を、cubemapの先頭の段へ転送する要求を
+	 * RenderEventId.LoadKTX2Levels のイベントとして発行する。pathとkeyはUTF-8文字列で、完了するまで解放しないこと。
+	 * 戻り値の要求データは pollLoadRequest で完了を確認して解放する
+	 */
+	internal static IntPtr issueLoadRequest(IntPtr path, IntPtr key, Texture cubemap, int firstLevel, int levelCount, string name) {
+		var req = new LoadRequest{
+			path = path,
+			key = key,
+			cubemapTex = cubemap.GetNativeTexturePtr(),
+			firstLevel = firstLevel,
+			levelCount = levelCount,
+			dstFirstLevel = 0,
+		};
+		var ret = Marshal.AllocHGlobal(Marshal.SizeOf<LoadRequest>());
+		Marshal.StructureToPtr(req, ret, false);
+
+		var cmd = new CommandBuffer{ name = name };
+		cmd.IssuePluginEventAndData(
+			Plugin.CubemapBuilderPlugin.getRenderEventAndDataFunc(),
+			(int)Plugin.CubemapBuilderPlugin.RenderEventId.LoadKTX2Levels,
+			ret
+		);
+		Graphics.ExecuteCommandBuffer(cmd);
+		cmd.Release();
+		return ret;
+	}
+
+	/** 転送要求が終わっていれば、要求データを解放して結果を返す。0:未完了 1:成功 -1:失敗 */
+	internal static int pollLoadRequest(ref IntPtr request) {
+		var state = Marshal.ReadInt32(request, s_stateOffset);
+		if (state == 0) return 0;
+
+		Thread.MemoryBarrier();
+		Marshal.FreeHGlobal(request);
+		request = IntPtr.Zero;
+		return state;
+	}
+
+	/** 中止した読み込みのうち、レンダースレッドでの処理が終わったもののテクスチャを破棄する */
+	internal static void collectCancelled() {
+		for (int i=s_cancelled.Count-1; 0<=i; --i) {
+			var load = s_cancelled[i];
+			if (load.poll() == 0) continue;
+
+			load.destroyTexture();
+			s_cancelled.RemoveAt(i);
+		}
+	}
+
+	/** Native側へ渡す、NULL終端のUTF-8文字列を確保する。Marshal.FreeHGlobal で解放すること */
+	internal static IntPtr allocUtf8(string s) {
+		var bytes = Encoding.UTF8.GetBytes(s);
+		var ret = Marshal.AllocHGlobal(bytes.Length + 1);
+		Marshal.Copy(bytes, 0, ret, bytes.Length);
+		Marshal.WriteByte(ret, bytes.Length, 0);
+		return ret;
+	}
+
+	/** 保存処理中の1件分のデータ。全ミップの読み戻しが揃ったらファイルへ書き込む */
+	sealed class PendingStore {
+		public PendingStore(string path, string key, Texture cubemap, Plugin.PixelFormat format) {
+			_path = path;
+			_key = key;
+			_size = cubemap.width;
+			_format = format;
+			_levels = new NativeArray<byte>[cubemap.mipmapCount];
+			_remainCnt = _levels.Length;
+
+			for (int i=0; i<_levels.Length; ++i) {
+				var level = i;
+				var levelSize = Mathf.Max(1, _size >> i);
+				AsyncGPUReadback.Request(
+					cubemap, level, 0, levelSize, 0, levelSize, 0, 6,
+					format.toTextureFormat(),
+					req => onReadback(req, level, levelSize)
+				);
+			}
+		}
+
+		readonly string _path, _key;
+		readonly int _size;
+		readonly Plugin.PixelFormat _format;
+		NativeArray<byte>[] _levels;
+		int _remainCnt;
+		bool _hasError;
+
+		void onReadback(AsyncGPUReadbackRequest req, int level, int levelSize) {
+			if (req.hasError) {
+				_hasError = true;
+			} else {
+				// 各面の読み戻し結果を、面の順に隙間なく並べる
+				var faceBytes = levelSize * levelSize * _format.bytesPerPixel();
+				var dst = new NativeArray<byte>(faceBytes * 6, Allocator.Persistent, NativeArrayOptions.UninitializedMemory);
+				for (int i=0; i<6; ++i)
+					NativeArray<byte>.Copy( req.GetData<byte>(i), 0, dst, faceBytes * i, faceBytes );
+				_levels[level] = dst;
+			}
+
+			if (--_remainCnt == 0) flush();
+		}
+
+		unsafe void flush() {
+			if (!_hasError) {
+				var ptrs = new IntPtr[_levels.Length];
+				for (int i=0; i<ptrs.Length; ++i)
+					ptrs[i] = (IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(_levels[i]);
+				Plugin.CubemapBuilderPlugin.writeKTX2Cubemap(
+					_path, _size, _levels.Length, _format, ptrs, _key
+				);
+			}
+
+			foreach (var i in _levels) if (i.IsCreated) i.Dispose();
+			_levels = null;
+		}
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -0,0 +1,83 @@
+using System;
+using UnityEngine;
+using UnityEngine.Rendering;
+using UnityEngine.Experimental.Rendering;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * キューブマップの各面を、コピーせずに2Dテクスチャとして参照するビュー。
+ * 元のキューブマップとストレージを共有するので、元への書き込みはそのまま各面のテクスチャに反映される。
+ *
+ * 元のキューブマップは変更不可なストレージを持つもの(ExternalCubemap で作成したものなど)である必要があり、
+ * 現在はOpenGL Core 4.3以上のみ対応。
+ * Unityのカメラは RenderTexture にしか描画できないので、各面のテクスチャは描画先ではなく参照用として使用すること
+ */
+public sealed class CubemapFaceViews : IDisposable {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** 元のキューブマップ */
+	public Cubemap Source {get; private set;}
+
+	/** 指定の面を参照する2Dテクスチャ */
+	public Texture2D this[CubemapFace face] => _faces[(int)face];
+
+	/** ビューを作成する。未対応の環境や、元のキューブマップが変更不可なストレージを持たない場合はnull */
+	public static CubemapFaceViews create(Cubemap source) {
+		if (source == null) throw new ArgumentNullException("source");
+
+		var nativeFaces = new IntPtr[6];
+		if (!Plugin.CubemapBuilderPlugin.createCubemapFaceViews(source.GetNativeTexturePtr(), nativeFaces))
+			return null;
+		return new CubemapFaceViews(source, nativeFaces);
+	}
+
+	/** ビューを破棄する。元のキューブマップには影響しない。ネイティブ側の解放はレンダースレッドで行う */
+	public void Dispose() {
+		if (_faces == null) return;
+
+		var cmd = new CommandBuffer{ name = "CubemapOnTheFly.CubemapFaceViews" };
+		for (int i=0; i<6; ++i) {
+			if (Application.isPlaying) UnityEngine.Object.Destroy(_faces[i]);
+			else UnityEngine.Object.DestroyImmediate(_faces[i]);
+
+			cmd.IssuePluginEventAndData(
+				Plugin.CubemapBuilderPlugin.getRenderEventAndDataFunc(),
+				(int)Plugin.CubemapBuilderPlugin.RenderEventId.DestroyTextureView,
+				_nativeFaces[i]
+			);
+		}
+		Graphics.ExecuteCommandBuffer(cmd);
+		cmd.Release();
+
+		_faces = null;
+		_nativeFaces = null;
+		Source = null;
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	Texture2D[] _faces;
+	IntPtr[] _nativeFaces;
+
+	CubemapFaceViews(Cubemap source, IntPtr[] nativeFaces) {
+		Source = source;
+		_nativeFaces = nativeFaces;
+
+		var isLinear = !GraphicsFormatUtility.IsSRGBFormat(source.graphicsFormat);
+		_faces = new Texture2D[6];
+		for (int i=0; i<6; ++i) {
+			_faces[i] = Texture2D.CreateExternalTexture(
+				source.width, source.height, source.format,
+				1 < source.mipmapCount, isLinear, nativeFaces[i]
+			);
+		}
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -0,0 +1,83 @@
+using System;
+using UnityEngine;
+using UnityEngine.Experimental.Rendering;
+
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * キューブマップの輝度統計を求めるモジュール。
+ * プローブで照らす範囲の自動露出用に、キャプチャ全体を読み戻さずに平均輝度等を得るために使用する。
+ * GPU版は集計と取得を分けていて、取得はGPUの完了を待たないので、集計の次のフレーム以降に取得すること。
+ */
+public static class CubemapLuminance {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** ヒストグラムの範囲の既定値(log2輝度)。RGBA8で表せる範囲をほぼ覆う */
+	public const float DefaultMinLog2Luminance = -16;
+	public const float DefaultMaxLog2Luminance = 0;
+
+	/**
+	 * キューブマップの輝度統計をGPU上で集計する。結果は tryGetStats で取得する。
+	 * 形式は問わず、sRGBのものはリニアに変換した値で集計する。未対応の環境(コンピュートシェーダ非対応等)の場合はfalseを返す
+	 */
+	public static bool compute(
+		Texture cubemap,
+		float minLog2Luminance = DefaultMinLog2Luminance,
+		float maxLog2Luminance = DefaultMaxLog2Luminance
+	) {
+		if (cubemap == null) throw new ArgumentNullException();
+		if (cubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube)
+			throw new ArgumentException("texture is not cube texture");
+		if (!(minLog2Luminance < maxLog2Luminance)) throw new ArgumentException("invalid luminance range");
+
+		return Plugin.CubemapBuilderPlugin.computeCubemapLuminanceStats(
+			cubemap.GetNativeTexturePtr(),
+			cubemap.width,
+			minLog2Luminance,
+			maxLog2Luminance
+		);
+	}
+
+	/**
+	 * 直近の compute の結果を取得する。GPUの完了は待たないので、まだ集計中の場合はfalseを返す。
+	 * その場合は次のフレーム以降に再度呼ぶこと。結果が無い場合もfalseを返す
+	 */
+	public static bool tryGetStats(out LuminanceStats stats) {
+		return Plugin.CubemapBuilderPlugin.getCubemapLuminanceStats(out stats);
+	}
+
+	/**
+	 * ホスト側のキューブマップのピクセル配列(6面連続)の輝度統計を求める。
+	 * formatには読み戻し元のテクスチャの形式(Texture.graphicsFormat)を指定する。
+	 * sRGBの形式の場合はGPU版と同じく、リニアに変換した値で集計する
+	 */
+	public static unsafe LuminanceStats compute(
+		NativeArray<Color32> faces, int size, GraphicsFormat format,
+		float minLog2Luminance = DefaultMinLog2Luminance,
+		float maxLog2Luminance = DefaultMaxLog2Luminance
+	) {
+		if (faces.Length < size*size*6) throw new ArgumentException("buffer is too short");
+		if (GraphicsFormatUtility.GetBlockSize(format) != 4) throw new ArgumentException("format is not 32bit color");
+
+		LuminanceStats stats;
+		var isSucceeded = Plugin.CubemapBuilderPlugin.computeCubemapLuminanceStatsCPU(
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(faces),
+			size,
+			GraphicsFormatUtility.IsSRGBFormat(format),
+			minLog2Luminance,
+			maxLog2Luminance,
+			out stats
+		);
+		if (!isSucceeded) throw new ArgumentException();
+		return stats;
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
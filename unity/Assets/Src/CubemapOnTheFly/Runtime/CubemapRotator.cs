@@ -0,0 +1,87 @@
+using System;
+using UnityEngine;
+
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * 既存のキューブマップを回転させるモジュール。
+ * スカイボックスの回転などで、6面を撮り直さずにリサンプリングで済ませるために使用する。
+ * 面の境界をまたぐバイリニアで補間するので、継ぎ目は出ない。
+ * GPU版は形式を問わず(HDRやsRGBも可)、CPU版は1テクセル4byteのピクセル配列を扱う。
+ */
+public static class CubemapRotator {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/**
+	 * キューブマップに指定の回転を適用したものを、dstCubemapに書き込む。
+	 * srcとdstに同じテクスチャを指定した場合はその場で更新する。
+	 * 形式は問わないが、srcとdstは同じ形式・同サイズのキューブマップであること。
+	 * その場で更新する場合の一時キューブマップも同じ形式で確保するので、HDRの値やsRGBの精度は保たれる。
+	 * GPUでの回転はデスクトップのOpenGLのみ対応で、未対応の環境の場合はfalseを返す
+	 */
+	public static bool rotate(Texture srcCubemap, Texture dstCubemap, Quaternion rotation) {
+		if (srcCubemap == null || dstCubemap == null) throw new ArgumentNullException();
+		if (
+			srcCubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube ||
+			dstCubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube
+		) throw new ArgumentException("texture is not cube texture");
+		if (srcCubemap.width != dstCubemap.width) throw new ArgumentException("size mismatch");
+		if (srcCubemap.graphicsFormat != dstCubemap.graphicsFormat) throw new ArgumentException("format mismatch");
+
+		var dstRT = dstCubemap as RenderTexture;
+		if (dstRT != null && !dstRT.IsCreated()) dstRT.Create();
+		return Plugin.CubemapBuilderPlugin.rotateCubemap(
+			srcCubemap.GetNativeTexturePtr(),
+			dstCubemap.GetNativeTexturePtr(),
+			srcCubemap.width,
+			toSampleMatrix(rotation)
+		);
+	}
+
+	/**
+	 * ホスト側のキューブマップのピクセル配列(6面連続)に、指定の回転を適用する。
+	 * srcとdstに同じ配列を指定した場合はその場で更新する。
+	 * RGBA8などの1テクセル4byteの形式を、チャンネルごとに補間する
+	 */
+	public static unsafe void rotate(
+		NativeArray<Color32> srcFaces, NativeArray<Color32> dstFaces, int size,
+		Quaternion rotation
+	) {
+		if (srcFaces.Length < size*size*6 || dstFaces.Length < size*size*6)
+			throw new ArgumentException("buffer is too short");
+
+		var isSucceeded = Plugin.CubemapBuilderPlugin.rotateCubemapCPU(
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(srcFaces),
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafePtr(dstFaces),
+			size,
+			toSampleMatrix(rotation)
+		);
+		if (!isSucceeded) throw new ArgumentException();
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	static float[] s_mtxBuf = new float[9];		//!< Nativeに渡す行列のバッファ。GCを避けるために使いまわす
+
+	/**
+	 * 環境を指定の回転だけ回すための、サンプリング方向の変換行列を求める。
+	 * 出力の方向dには入力の rot^-1 * d の方向が入るので、逆回転の行列を行優先で詰める
+	 */
+	static float[] toSampleMatrix(Quaternion rotation) {
+		var m = Matrix4x4.Rotate( Quaternion.Inverse(rotation) );
+		s_mtxBuf[0] = m.m00; s_mtxBuf[1] = m.m01; s_mtxBuf[2] = m.m02;
+		s_mtxBuf[3] = m.m10; s_mtxBuf[4] = m.m11; s_mtxBuf[5] = m.m12;
+		s_mtxBuf[6] = m.m20; s_mtxBuf[7] = m.m21; s_mtxBuf[8] = m.m22;
+		return s_mtxBuf;
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -0,0 +1,90 @@
+using System;
+using UnityEngine;
+using UnityEngine.Experimental.Rendering;
+
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * キューブマップの面の継ぎ目を修正するモジュール。
+ * シームレスなキューブマップフィルタリングが無い環境やミップの粗い段で見える継ぎ目を、
+ * 各面の縁のテクセルを隣接面と平均して共有させることで目立たなくする。
+ */
+public static class CubemapSeamFixup {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/**
+	 * キューブマップの継ぎ目をその場で修正する。
+	 * includeMipsがtrueの場合は全ミップレベルに適用する。ARGB32のキューブマップであること。
+	 * GPUでの修正はデスクトップのOpenGLのみ対応なので、それ以外の環境では読み込み可能な Cubemap に限りCPUで修正する。
+	 * どちらも行えない場合(それ以外の環境でのRenderTexture等)はfalseを返す
+	 */
+	public static bool fixup(Texture cubemap, bool includeMips = true) {
+		if (cubemap == null) throw new ArgumentNullException();
+		if (cubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube)
+			throw new ArgumentException("texture is not cube texture");
+
+		var mipCount = includeMips ? cubemap.mipmapCount : 1;
+		var rt = cubemap as RenderTexture;
+		if (rt != null && !rt.IsCreated()) rt.Create();
+		if (Plugin.CubemapBuilderPlugin.fixupCubemapSeams(
+			cubemap.GetNativeTexturePtr(),
+			cubemap.width,
+			mipCount
+		)) return true;
+
+		return cubemap is Cubemap c && fixupCPU(c, mipCount);
+	}
+
+	/** ホスト側のキューブマップのピクセル配列(6面連続・1ミップ分)の継ぎ目をその場で修正する */
+	public static unsafe void fixup(NativeArray<Color32> faces, int size) {
+		if (faces.Length < size*size*6) throw new ArgumentException("buffer is too short");
+
+		var isSucceeded = Plugin.CubemapBuilderPlugin.fixupCubemapSeamsCPU(
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafePtr(faces),
+			size
+		);
+		if (!isSucceeded) throw new ArgumentException();
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	/**
+	 * 読み込み可能なキューブマップの継ぎ目を、CPU側のピクセルデータで修正してGPUへ反映する。
+	 * 各ミップで6面を連続した配列へ並べてから修正する。1テクセル4byteの非圧縮形式以外はfalseを返す
+	 */
+	static bool fixupCPU(Cubemap cubemap, int mipCount) {
+		var format = cubemap.graphicsFormat;
+		if (
+			!cubemap.isReadable ||
+			GraphicsFormatUtility.IsCompressedFormat(format) ||
+			GraphicsFormatUtility.GetBlockSize(format) != 4 ||
+			GraphicsFormatUtility.GetComponentCount(format) != 4
+		) return false;
+
+		for (int mip=0; mip<mipCount; ++mip) {
+			var size = Math.Max(1, cubemap.width >> mip);
+			var faceTexCnt = size * size;
+			using (var faces = new NativeArray<Color32>(faceTexCnt * 6, Allocator.Temp, NativeArrayOptions.UninitializedMemory)) {
+				for (int i=0; i<6; ++i)
+					NativeArray<Color32>.Copy( cubemap.GetPixelData<Color32>(mip, (CubemapFace)i), 0, faces, faceTexCnt * i, faceTexCnt );
+				fixup(faces, size);
+				for (int i=0; i<6; ++i)
+					cubemap.SetPixelData( faces, mip, (CubemapFace)i, faceTexCnt * i );
+			}
+		}
+
+		// 各ミップを修正済みなので、ミップを再生成しない。次回も修正できるように読み込み可能なままにしておく
+		cubemap.Apply(false, false);
+		return true;
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
@@ -0,0 +1,345 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using UnityEngine;
+using UnityEngine.Rendering;
+using UnityEngine.Experimental.Rendering;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * ディスクキャッシュ(CubemapDiskCache)に保存されたキューブマップを、ミップ単位でストリーミングするモジュール。
+ * 画面上での大きさから必要な解像度を求め、その解像度以下のミップだけを常駐させる。
+ *
+ * 常駐させるミップが変わるたびに、必要な段だけを持つ大きさのキューブマップを作り直す。
+ * 上位のミップを足す場合は1段ずつ、既存の段をGPU上でコピーしてから新しい段だけをファイルから転送する。
+ * 転送は、対応している環境ではプラグインのワーカースレッドで行い、レンダースレッドを止めない。
+ * 予算を超えた場合は、画面上で小さいものから上位のミップを落とす。
+ * そのため使用する側は Handle.Texture を毎フレーム参照するか、onTextureChanged で差し替えること。
+ */
+[ExecuteAlways]
+[AddComponentMenu("CubemapOnTheFly/CubemapOnTheFly_Streamer")]
+public sealed class CubemapStreamer : MonoBehaviour {
+	// --------------------------- インスペクタに公開しているフィールド -----------------------------
+
+	/** 常駐させるミップの合計VRAM使用量の予算(MB) */
+	[SerializeField][Min(1)] int _budgetMB = 64;
+
+	/** 常に常駐させる下位ミップの、1面の一辺のピクセル数。これ以下の段は最初にまとめて読み込み、予算超過でも破棄しない */
+	[SerializeField][Min(1)] int _baseSize = 32;
+
+	/** 1フレームに開始するミップ読み込みの最大数 */
+	[SerializeField][Min(1)] int _maxLoadsPerFrame = 2;
+
+	/** 画面上の大きさ(ピクセル)に掛けて、必要な1面の解像度を求める係数 */
+	[SerializeField][Min(0.01f)] float _resolutionScale = 1;
+
+
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** ストリーミング中のキューブマップ1つ分のハンドル */
+	public sealed class Handle {
+
+		/** 現在常駐しているミップを持つキューブマップ。最初の読み込みが終わるまではnull。常駐ミップが変わると差し替わる */
+		public Cubemap Texture {get; private set;}
+		/** ファイル上の1面の一辺のピクセル数 */
+		public int Size {get; private set;}
+		/** ファイル上のミップ段数 */
+		public int MipCount {get; private set;}
+		/** 現在常駐している最上位のミップ段。何も常駐していない場合はMipCount */
+		public int ResidentTopMip {get; private set;}
+		/** 画面上の大きさと予算から求めた、常駐させたい最上位のミップ段 */
+		public int RequestedTopMip {get; private set;}
+		/** ファイルからの読み込みに失敗したか否か。失敗した場合はそれ以上読み込まない */
+		public bool HasError {get; private set;}
+
+		/** 画面上での大きさ(ピクセル)。使用する側で毎フレーム更新すること。estimateScreenSize で求められる */
+		public float ScreenSize {get; set;}
+
+		/** Texture が差し替わったときに呼ばれる。古いものは呼び出し後に破棄される */
+		public event Action<Handle> onTextureChanged;
+
+
+		internal Handle(string path, string key, int size, int mipCount, GraphicsFormat format, int baseTop) {
+			Size = size;
+			MipCount = mipCount;
+			ResidentTopMip = RequestedTopMip = mipCount;
+			_format = format;
+			_baseTop = baseTop;
+			_nativePath = CubemapDiskCache.allocUtf8(path);
+			_nativeKey = CubemapDiskCache.allocUtf8(key);
+		}
+
+		internal readonly GraphicsFormat _format;
+		internal readonly int _baseTop;				//!< 常に常駐させる段の最上位
+		internal IntPtr _nativePath, _nativeKey;	//!< レンダースレッドへ渡すUTF-8文字列
+		internal PendingLoad _pending;
+
+		internal void swap(Cubemap tex, int top) {
+			var old = Texture;
+			Texture = tex;
+			ResidentTopMip = top;
+			onTextureChanged?.Invoke(this);
+			destroyTexture(old);
+		}
+
+		internal void setRequestedTopMip(int top) => RequestedTopMip = top;
+		internal void setError() => HasError = true;
+
+		/** 常駐させる最上位の段がtopの場合のVRAM使用量 */
+		internal long bytesFor(int top) {
+			long ret = 0;
+			var bpp = Plugin.PixelFormatUtil.fromGraphicsFormat(_format).bytesPerPixel();
+			for (int i=top; i<MipCount; ++i) {
+				long s = Math.Max(1, Size >> i);
+				ret += s * s * 6 * bpp;
+			}
+			return ret;
+		}
+
+		internal void freeNativeStrings() {
+			Marshal.FreeHGlobal(_nativePath);
+			Marshal.FreeHGlobal(_nativeKey);
+			_nativePath = _nativeKey = IntPtr.Zero;
+		}
+	}
+
+	/** VRAM使用量の予算(byte) */
+	public long BudgetBytes {
+		get => (long)_budgetMB * 1024 * 1024;
+		set => _budgetMB = (int)Math.Max(1, value / (1024 * 1024));
+	}
+
+	/** 常駐しているミップの合計VRAM使用量(byte)。読み込み中のものを含む */
+	public long UsedBytes {get; private set;}
+	/** ストリーミング中のキューブマップの数 */
+	public int Count => _handles.Count;
+
+	/** ファイルからミップを読み込んだ回数 */
+	public long LoadCount {get; private set;}
+	/** 画面上の大きさや予算超過により上位のミップを落とした回数 */
+	public long DropCount {get; private set;}
+
+
+	/**
+	 * ディスクキャッシュのキューブマップのストリーミングを開始する。
+	 * キャッシュに無い場合や内容が一致しない場合はnullを返す。
+	 * 最初は常に常駐させる下位ミップだけをレンダースレッドで読み込む
+	 */
+	public Handle open(CubemapDiskCache diskCache, in CubemapDiskCache.Key key) {
+		var path = diskCache.getPath(key);
+		var keyStr = key.ToString();
+		if (
+			!System.IO.File.Exists(path) ||
+			!Plugin.CubemapBuilderPlugin.getKTX2CubemapInfo(path, keyStr, out var size, out var mipCount, out var format) ||
+			format != Plugin.PixelFormatUtil.fromGraphicsFormat(key.format)
+		) return null;
+
+		// 常に常駐させる段は、一辺が _baseSize 以下になる最上位の段
+		var baseTop = 0;
+		while (baseTop < mipCount-1 && _baseSize < (size >> baseTop)) ++baseTop;
+
+		var ret = new Handle(path, keyStr, size, mipCount, key.format, baseTop);
+		ret.setRequestedTopMip(baseTop);
+		ret._pending = new PendingLoad(ret, createTexture(ret, baseTop), baseTop, -1);
+		_handles.Add(ret);
+		UsedBytes += ret.bytesFor(baseTop);
+		++LoadCount;
+		return ret;
+	}
+
+	/** ストリーミングを終了して、常駐しているキューブマップを破棄する */
+	public void close(Handle handle) {
+		if (handle == null || !_handles.Remove(handle)) return;
+		UsedBytes -= handle.bytesFor(handle.ResidentTopMip);
+		closeCore(handle);
+	}
+
+	/** すべてのストリーミングを終了する */
+	public void clear() {
+		foreach (var i in _handles) closeCore(i);
+		_handles.Clear();
+		UsedBytes = 0;
+	}
+
+	/**
+	 * 中心と半径で表される範囲の、指定カメラの画面上での直径(ピクセル)を求める。
+	 * Handle.ScreenSize に設定する値として使用する。カメラが範囲内にある場合は画面の高さを返す
+	 */
+	public static float estimateScreenSize(Camera camera, Vector3 center, float radius) {
+		var dist = Vector3.Distance(camera.transform.position, center);
+		if (dist <= radius) return camera.pixelHeight;
+
+		if (camera.orthographic) return radius / camera.orthographicSize * camera.pixelHeight;
+		var halfTan = Mathf.Tan(camera.fieldOfView * 0.5f * Mathf.Deg2Rad);
+		return Mathf.Min(camera.pixelHeight, radius / (dist * halfTan) * camera.pixelHeight);
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	/** 読み込み中の、差し替え予定のキューブマップ */
+	internal sealed class PendingLoad {
+		public readonly Cubemap texture;
+		public readonly int top;			//!< textureの最上位の段に対応するファイル上の段
+		IntPtr _request;
+
+		/** ファイルのtop段からlevelCount段を、textureの先頭の段から読み込む要求を出す */
+		public PendingLoad(Handle handle, Cubemap texture, int top, int levelCount) {
+			this.texture = texture;
+			this.top = top;
+			_request = CubemapDiskCache.issueLoadRequest(
+				handle._nativePath, handle._nativeKey, texture, top, levelCount, "CubemapOnTheFly.CubemapStreamer"
+			);
+		}
+
+		/** 読み込みが終わっていれば、要求データを解放して結果を返す。0:未完了 1:成功 -1:失敗 */
+		public int poll() => CubemapDiskCache.pollLoadRequest(ref _request);
+	}
+
+	List<Handle> _handles = new List<Handle>();
+	List<Handle> _sortBuf = new List<Handle>();
+
+	/**
+	 * 読み込み中に終了したハンドル。レンダースレッドでの処理が終わるまでは文字列や要求データを解放できないので、
+	 * 完了してから破棄する。インスタンスをまたいで回収できるように静的に持つ
+	 */
+	static List<Handle> s_closing = new List<Handle>();
+
+	void Update() {
+		collectClosing();
+
+		// 読み込みが終わったものを差し替える
+		foreach (var h in _handles) {
+			if (h._pending == null) continue;
+			var state = h._pending.poll();
+			if (state == 0) continue;
+
+			var pending = h._pending;
+			h._pending = null;
+			if (0 < state) {
+				UsedBytes -= h.bytesFor(h.ResidentTopMip);
+				h.swap(pending.texture, pending.top);
+			} else {
+				UsedBytes -= h.bytesFor(pending.top);
+				h.setError();
+				destroyTexture(pending.texture);
+			}
+		}
+
+		updateRequestedTopMips();
+
+		// 落とすものは、GPU上でのコピーだけで済むので即座に行う
+		foreach (var h in _handles) {
+			if (h._pending != null || h.Texture == null || h.RequestedTopMip <= h.ResidentTopMip) continue;
+
+			var tex = createTexture(h, h.RequestedTopMip);
+			copyLevels(h.Texture, h.ResidentTopMip, tex, h.RequestedTopMip, h.MipCount);
+			UsedBytes += h.bytesFor(h.RequestedTopMip) - h.bytesFor(h.ResidentTopMip);
+			h.swap(tex, h.RequestedTopMip);
+			++DropCount;
+		}
+
+		// 足すものは、画面上で大きいものから1段ずつ読み込む
+		_sortBuf.Clear();
+		foreach (var h in _handles) {
+			if (h._pending != null || h.Texture == null || h.HasError) continue;
+			if (h.ResidentTopMip <= h.RequestedTopMip) continue;
+			_sortBuf.Add(h);
+		}
+		_sortBuf.Sort( (a, b) => b.ScreenSize.CompareTo(a.ScreenSize) );
+		for (int i=0; i<_sortBuf.Count && i<_maxLoadsPerFrame; ++i) {
+			var h = _sortBuf[i];
+			var top = h.ResidentTopMip - 1;
+			var tex = createTexture(h, top);
+			copyLevels(h.Texture, h.ResidentTopMip, tex, top, h.MipCount);
+			h._pending = new PendingLoad(h, tex, top, 1);
+			UsedBytes += h.bytesFor(top);
+			++LoadCount;
+		}
+
+		// 転送はプラグインのワーカースレッドで行われる場合があるので、読み込み中のものがあれば完了の取り込みを促す
+		var hasPending = 0 < s_closing.Count;
+		foreach (var h in _handles) hasPending |= h._pending != null;
+		if (hasPending) Plugin.CubemapBuilderPlugin.issuePollAsync();
+	}
+
+	/** 画面上の大きさから常駐させたい段を求め、予算を超える場合は画面上で小さいものから上位の段を落とす */
+	void updateRequestedTopMips() {
+		long total = 0;
+		foreach (var h in _handles) {
+			var needSize = h.ScreenSize * _resolutionScale;
+			var top = 0;
+			while (top < h._baseTop && needSize <= (h.Size >> (top+1))) ++top;
+			h.setRequestedTopMip(top);
+			total += h.bytesFor(top);
+		}
+		if (total <= BudgetBytes) return;
+
+		_sortBuf.Clear();
+		_sortBuf.AddRange(_handles);
+		_sortBuf.Sort( (a, b) => a.ScreenSize.CompareTo(b.ScreenSize) );
+		foreach (var h in _sortBuf) {
+			while (BudgetBytes < total && h.RequestedTopMip < h._baseTop) {
+				total -= h.bytesFor(h.RequestedTopMip) - h.bytesFor(h.RequestedTopMip + 1);
+				h.setRequestedTopMip(h.RequestedTopMip + 1);
+			}
+			if (total <= BudgetBytes) break;
+		}
+	}
+
+	/** ファイル上のtop段以降を持つキューブマップを作成する */
+	static Cubemap createTexture(Handle h, int top) {
+		var mipCount = h.MipCount - top;
+		return new Cubemap(
+			Math.Max(1, h.Size >> top), h._format,
+			1 < mipCount ? TextureCreationFlags.MipChain : TextureCreationFlags.None,
+			mipCount
+		) { name = "CubemapOnTheFly.CubemapStreamer" };
+	}
+
+	/** ファイル上の段を基準に、共通する段をGPU上でコピーする */
+	static void copyLevels(Texture src, int srcTop, Texture dst, int dstTop, int mipCount) {
+		for (int level=Math.Max(srcTop, dstTop); level<mipCount; ++level)
+		for (int face=0; face<6; ++face)
+			Graphics.CopyTexture( src, face, level - srcTop, dst, face, level - dstTop );
+	}
+
+	void closeCore(Handle h) {
+		destroyTexture(h.Texture);
+		if (h._pending != null) {
+			UsedBytes -= h.bytesFor(h._pending.top);
+			s_closing.Add(h);
+		} else {
+			h.freeNativeStrings();
+		}
+	}
+
+	static void collectClosing() {
+		for (int i=s_closing.Count-1; 0<=i; --i) {
+			var h = s_closing[i];
+			if (h._pending.poll() == 0) continue;
+
+			destroyTexture(h._pending.texture);
+			h._pending = null;
+			h.freeNativeStrings();
+			s_closing.RemoveAt(i);
+		}
+	}
+
+	static void destroyTexture(Texture tex) {
+		if (tex == null) return;
+		if (Application.isPlaying) UnityEngine.Object.Destroy(tex);
+		else UnityEngine.Object.DestroyImmediate(tex);
+	}
+
+	void OnDestroy() {
+		clear();
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
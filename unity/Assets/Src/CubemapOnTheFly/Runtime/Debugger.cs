@@ -27,7 +27,7 @@ public sealed class Debugger : MonoBehaviour {
 	void OnEnable() {
 		// 現在設定されているテクスチャを開放
 		var lastTex = _meshRenderer4check.material.mainTexture;
-		if (lastTex != null) DestroyImmediate(lastTex);
+		if (lastTex != null) _manager.recycle(lastTex);
 		_meshRenderer4check.material.mainTexture = null;
 
 		// Cubemapテクスチャを再生成
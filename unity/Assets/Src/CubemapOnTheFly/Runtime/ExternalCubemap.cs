@@ -0,0 +1,199 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+using UnityEngine;
+using UnityEngine.Rendering;
+using UnityEngine.Experimental.Rendering;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * プラグインで作成した、変更不可なストレージを持つキューブマップ。
+ * GLでは glTexStorage2D、D3D11/12ではミップ段数固定のリソースとして作成し、
+ * Cubemap.CreateExternalTexture でUnity側のテクスチャとして扱えるようにする。
+ * new Cubemap と違いUnity側でのストレージ確保を伴わず、createAsync を使えばレンダースレッドで作成できる。
+ *
+ * ここで作成したものは Object.Destroy ではネイティブ側のテクスチャが解放されないので、destroy で破棄すること
+ */
+public static class ExternalCubemap {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** 作成要求。レンダースレッドでの作成完了後に Result が有効になる */
+	public sealed class Request : IDisposable {
+
+		/** 作成処理が終わったか否か(失敗した場合も含む) */
+		public bool IsDone { get { poll(); return _state != 0; } }
+		/** 作成に失敗したか否か */
+		public bool HasError { get { poll(); return _state < 0; } }
+		/** 作成したキューブマップ。完了前や失敗時はnull */
+		public Cubemap Result { get { poll(); return _result; } }
+
+		/**
+		 * 要求を破棄する。作成済みのキューブマップも破棄するので、
+		 * 結果を使い続ける場合は Dispose せずに、後で ExternalCubemap.destroy で破棄すること
+		 */
+		public void Dispose() {
+			if (_data != IntPtr.Zero) {
+				// レンダースレッドでの処理が終わるまでは要求データを解放できないので、後で回収する
+				s_abandoned.Add(this);
+				return;
+			}
+			if (_result != null) destroyCore(_result);
+			_result = null;
+		}
+
+		internal Request(int size, int mipCount, Plugin.PixelFormat format) {
+			_size = size;
+			_mipChain = 1 < mipCount;
+			_format = format;
+
+			var data = new RequestData{ size = size, mipCount = mipCount, format = (int)format };
+			_data = Marshal.AllocHGlobal(Marshal.SizeOf<RequestData>());
+			Marshal.StructureToPtr(data, _data, false);
+
+			var cmd = new CommandBuffer{ name = "CubemapOnTheFly.ExternalCubemap" };
+			cmd.IssuePluginEventAndData(
+				Plugin.CubemapBuilderPlugin.getRenderEventAndDataFunc(),
+				(int)Plugin.CubemapBuilderPlugin.RenderEventId.CreateCubemap,
+				_data
+			);
+			Graphics.ExecuteCommandBuffer(cmd);
+			cmd.Release();
+		}
+
+		/** レンダースレッドでの処理が終わっていれば、結果を取り込む。終わったらtrue */
+		internal bool poll() {
+			if (_data == IntPtr.Zero) return true;
+
+			var state = Marshal.ReadInt32(_data, s_stateOffset);
+			if (state == 0) return false;
+
+			// stateが更新されていれば、resultは書き込み済み
+			Thread.MemoryBarrier();
+			var nativeTex = Marshal.ReadIntPtr(_data, s_resultOffset);
+			Marshal.FreeHGlobal(_data);
+			_data = IntPtr.Zero;
+
+			_state = state;
+			if (0 < state) _result = wrap(nativeTex, _size, _mipChain, _format);
+			return true;
+		}
+
+		readonly int _size;
+		readonly bool _mipChain;
+		readonly Plugin.PixelFormat _format;
+		IntPtr _data;
+		int _state;
+		Cubemap _result;
+	}
+
+
+	/** 指定の形式で作成可能か否か */
+	public static bool isSupported(GraphicsFormat format) =>
+		Plugin.PixelFormatUtil.fromGraphicsFormat(format) != Plugin.PixelFormat.Unsupported;
+
+	/**
+	 * 即座に作成する。グラフィックスAPIを呼び出し元のスレッドで直接呼ぶので、
+	 * マルチスレッドレンダリングが有効な場合は createAsync を使うこと。
+	 * mipChainがtrueの場合は全ミップ段を持つ。未対応・失敗時はnull
+	 */
+	public static Cubemap create(int size, GraphicsFormat format, bool mipChain) {
+		var pf = toPixelFormat(size, format);
+		var mipCount = mipChain ? calcMipCount(size) : 1;
+		var nativeTex = Plugin.CubemapBuilderPlugin.createCubemap(size, mipCount, pf);
+		return nativeTex == IntPtr.Zero ? null : wrap(nativeTex, size, mipChain, pf);
+	}
+
+	/**
+	 * レンダースレッドで作成する。メインスレッドは作成完了を待たずに戻る。
+	 * 作成完了は返り値の IsDone で確認すること
+	 */
+	public static Request createAsync(int size, GraphicsFormat format, bool mipChain) {
+		collectAbandoned();
+		var pf = toPixelFormat(size, format);
+		return new Request(size, mipChain ? calcMipCount(size) : 1, pf);
+	}
+
+	/** create / createAsync で作成したキューブマップを破棄する。ネイティブ側の解放はレンダースレッドで行う */
+	public static void destroy(Cubemap cubemap) {
+		collectAbandoned();
+		destroyCore(cubemap);
+	}
+
+	/** 指定のキューブマップが、ここで作成したものか否か */
+	public static bool isExternal(Texture tex) => tex is Cubemap c && s_nativeTexs.ContainsKey(c);
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	static void destroyCore(Cubemap cubemap) {
+		if (cubemap == null) return;
+		if (!s_nativeTexs.TryGetValue(cubemap, out var nativeTex))
+			throw new ArgumentException("cubemap is not created by ExternalCubemap");
+		s_nativeTexs.Remove(cubemap);
+
+		if (Application.isPlaying) UnityEngine.Object.Destroy(cubemap);
+		else UnityEngine.Object.DestroyImmediate(cubemap);
+
+		var cmd = new CommandBuffer{ name = "CubemapOnTheFly.ExternalCubemap" };
+		cmd.IssuePluginEventAndData(
+			Plugin.CubemapBuilderPlugin.getRenderEventAndDataFunc(),
+			(int)Plugin.CubemapBuilderPlugin.RenderEventId.DestroyCubemap,
+			nativeTex
+		);
+		Graphics.ExecuteCommandBuffer(cmd);
+		cmd.Release();
+	}
+
+	/** レンダースレッドへの作成要求。Native側の CubemapCreateRequest と同じレイアウト */
+	[StructLayout(LayoutKind.Sequential)]
+	struct RequestData {
+		public int size;
+		public int mipCount;
+		public int format;
+		public int state;			//!< 0:未処理 1:成功 -1:失敗
+		public IntPtr result;
+	}
+	static readonly int s_stateOffset = (int)Marshal.OffsetOf<RequestData>("state");
+	static readonly int s_resultOffset = (int)Marshal.OffsetOf<RequestData>("result");
+
+	/** 作成したキューブマップと、対応するネイティブテクスチャ */
+	static readonly Dictionary<Cubemap, IntPtr> s_nativeTexs = new Dictionary<Cubemap, IntPtr>();
+	/** 完了前にDisposeされた要求。完了したものから破棄する */
+	static readonly List<Request> s_abandoned = new List<Request>();
+
+	static Plugin.PixelFormat toPixelFormat(int size, GraphicsFormat format) {
+		if (size <= 0) throw new ArgumentOutOfRangeException("size");
+		var ret = Plugin.PixelFormatUtil.fromGraphicsFormat(format);
+		if (ret == Plugin.PixelFormat.Unsupported) throw new ArgumentException("unsupported format:" + format);
+		return ret;
+	}
+
+	static int calcMipCount(int size) {
+		int ret = 1;
+		while (1 < size) { size >>= 1; ++ret; }
+		return ret;
+	}
+
+	static Cubemap wrap(IntPtr nativeTex, int size, bool mipChain, Plugin.PixelFormat format) {
+		var ret = Cubemap.CreateExternalTexture(size, format.toTextureFormat(), mipChain, nativeTex);
+		s_nativeTexs.Add(ret, nativeTex);
+		return ret;
+	}
+
+	static void collectAbandoned() {
+		for (int i=s_abandoned.Count-1; 0<=i; --i) {
+			if (!s_abandoned[i].poll()) continue;
+			var req = s_abandoned[i];
+			s_abandoned.RemoveAt(i);
+			req.Dispose();
+		}
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
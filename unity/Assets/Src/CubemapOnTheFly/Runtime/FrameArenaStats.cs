@@ -0,0 +1,34 @@
+using System;
+using UnityEngine;
+using System.Runtime.InteropServices;
+
+
+namespace CubemapOnTheFly {
+
+	/**
+	 * プラグインのCPU処理用一時バッファ(フレーム単位のバンプアロケータ)の使用状況。
+	 * Native側の FrameArenaStats と同じレイアウト
+	 */
+	[StructLayout(LayoutKind.Sequential)]
+	public struct FrameArenaStats {
+		public ulong usedBytes;				//!< 現在のフレームで確保済みのバイト数
+		public ulong peakBytes;				//!< 1フレームでの確保量の最大値
+		public ulong capacityBytes;			//!< OSから確保しているブロックの合計バイト数
+		public ulong hugePageBytes;			//!< capacityBytesのうち、ヒュージページで確保できたバイト数
+		public ulong systemAllocCount;		//!< OSからブロックを確保した回数の累計。定常状態では増えない
+		public ulong frameCount;			//!< フレーム境界での巻き戻しを行った回数の累計
+		public ulong deferredResetCount;	//!< 処理中だったために巻き戻しを遅らせた回数の累計
+		public int blockCount;				//!< 現在保持しているブロック数
+		public int activeScopeCount;		//!< 現在処理中の呼び出し数
+
+		/** 現在の状態を取得する。取得できなかった場合はnull */
+		public static FrameArenaStats? capture() {
+			return Plugin.CubemapBuilderPlugin.getFrameArenaStats(out var ret) ? ret : (FrameArenaStats?)null;
+		}
+
+		public override string ToString() =>
+			$"used:{usedBytes} peak:{peakBytes} capacity:{capacityBytes} (huge page:{hugePageBytes}) "
+			+ $"blocks:{blockCount} sysAlloc:{systemAllocCount} frames:{frameCount} deferred:{deferredResetCount}";
+	}
+
+}
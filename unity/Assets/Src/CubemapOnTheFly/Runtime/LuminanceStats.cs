@@ -0,0 +1,38 @@
+using System;
+using UnityEngine;
+using System.Runtime.InteropServices;
+
+
+namespace CubemapOnTheFly {
+
+	/**
+	 * キューブマップの輝度統計。Native側の CubemapLuminanceStats と同じレイアウト。
+	 * 輝度はRGBを0~1とした値から Rec.709 の係数で求めたもの
+	 */
+	[StructLayout(LayoutKind.Sequential)]
+	public struct LuminanceStats {
+
+		/** ヒストグラムのビン数 */
+		public const int HistogramBinCount = 64;
+
+		public float minLuminance;			//!< 最小輝度
+		public float maxLuminance;			//!< 最大輝度
+		public float averageLuminance;		//!< 立体角で重み付けした平均輝度
+		public float logAverageLuminance;	//!< 立体角で重み付けした対数平均輝度(exp2(平均log2輝度))
+		public float minLog2Luminance;		//!< ヒストグラムの範囲の下限(log2輝度)
+		public float maxLog2Luminance;		//!< ヒストグラムの範囲の上限(log2輝度)
+
+		/**
+		 * log2輝度を [minLog2Luminance, maxLog2Luminance] で等分した各ビンの、立体角の割合。
+		 * 範囲外の輝度は両端のビンに入る。合計は1
+		 */
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = HistogramBinCount)]
+		public float[] histogram;
+
+		/** ビン番号に対応するlog2輝度の範囲の中央値を返す */
+		public float binCenterLog2Luminance(int bin) {
+			return minLog2Luminance + (maxLog2Luminance - minLog2Luminance) * (bin + 0.5f) / HistogramBinCount;
+		}
+	}
+
+}
@@ -5,6 +5,7 @@ using Unity.Mathematics;
 using static Unity.Mathematics.math;
 using System.Collections.Generic;
 using Unity.Collections;
+using UnityEngine.Experimental.Rendering;
 
 
 namespace CubemapOnTheFly {
@@ -31,6 +32,23 @@ public sealed class Manager : MonoBehaviour {
 	/** 1処理ステップあたり何枚レンダリングを行うか */
 	[SerializeField][Range(1,7)] int _renderCntPerSteps = 1;
 
+	[Space]
+
+	/**
+	 * この距離(m)以内に、同サイズ・同じカメラのカリングマスクで生成済みのキューブマップがある場合は、
+	 * レンダリングせずにそれを再利用する。0の場合は再利用しない
+	 */
+	[SerializeField][Min(0)] float _reuseDistance = 0;
+	/** 再利用する生成済みキューブマップの最大経過時間(秒)。0の場合は経過時間を問わない */
+	[SerializeField][Min(0)] float _reuseMaxAge = 0;
+
+	[Space]
+
+	/** 生成完了ごとに、プラグインの処理にかかったGPU時間をログに出力するか否か */
+	[SerializeField] bool _logPluginGpuTime = false;
+	/** 毎フレーム、プラグインの計測結果を PluginStatsPerFrame に取得するか否か */
+	[SerializeField] bool _samplePluginStats = false;
+
 
 	[Space]
 
@@ -40,42 +58,179 @@ public sealed class Manager : MonoBehaviour {
 	/** レンダリング方法 */
 	public RenderingMode renderingMode = RenderingMode.DirectRT;
 
+	/**
+	 * 生成結果のディスクキャッシュ。nullの場合は使用しない。
+	 * 指定されている場合は、同じキーの生成結果があればレンダリングせずにそれを返し、
+	 * 無ければ生成完了時に保存する
+	 */
+	public CubemapDiskCache diskCache = null;
+
+	/** ディスクキャッシュのキーに含めるシーン内容のハッシュ。シーンの内容が変わったら変更すること */
+	public Hash128 sceneHash;
+
+	/** 再利用判定を行ったリクエスト数 */
+	public int ReuseRequestCount {get; private set;}
+	/** 生成済みのキューブマップを再利用したリクエスト数 */
+	public int ReusedCount {get; private set;}
+	/** 再利用率 */
+	public float ReuseRate => ReuseRequestCount == 0 ? 0 : (float)ReusedCount / ReuseRequestCount;
+
+	/**
+	 * 直近に完了した生成で、プラグインのBlitにかかったGPU時間(ms)。
+	 * 同じサイズの直近の計測値なので、毎フレームの処理量の調整などの目安に使用する。
+	 * プラグインを使用しないレンダリング方法や、GPU時間を計測できない環境では0
+	 */
+	public float LastBuildPluginGpuMs {get; private set;}
+
+	/**
+	 * フレームごとのプラグインの計測結果。インスペクタで有効にした場合のみ、毎フレームの処理ステップの前に取得する。
+	 * 直前のフレームからの呼び出し回数や転送量を、デバッグ表示などで参照するために使用する
+	 */
+	public PluginStatsSampler PluginStatsPerFrame {get;} = new PluginStatsSampler();
+
+	/** 再利用の統計をリセットする */
+	public void resetReuseStats() {
+		ReuseRequestCount = ReusedCount = 0;
+	}
+
 
-	/** 指定のパラメータでキューブマップ生成を開始する */
+	/**
+	 * 指定のパラメータでキューブマップ生成を開始する。
+	 * 再利用により即完了した場合は、この呼び出し中に onComplete が呼ばれる。
+	 * ディスクキャッシュにある場合はレンダースレッドでファイルから読み込み、転送の完了後のフレームで呼ばれる。
+	 * 読み込みに失敗した場合は、そこからレンダリングを行う。
+	 * レンダリングした場合は、GPU上での処理の完了をフェンスで確認してから onComplete が呼ばれるので、
+	 * 渡されたテクスチャはそのまま読み戻しなどに使用してもストールしない。
+	 * 再利用された場合は他のリクエストと同じキューブマップが渡されるので、破棄する際は注意すること。
+	 *
+	 * destinationを指定した場合は、新しいテクスチャを確保せずにそこへ結果を書き込み、
+	 * onCompleteにもdestinationがそのまま渡される。プローブの更新などで毎回の確保を避けたい場合に使用する。
+	 * destinationはtexSizeと同じ大きさのキューブマップ・キューブのRT・キューブマップ配列のいずれかで、
+	 * キューブマップ配列の場合はdestinationSliceで書き込むキューブマップを指定する。
+	 * 形式は生成結果(ARGB32)と同じビット数の非圧縮形式に限る。
+	 * renderingModeがBlitNoUsePluginの場合、キューブマップ・キューブマップ配列は読み込み可能(isReadable)である必要がある。
+	 * 書き込まれるのはミップ0のみなので、ミップが必要な場合は完了後に使用する側で生成すること
+	 */
 	public IDisposable beginRender(
 		int texSize, float3 pos,
 		Action<Texture> onComplete,
 		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onBeginRenderPerFrame = null,
-		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onEndRenderPerFrame = null
+		Action<Camera, UnityEngine.Rendering.ScriptableRenderContext> onEndRenderPerFrame = null,
+		Texture destination = null,
+		int destinationSlice = 0
 	) {
-		var plan = new Core.BuilderPlan(
+		if (destination != null) {
+			var dim = destination.dimension;
+			if (dim != UnityEngine.Rendering.TextureDimension.Cube && dim != UnityEngine.Rendering.TextureDimension.CubeArray)
+				throw new ArgumentException("destination is not cube texture");
+			if (destination.width != texSize) throw new ArgumentException("destination size mismatch");
+			var sliceCnt = destination is CubemapArray ca ? ca.cubemapCount
+				: destination is RenderTexture rt && rt.dimension == UnityEngine.Rendering.TextureDimension.CubeArray ? rt.volumeDepth / 6
+				: 1;
+			if (destinationSlice < 0 || sliceCnt <= destinationSlice) throw new ArgumentOutOfRangeException("destinationSlice");
+
+			// 生成結果は Graphics.CopyTexture や SetPixelData でそのままコピーするので、同じビット数の非圧縮形式に限る
+			var format = destination.graphicsFormat;
+			if (
+				GraphicsFormatUtility.IsCompressedFormat(format) ||
+				GraphicsFormatUtility.GetBlockSize(format) != GraphicsFormatUtility.GetBlockSize(ResultFormat)
+			) throw new ArgumentException("destination format is not compatible with " + ResultFormat);
+
+			// CPUで読み戻す方式は、キューブマップ・キューブマップ配列へ SetPixelData で書き込むので、読み込み可能である必要がある
+			if (renderingMode == RenderingMode.BlitNoUsePlugin && !(destination is RenderTexture) && !destination.isReadable)
+				throw new ArgumentException("destination is not readable");
+		}
+
+		// 近くに生成済みのものがあれば、レンダリングせずに即完了とする。
+		// 出力先が指定されている場合は、出力先へコピーして完了とする
+		var layerMask = _camera.cullingMask;
+		if (0 < _reuseDistance) {
+			// セルの大きさは再利用距離に合わせる
+			if (_captureIndex.CellSize != _reuseDistance) _captureIndex.rebuild(_reuseDistance);
+
+			++ReuseRequestCount;
+			if (_captureIndex.tryFind(
+				pos, texSize, layerMask,
+				_reuseDistance, _reuseMaxAge, Time.realtimeSinceStartup,
+				out var reused
+			)) {
+				++ReusedCount;
+				if (destination != null) {
+					copyToDestination(reused, destination, destinationSlice);
+					reused = destination;
+				}
+				onComplete?.Invoke(reused);
+				return new CancelHandler(null);
+			}
+
+			// 生成完了時に、再利用できるように登録する。
+			// 出力先が指定されたものは使用する側で上書きされていくので、登録しない
+			if (destination == null) {
+				var onCompleteOrg = onComplete;
+				onComplete = cubemap => {
+					if (cubemap != null) registerCapture(pos, texSize, layerMask, cubemap);
+					onCompleteOrg?.Invoke(cubemap);
+				};
+			}
+		}
+
+		// ディスクキャッシュへの保存はキューブマップ単体のみ対応なので、配列へ書き込む場合は保存しない
+		var cacheKey = diskCache != null ? new CubemapDiskCache.Key( pos, texSize, ResultFormat, sceneHash ) : default;
+		var storeCache = destination != null && destination.dimension == UnityEngine.Rendering.TextureDimension.CubeArray ? null : diskCache;
+
+		Func<Core.BuilderPlan> createPlan = () => new Core.BuilderPlan(
 			_camera, texSize, pos,
 			onComplete,
 			onBeginRenderPerFrame,
 			onEndRenderPerFrame,
 			_blitShader,
-			renderingMode
+			renderingMode,
+			destination,
+			destinationSlice,
+			storeCache,
+			cacheKey
 		);
-		_builderPlans.AddLast( plan );
 
-		// 現在処理中のタスクがない場合は、即実行
-		if (_curBldPlan == null) {
-			_curBldPlan = _builderPlans.First.Value;
-			_builderPlans.RemoveFirst();
+		// ディスクキャッシュにあれば、レンダリングせずにレンダースレッドでファイルから読み込む
+		var cacheLoad = diskCache?.beginLoad(cacheKey);
+		if (cacheLoad != null) {
+			var loading = new CacheLoading(cacheLoad, onComplete, destination, destinationSlice, createPlan);
+			_cacheLoadings.Add(loading);
+			Plugin.CubemapBuilderPlugin.issuePollAsync();
+
+			// 読み込みに失敗してレンダリングに切り替えた後は、そちらをキャンセルする
+			return new CancelHandler(() => {
+				if (loading.fallbackPlan != null) {
+					cancelPlan(loading.fallbackPlan);
+				} else if (_cacheLoadings.Remove(loading)) {
+					loading.load.cancel();
+				}
+			});
 		}
 
+		var plan = createPlan();
+		schedulePlan(plan);
+
 		// 途中キャンセル用のハンドルを返す
-		return new CancelHandler(() => {
-			if (_curBldPlan == plan) {
-				_curBldPlan.Dispose();
-				_curBldPlan = null;
-			} else if (_builderPlans.Contains(plan)) {
-				_builderPlans.Remove(plan);
-				plan.Dispose();
-			}
-		});
+		return new CancelHandler(() => cancelPlan(plan));
+	}
+
+	/**
+	 * 生成結果のキューブマップが不要になったときに呼ぶ。
+	 * 共有のRenderTextureプールから確保したものはプールへ返し、次回以降の生成で使いまわす。
+	 * それ以外のものは破棄する。
+	 * プールへ返したものは他の生成で上書きされるので、再利用の対象やキャッシュからも取り除く
+	 */
+	public void recycle(Texture cubemap) {
+		if (cubemap is null) return;
+		_captureIndex.remove(cubemap);
+		onRecycling?.Invoke(cubemap);
+		Core.RenderTexturePool.giveBackOrDestroy(cubemap);
 	}
 
+	/** recycle でキューブマップをプールへ返す・破棄する直前に呼ばれる。キャッシュが参照を外すために使用する */
+	public event Action<Texture> onRecycling;
+
 	/** 現在発行中のビルドを全キャンセルする */
 	public void cancelAll() {
 		// 現在実行中のレンダリングは予約されているものも含めて全てキャンセルして、
@@ -84,11 +239,43 @@ public sealed class Manager : MonoBehaviour {
 		_curBldPlan = null;
 		foreach (var i in _builderPlans) i.Dispose();
 		_builderPlans.Clear();
+		foreach (var i in _completingPlans) i.Dispose();
+		_completingPlans.Clear();
+		foreach (var i in _cacheLoadings) i.load.cancel();
+		_cacheLoadings.Clear();
 	}
 
 
 	// --------------------------------- private / protected メンバ -------------------------------
 
+	/** 生成結果のキューブマップの形式。各Builderは既定の色空間のARGB32で生成する */
+	static GraphicsFormat ResultFormat =>
+		GraphicsFormatUtility.GetGraphicsFormat(RenderTextureFormat.ARGB32, RenderTextureReadWrite.Default);
+
+	/** ディスクキャッシュから読み込み中の1件分のデータ */
+	sealed class CacheLoading {
+		public readonly CubemapDiskCache.PendingLoad load;
+		public readonly Action<Texture> onComplete;
+		public readonly Texture destination;
+		public readonly int destinationSlice;
+		public readonly Func<Core.BuilderPlan> createPlan;	//!< 読み込みに失敗した場合に、レンダリングへ切り替えるためのもの
+		public Core.BuilderPlan fallbackPlan;				//!< 読み込みに失敗して切り替えたレンダリング
+
+		public CacheLoading(
+			CubemapDiskCache.PendingLoad load,
+			Action<Texture> onComplete,
+			Texture destination,
+			int destinationSlice,
+			Func<Core.BuilderPlan> createPlan
+		) {
+			this.load = load;
+			this.onComplete = onComplete;
+			this.destination = destination;
+			this.destinationSlice = destinationSlice;
+			this.createPlan = createPlan;
+		}
+	}
+
 	/** 発行したレンダリングをキャンセルするためのハンドル */
 	sealed class CancelHandler : IDisposable {
 		public CancelHandler(Action onDipose) { _onDipose = onDipose; }
@@ -100,8 +287,17 @@ public sealed class Manager : MonoBehaviour {
 	LinkedList<Core.BuilderPlan> _builderPlans = new LinkedList<Core.BuilderPlan>();
 
 	Core.BuilderPlan _curBldPlan;
+
+	/** レンダリングを発行し終えて、GPU上での完了を待っているもの */
+	List<Core.BuilderPlan> _completingPlans = new List<Core.BuilderPlan>();
+
+	/** ディスクキャッシュから読み込み中のもの */
+	List<CacheLoading> _cacheLoadings = new List<CacheLoading>();
 	Core.RenderFook _renderFook;
 
+	/** 再利用判定用の、生成済みキューブマップの空間インデックス */
+	Core.CaptureIndex _captureIndex = new Core.CaptureIndex(1);
+
 	// 処理ステップを進めるためのステップカウント
 	int _waitFrameCnt;
 
@@ -109,6 +305,43 @@ public sealed class Manager : MonoBehaviour {
 	// 二重呼び出しを回避するために、前回更新時のFrameCountを記憶しておく
 	int _lastTFCnt;
 
+	/** 生成済みのキューブマップの内容を、指定の出力先へ全面コピーする */
+	static void copyToDestination(Texture src, Texture dst, int dstSlice) {
+		var baseIdx = dst.dimension == UnityEngine.Rendering.TextureDimension.CubeArray ? dstSlice * 6 : 0;
+		var mipCnt = Mathf.Min(src.mipmapCount, dst.mipmapCount);
+		for (int i=0; i<6; ++i)
+		for (int mip=0; mip<mipCnt; ++mip)
+			Graphics.CopyTexture( src, i, mip, dst, baseIdx + i, mip );
+	}
+
+	/** レンダリングを予約する。現在処理中のタスクがない場合は、即実行 */
+	void schedulePlan(Core.BuilderPlan plan) {
+		_builderPlans.AddLast( plan );
+		if (_curBldPlan == null) {
+			_curBldPlan = _builderPlans.First.Value;
+			_builderPlans.RemoveFirst();
+		}
+	}
+
+	/** 予約・実行中・完了待ちのいずれかのレンダリングをキャンセルする */
+	void cancelPlan(Core.BuilderPlan plan) {
+		if (_curBldPlan == plan) {
+			_curBldPlan.Dispose();
+			_curBldPlan = null;
+		} else if (_builderPlans.Contains(plan)) {
+			_builderPlans.Remove(plan);
+			plan.Dispose();
+		} else if (_completingPlans.Remove(plan)) {
+			plan.Dispose();
+		}
+	}
+
+	/** 生成済みのキューブマップを再利用できるように登録する */
+	void registerCapture(float3 pos, int texSize, int layerMask, Texture cubemap) {
+		if (_captureIndex.CellSize != _reuseDistance) _captureIndex.rebuild(_reuseDistance);
+		_captureIndex.add(pos, texSize, layerMask, Time.realtimeSinceStartup, cubemap, _reuseMaxAge);
+	}
+
 	void OnEnable() {
 		_camera.enabled = false;
 
@@ -119,14 +352,31 @@ public sealed class Manager : MonoBehaviour {
 				if (_lastTFCnt == Time.frameCount) return;
 				_lastTFCnt = Time.frameCount;
 
+				// しばらく使われていないプール内のRTを解放する
+				Core.RenderTexturePool.trim();
+
+				// プラグインのCPU処理用の一時バッファを巻き戻す
+				Plugin.CubemapBuilderPlugin.resetFrameArena();
+
+				// プラグインの計測結果を、このフレームの分として取得する
+				if (_samplePluginStats) PluginStatsPerFrame.sample();
+
+				// GPU上での処理が完了したものの完了コールバックを呼ぶ。待たずに確認するだけ
+				pollCompletingPlans();
+				pollCacheLoadings();
+
 				// 処理を行うフレーム間隔が指定されている場合は、それだけ待つ
-				if (++_waitFrameCnt < _frameCntBetweenSteps) return;
+				if (++_waitFrameCnt < _frameCntBetweenSteps) {
+					if (0 < _completingPlans.Count || 0 < _cacheLoadings.Count) Plugin.CubemapBuilderPlugin.issuePollAsync();
+					return;
+				}
 				_waitFrameCnt = 0;
 				
 				// レンダリング可能数を全消費するまでレンダリングを進める
 				var remainRenderCnt = _renderCntPerSteps;
 				while ( _curBldPlan!=null && 0<remainRenderCnt ) {
 					if ( _curBldPlan.proceed(_camera, context, ref remainRenderCnt) ) {
+						if (!_curBldPlan.pollGPUComplete()) _completingPlans.Add(_curBldPlan);
 						if (_builderPlans.Count==0) {
 							_curBldPlan = null;
 						} else {
@@ -136,10 +386,73 @@ public sealed class Manager : MonoBehaviour {
 					}
 				}
 
+				// 完了待ちのものがあれば、次のフレームまでにフェンスや転送の完了を確認させておく
+				if (0 < _completingPlans.Count || 0 < _cacheLoadings.Count) Plugin.CubemapBuilderPlugin.issuePollAsync();
+
 			}, null
 		);
 	}
 
+	/** GPU上での処理が完了したものを取り除いて、完了コールバックを呼ぶ */
+	void pollCompletingPlans() {
+		for (int i=0; i<_completingPlans.Count;) {
+			var plan = _completingPlans[i];
+			if (plan.pollGPUComplete()) {
+				_completingPlans.RemoveAt(i);
+				updatePluginGpuTime(plan);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	/**
+	 * ディスクキャッシュからの読み込みが完了したものを取り除いて、完了コールバックを呼ぶ。
+	 * 読み込みに失敗したものは、レンダリングを予約する
+	 */
+	void pollCacheLoadings() {
+		CubemapDiskCache.collectCancelled();
+
+		for (int i=0; i<_cacheLoadings.Count;) {
+			var loading = _cacheLoadings[i];
+			var state = loading.load.poll();
+			if (state == 0) {
+				++i;
+				continue;
+			}
+			_cacheLoadings.RemoveAt(i);
+
+			if (state < 0) {
+				loading.fallbackPlan = loading.createPlan();
+				schedulePlan(loading.fallbackPlan);
+				continue;
+			}
+
+			Texture cached = loading.load.Texture;
+			if (loading.destination != null) {
+				copyToDestination(cached, loading.destination, loading.destinationSlice);
+				loading.load.destroyTexture();
+				cached = loading.destination;
+			}
+			loading.onComplete?.Invoke(cached);
+		}
+	}
+
+	/**
+	 * 完了した生成のプラグインのGPU時間を取得する。
+	 * フェンスの確認と同じタイミングでタイマークエリも読み戻されているので、完了時点で反映済みになっている
+	 */
+	void updatePluginGpuTime(Core.BuilderPlan plan) {
+		if (plan.RenderingMode != RenderingMode.BlitUsePlugin) return;
+		var stats = PluginStats.capture();
+		if (stats == null || stats.Value.isGpuTimerSupported == 0) return;
+
+		var t = stats.Value.getGpuTime(PluginStats.Op.BlitCubemap, plan.TexSize);
+		LastBuildPluginGpuMs = (float)t.LastMs;
+		if (_logPluginGpuTime)
+			Debug.Log($"CubemapOnTheFly : BlitCubemap {plan.TexSize}px GPU {t.LastMs:F3}ms (avg {t.AverageMs:F3}ms, max {t.MaxMs:F3}ms)");
+	}
+
 	void OnDisable() {
 		_renderFook.Dispose();
 		_renderFook = null;
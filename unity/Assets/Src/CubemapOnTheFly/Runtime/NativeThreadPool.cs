@@ -0,0 +1,32 @@
+using System;
+using UnityEngine;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * プラグインがCPU側の処理(変換・回転・ブラー・輝度統計などのCPU版)に使用するワーカースレッドのプール。
+ * 各ワーカーは自分の処理が無くなると他のワーカーの処理を盗んで実行するので、コア数の多い環境でも偏りなく分散される。
+ * 設定しない場合は 論理コア数 - 1 個のワーカーを、コアへ固定せずに使用する
+ */
+public static class NativeThreadPool {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** 並列に実行できるスレッド数(ワーカー数 + 呼び出し元スレッド) */
+	public static int ThreadCount => Plugin.CubemapBuilderPlugin.getThreadPoolThreadCount();
+
+	/**
+	 * ワーカースレッド数と、各ワーカーを論理コアへ固定するか否かを設定する。
+	 * workerCountが0以下の場合は 論理コア数 - 1。
+	 * ベイク用のサーバーなど、他の処理とコアを取り合わない環境ではpinThreadsを有効にするとキャッシュの局所性が上がる。
+	 * CPU処理の実行中は何も変更せずにfalseを返すので、その場合は完了後に再度呼ぶこと
+	 */
+	public static bool configure(int workerCount = 0, bool pinThreads = false) {
+		return Plugin.CubemapBuilderPlugin.configureThreadPool(workerCount, pinThreads);
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}
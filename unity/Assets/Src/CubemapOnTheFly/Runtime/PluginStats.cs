@@ -0,0 +1,160 @@
+using System;
+using UnityEngine;
+using System.Runtime.InteropServices;
+
+
+namespace CubemapOnTheFly {
+
+	/** プラグインの1つの処理・サイズ区分のGPU時間。Native側の PluginGpuTimeStats と同じレイアウト */
+	[StructLayout(LayoutKind.Sequential)]
+	public struct PluginGpuTimeStats {
+		public ulong count;			//!< 計測できた回数
+		public ulong totalNs;		//!< 合計時間
+		public ulong maxNs;			//!< 最大時間
+		public ulong lastNs;		//!< 直近の時間
+
+		public double AverageMs => count == 0 ? 0 : totalNs / (double)count / 1e6;
+		public double MaxMs => maxNs / 1e6;
+		public double LastMs => lastNs / 1e6;
+
+		public override string ToString() =>
+			$"count:{count} avg:{AverageMs:F3}ms max:{MaxMs:F3}ms last:{LastMs:F3}ms";
+	}
+
+	/** プラグインの1つの関数の呼び出しの集計。Native側の PluginCallStats と同じレイアウト */
+	[StructLayout(LayoutKind.Sequential)]
+	public struct PluginCallStats {
+		public ulong count;				//!< 呼び出し回数
+		public ulong failureCount;		//!< 失敗を返した回数
+		public ulong totalNs;			//!< CPU時間の合計
+		public ulong maxNs;				//!< CPU時間の最大
+		public ulong p50Ns;				//!< CPU時間のパーセンタイル。ヒストグラムの区分の上端なので、約3%大きめになる
+		public ulong p99Ns;
+		public ulong p999Ns;
+
+		public double AverageMs => count == 0 ? 0 : totalNs / (double)count / 1e6;
+		public double MaxMs => maxNs / 1e6;
+		public double P50Ms => p50Ns / 1e6;
+		public double P99Ms => p99Ns / 1e6;
+		public double P999Ms => p999Ns / 1e6;
+
+		public override string ToString() =>
+			$"count:{count} fail:{failureCount} avg:{AverageMs:F3}ms p50:{P50Ms:F3}ms p99:{P99Ms:F3}ms p999:{P999Ms:F3}ms max:{MaxMs:F3}ms";
+	}
+
+	/**
+	 * プラグインの各処理の計測結果。Native側の PluginStats と同じレイアウト。
+	 * GPU時間はタイマークエリを待たずに読み戻すので、数フレーム遅れて反映される。
+	 * 呼び出し回数・CPU時間・転送量は、取得時点での全スレッドの合計
+	 */
+	[StructLayout(LayoutKind.Sequential)]
+	public struct PluginStats {
+		/** 計測対象のプラグインの処理。Native側の PluginOp と同じ並び */
+		public enum Op {
+			BlitCubemap,
+			ConvertCubemapToProjection,
+			ConvertProjectionToCubemap,
+			RotateCubemap,
+			FixupCubemapSeams,
+			BlurCubemap,
+			ComputeLuminanceStats,
+			UploadCubemapLevel,
+		}
+		public const int OpCount = 8;
+		/** 呼び出し回数・CPU時間を計測するプラグインの関数。Native側の PluginCall と同じ並び */
+		public enum Call {
+			BlitCubemap,					//!< EnqueueBlitCubemap で追加したコマンドの実行も含む
+			EnqueueBlitCubemap,
+			ConvertCubemapToProjection,
+			ConvertProjectionToCubemap,
+			ConvertCubemapToProjectionCPU,
+			ConvertProjectionToCubemapCPU,
+			RotateCubemap,
+			RotateCubemapCPU,
+			FixupCubemapSeams,
+			FixupCubemapSeamsCPU,
+			BlurCubemap,
+			BlurCubemapCPU,
+			ComputeLuminanceStats,
+			GetLuminanceStats,
+			ComputeLuminanceStatsCPU,
+			WriteKTX2Cubemap,
+			LoadKTX2CubemapLevels,
+			CreateCubemap,
+			DestroyCubemap,
+			CreateCubemapFaceViews,
+			DestroyTextureView,
+			RenderEvent,
+			PublishCubemapFacesToSharedRing,
+			GetKTX2CubemapInfo,
+			CreateSharedFaceRing,
+			DestroySharedFaceRing,
+		}
+		public const int CallCount = 26;
+		/** 処理するテクスチャの一辺ごとの区分数。32以下, 64, 128, ... , 4096以上 */
+		public const int SizeBucketCount = 8;
+
+		public int structSize;					//!< 取得時に書き込まれた大きさ
+		public int opCount;
+		public int sizeBucketCount;
+		public int isGpuTimerSupported;			//!< 現在のグラフィックスAPIでGPU時間を計測できるか否か
+		public ulong gpuTimerDroppedCount;		//!< 計測待ちのクエリが溢れて、計測できなかった回数
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = OpCount * SizeBucketCount)]
+		public PluginGpuTimeStats[] gpuTime;	//!< [op * SizeBucketCount + sizeBucket]
+		public int callCount;
+		public int threadCount;					//!< 計測値を持っている生存中のスレッド数
+		public ulong bytesMoved;				//!< GPUへの転送・GPU上のコピー・読み戻し・共有メモリへの書き込みのバイト数
+		public ulong fboValidationCount;		//!< フレームバッファの完全性を確認した回数
+		public ulong fboValidationFailureCount;	//!< フレームバッファが不完全で、コピーを行えなかった回数
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = CallCount)]
+		public PluginCallStats[] calls;
+
+		/** 現在の状態を取得する。取得できなかった場合はnull */
+		public static PluginStats? capture() {
+			return Plugin.CubemapBuilderPlugin.getPluginStats(out var ret) ? ret : (PluginStats?)null;
+		}
+
+		/** テクスチャの一辺から、サイズ区分を返す */
+		public static int sizeBucket(int size) {
+			int bucket = 0;
+			for (int s=32; s<size && bucket<SizeBucketCount-1; s<<=1) ++bucket;
+			return bucket;
+		}
+
+		/** 指定の処理・テクスチャサイズのGPU時間 */
+		public PluginGpuTimeStats getGpuTime(Op op, int size) =>
+			gpuTime[(int)op * SizeBucketCount + sizeBucket(size)];
+
+		/** 指定の処理の、全サイズ区分を合わせたGPU時間 */
+		public PluginGpuTimeStats getGpuTimeTotal(Op op) {
+			var ret = new PluginGpuTimeStats();
+			for (int i=0; i<SizeBucketCount; ++i) {
+				var t = gpuTime[(int)op * SizeBucketCount + i];
+				if (t.count == 0) continue;
+				ret.count += t.count;
+				ret.totalNs += t.totalNs;
+				ret.maxNs = Math.Max(ret.maxNs, t.maxNs);
+				ret.lastNs = t.lastNs;
+			}
+			return ret;
+		}
+
+		/** 指定の関数の呼び出しの集計 */
+		public PluginCallStats getCall(Call call) => calls[(int)call];
+
+		public override string ToString() {
+			var sb = new System.Text.StringBuilder();
+			sb.Append($"gpuTimer:{(isGpuTimerSupported != 0 ? "on" : "off")} dropped:{gpuTimerDroppedCount}");
+			sb.Append($"\nbytesMoved:{bytesMoved} fbo:{fboValidationCount} fboFailure:{fboValidationFailureCount} threads:{threadCount}");
+			for (int i=0; i<CallCount; ++i)
+				if (calls[i].count != 0) sb.Append($"\n{(Call)i} : {calls[i]}");
+			for (int op=0; op<OpCount; ++op)
+			for (int i=0; i<SizeBucketCount; ++i) {
+				var t = gpuTime[op * SizeBucketCount + i];
+				if (t.count != 0) sb.Append($"\n{(Op)op} size<={32 << i} : {t}");
+			}
+			return sb.ToString();
+		}
+	}
+
+}
@@ -0,0 +1,62 @@
+using System;
+using UnityEngine;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * プラグインの計測結果をフレームごとに取得して、直前のフレームからの差分を求めるもの。
+ * 毎フレーム1回 sample を呼ぶこと。同じフレーム内で複数回呼んでも、取得は最初の1回のみ行う。
+ * 途中で計測結果がリセットされた場合は、そのフレームの差分はリセット後の値になる
+ */
+public sealed class PluginStatsSampler {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** 直近に取得した計測結果。未取得・取得できなかった場合はnull */
+	public PluginStats? Current {get; private set;}
+	/** Current の1つ前に取得した計測結果 */
+	public PluginStats? Previous {get; private set;}
+	/** Current を取得したフレーム */
+	public int SampledFrame {get; private set;} = -1;
+
+	/** 現在のフレームの計測結果を取得する。取得できた場合はtrue */
+	public bool sample() {
+		if (SampledFrame == Time.frameCount) return Current != null;
+		SampledFrame = Time.frameCount;
+
+		Previous = Current;
+		Current = PluginStats.capture();
+		return Current != null;
+	}
+
+	/** 直前のフレームからの、指定の関数の呼び出し回数 */
+	public ulong getCallCountDelta(PluginStats.Call call) =>
+		delta(s => s.getCall(call).count);
+
+	/** 直前のフレームからの、指定の関数の失敗回数 */
+	public ulong getCallFailureDelta(PluginStats.Call call) =>
+		delta(s => s.getCall(call).failureCount);
+
+	/** 直前のフレームからの、指定の関数のCPU時間の合計(ms) */
+	public double getCallCpuMsDelta(PluginStats.Call call) =>
+		delta(s => s.getCall(call).totalNs) / 1e6;
+
+	/** 直前のフレームからの転送量(バイト) */
+	public ulong BytesMovedDelta => delta(s => s.bytesMoved);
+
+	/** 直前のフレームからの、フレームバッファが不完全でコピーを行えなかった回数 */
+	public ulong FboValidationFailureDelta => delta(s => s.fboValidationFailureCount);
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	ulong delta(Func<PluginStats, ulong> getter) {
+		if (Current == null) return 0;
+		var cur = getter(Current.Value);
+		if (Previous == null) return cur;
+		var prev = getter(Previous.Value);
+		return prev <= cur ? cur - prev : cur;
+	}
+}
+
+}
@@ -0,0 +1,21 @@
+
+
+namespace CubemapOnTheFly {
+
+	/**
+	 * キューブマップを2Dに展開する際の投影法。
+	 * Native側のProjectionTypeと値を合わせること
+	 */
+	public enum Projection {
+
+		/** 正距円筒図法(緯度経度)。UIや360度画像の出力向け */
+		Equirect = 0,
+
+		/** 八面体マッピング。アトラスへの格納向け */
+		Octahedral = 1,
+
+		/** 双放物面マッピング。左半分が+Z側、右半分が-Z側。低スペック向けシェーダ用 */
+		DualParaboloid = 2,
+	}
+
+}
@@ -0,0 +1,96 @@
+using System;
+using UnityEngine;
+
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * キューブマップと各種投影法の2Dテクスチャを相互変換するモジュール。
+ * 変換はNativeプラグインで1パスで行う。
+ *
+ * GPU版はテクスチャ同士を直接変換する。出力先のサイズは任意。
+ * CPU版はホスト側のピクセル配列(RGBA8)同士を変換する。キューブマップは6面分を面の順に連続で並べたもの。
+ */
+public static class ProjectionConverter {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/**
+	 * キューブマップを指定の投影法の2Dテクスチャへ変換する。
+	 * 出力先はARGB32のRenderTexture。未対応の環境の場合はfalseを返す
+	 */
+	public static bool convert(Texture cubemap, RenderTexture dst, Projection projection) {
+		if (cubemap == null || dst == null) throw new ArgumentNullException();
+		if (cubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube)
+			throw new ArgumentException("cubemap is not cube texture");
+
+		if (!dst.IsCreated()) dst.Create();
+		return Plugin.CubemapBuilderPlugin.convertCubemapToProjection(
+			cubemap.GetNativeTexturePtr(),
+			dst.GetNativeTexturePtr(),
+			dst.width, dst.height,
+			(int)projection
+		);
+	}
+
+	/**
+	 * 指定の投影法の2Dテクスチャをキューブマップへ変換する。
+	 * 出力先はARGB32のキューブマップ(CubemapまたはCube次元のRenderTexture)。未対応の環境の場合はfalseを返す
+	 */
+	public static bool convertToCubemap(Texture src, Texture dstCubemap, Projection projection) {
+		if (src == null || dstCubemap == null) throw new ArgumentNullException();
+		if (dstCubemap.dimension != UnityEngine.Rendering.TextureDimension.Cube)
+			throw new ArgumentException("dstCubemap is not cube texture");
+
+		var dstRT = dstCubemap as RenderTexture;
+		if (dstRT != null && !dstRT.IsCreated()) dstRT.Create();
+		return Plugin.CubemapBuilderPlugin.convertProjectionToCubemap(
+			src.GetNativeTexturePtr(),
+			dstCubemap.GetNativeTexturePtr(),
+			dstCubemap.width,
+			(int)projection
+		);
+	}
+
+	/** ホスト側のキューブマップのピクセル配列を、指定の投影法の2D画像へ変換する */
+	public static unsafe void convert(
+		NativeArray<Color32> srcFaces, int srcSize,
+		NativeArray<Color32> dst, int dstWidth, int dstHeight,
+		Projection projection
+	) {
+		if (srcFaces.Length < srcSize*srcSize*6) throw new ArgumentException("srcFaces is too short");
+		if (dst.Length < dstWidth*dstHeight) throw new ArgumentException("dst is too short");
+
+		var isSucceeded = Plugin.CubemapBuilderPlugin.convertCubemapToProjectionCPU(
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(srcFaces), srcSize,
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafePtr(dst), dstWidth, dstHeight,
+			(int)projection
+		);
+		if (!isSucceeded) throw new ArgumentException();
+	}
+
+	/** ホスト側の指定投影法の2D画像を、キューブマップのピクセル配列へ変換する */
+	public static unsafe void convertToCubemap(
+		NativeArray<Color32> src, int srcWidth, int srcHeight,
+		NativeArray<Color32> dstFaces, int dstSize,
+		Projection projection
+	) {
+		if (src.Length < srcWidth*srcHeight) throw new ArgumentException("src is too short");
+		if (dstFaces.Length < dstSize*dstSize*6) throw new ArgumentException("dstFaces is too short");
+
+		var isSucceeded = Plugin.CubemapBuilderPlugin.convertProjectionToCubemapCPU(
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(src), srcWidth, srcHeight,
+			(IntPtr)NativeArrayUnsafeUtility.GetUnsafePtr(dstFaces), dstSize,
+			(int)projection
+		);
+		if (!isSucceeded) throw new ArgumentException();
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+	// --------------------------------------------------------------------------------------------
+}
+
+}
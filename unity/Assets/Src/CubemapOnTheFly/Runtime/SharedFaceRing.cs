@@ -0,0 +1,135 @@
+using System;
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+using UnityEngine;
+using UnityEngine.Rendering;
+using UnityEngine.Experimental.Rendering;
+
+
+namespace CubemapOnTheFly {
+
+/**
+ * 完成したキューブマップの面を、名前付きのPOSIX共有メモリ上のリングバッファで同じマシンの他プロセスへ公開する。
+ * 読み込み側はリングをマップして、コピーせずに各面を参照できる。
+ * レイアウトと読み込み手順は .PluginSource/source/SharedFaceRing.h を、
+ * 読み込み側の例は .PluginSource/tools/SharedFaceRingConsumer.cpp を参照。
+ *
+ * 現在はLinux・macOSのみ対応。
+ */
+public sealed class SharedFaceRing : IDisposable {
+	// ------------------------------------- public メンバ ----------------------------------------
+
+	/** 共有メモリの名前 */
+	public string Name {get; private set;}
+	/** 格納できる面の一辺の最大ピクセル数 */
+	public int MaxFaceSize {get; private set;}
+	/** 公開するピクセル形式 */
+	public GraphicsFormat Format {get; private set;}
+	/** 公開したキューブマップの数 */
+	public long PublishedCount {get; private set;}
+	/** 読み戻しの失敗などで公開できなかったキューブマップの数 */
+	public long FailedCount {get; private set;}
+
+	/**
+	 * リングを作成する。slotCountは保持する面の数で、読み込み側の遅れを許容する分だけ6の倍数で確保すること。
+	 * 未対応の環境や作成に失敗した場合はnull
+	 */
+	public static SharedFaceRing create(string name, int maxFaceSize, GraphicsFormat format, int slotCount = 6 * 3) {
+		if (string.IsNullOrEmpty(name)) throw new ArgumentException("name is empty");
+		var pixelFormat = Plugin.PixelFormatUtil.fromGraphicsFormat(format);
+		if (pixelFormat == Plugin.PixelFormat.Unsupported) throw new ArgumentException("unsupported format");
+
+		var ring = Plugin.CubemapBuilderPlugin.createSharedFaceRing(name, slotCount, maxFaceSize, pixelFormat);
+		if (ring == IntPtr.Zero) return null;
+		return new SharedFaceRing(ring, name, maxFaceSize, format, pixelFormat);
+	}
+
+	/**
+	 * ホスト側バッファ上のキューブマップ(6面連続)を公開する。
+	 * frameIdは読み込み側で同じキューブマップの面を識別するための値
+	 */
+	public unsafe bool publish(NativeArray<byte> faces, int size, long frameId) {
+		if (_ring == IntPtr.Zero) throw new ObjectDisposedException("SharedFaceRing");
+		if (faces.Length < size * size * _pixelFormat.bytesPerPixel() * 6) throw new ArgumentException("faces is too small");
+
+		var ret = Plugin.CubemapBuilderPlugin.publishCubemapFacesToSharedRing(
+			_ring, (IntPtr)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(faces),
+			size, _pixelFormat, (ulong)frameId
+		);
+		if (ret) ++PublishedCount; else ++FailedCount;
+		return ret;
+	}
+
+	/**
+	 * キューブマップの指定ミップレベルをGPUから非同期に読み戻して公開する。
+	 * 読み戻しはこの呼び出し時点の内容で行われるので、呼び出し後にcubemapを書き換えても問題ない。
+	 * 読み戻しを開始できなかった場合はfalseを返す
+	 */
+	public bool publishAsync(Texture cubemap, long frameId, int mipLevel = 0) {
+		if (_ring == IntPtr.Zero) throw new ObjectDisposedException("SharedFaceRing");
+		if (cubemap == null) throw new ArgumentNullException("cubemap");
+		if (cubemap.dimension != TextureDimension.Cube) throw new ArgumentException("texture is not cube texture");
+
+		var size = Mathf.Max(1, cubemap.width >> mipLevel);
+		if (MaxFaceSize < size || !SystemInfo.supportsAsyncGPUReadback) return false;
+
+		AsyncGPUReadback.Request(
+			cubemap, mipLevel, 0, size, 0, size, 0, 6,
+			_pixelFormat.toTextureFormat(),
+			req => onReadback(req, size, frameId)
+		);
+		return true;
+	}
+
+	/** リングを破棄して共有メモリを削除する。既に接続している読み込み側は、マップを解除するまで参照を続けられる */
+	public void Dispose() {
+		if (_ring == IntPtr.Zero) return;
+
+		Plugin.CubemapBuilderPlugin.destroySharedFaceRing(_ring);
+		_ring = IntPtr.Zero;
+		if (_faces.IsCreated) _faces.Dispose();
+		GC.SuppressFinalize(this);
+	}
+
+
+	// --------------------------------- private / protected メンバ -------------------------------
+
+	IntPtr _ring;
+	readonly Plugin.PixelFormat _pixelFormat;
+	NativeArray<byte> _faces;		//!< 読み戻した各面を隙間なく並べ直すバッファ
+
+	SharedFaceRing(IntPtr ring, string name, int maxFaceSize, GraphicsFormat format, Plugin.PixelFormat pixelFormat) {
+		_ring = ring;
+		_pixelFormat = pixelFormat;
+		Name = name;
+		MaxFaceSize = maxFaceSize;
+		Format = format;
+	}
+
+	~SharedFaceRing() {
+		if (_ring != IntPtr.Zero) Plugin.CubemapBuilderPlugin.destroySharedFaceRing(_ring);
+	}
+
+	void onReadback(AsyncGPUReadbackRequest req, int size, long frameId) {
+		if (_ring == IntPtr.Zero) return;
+		if (req.hasError) {
+			++FailedCount;
+			return;
+		}
+
+		var faceBytes = size * size * _pixelFormat.bytesPerPixel();
+		if (!_faces.IsCreated || _faces.Length < faceBytes * 6) {
+			if (_faces.IsCreated) _faces.Dispose();
+			_faces = new NativeArray<byte>(faceBytes * 6, Allocator.Persistent, NativeArrayOptions.UninitializedMemory);
+		}
+		for (int i=0; i<6; ++i)
+			NativeArray<byte>.Copy( req.GetData<byte>(i), 0, _faces, faceBytes * i, faceBytes );
+
+		publish(_faces, size, frameId);
+	}
+
+
+	// --------------------------------------------------------------------------------------------
+}
+
+}